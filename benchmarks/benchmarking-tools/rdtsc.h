@@ -1,48 +0,0 @@
-/*
- * Copyright (c) 2015-2020 Morwenn
- * SPDX-License-Identifier: MIT
- */
-
-/*
-    pdqsort.h - Pattern-defeating quicksort.
-
-    Copyright (c) 2015 Orson Peters
-
-    This software is provided 'as-is', without any express or implied warranty. In no event will the
-    authors be held liable for any damages arising from the use of this software.
-
-    Permission is granted to anyone to use this software for any purpose, including commercial
-    applications, and to alter it and redistribute it freely, subject to the following restrictions:
-
-    1. The origin of this software must not be misrepresented; you must not claim that you wrote the
-       original software. If you use this software in a product, an acknowledgment in the product
-       documentation would be appreciated but is not required.
-
-    2. Altered source versions must be plainly marked as such, and must not be misrepresented as
-       being the original software.
-
-    3. This notice may not be removed or altered from any source distribution.
-*/
-
-#ifdef _WIN32
-    #include <intrin.h>
-    inline unsigned long long rdtsc() {
-        return __rdtsc();
-    }
-#else
-    #ifdef __i586__
-        static __inline__ unsigned long long rdtsc() {
-            unsigned long long int x;
-            __asm__ volatile(".byte 0x0f, 0x31" : "=A" (x));
-            return x;
-        }
-    #elif defined(__x86_64__)
-        static __inline__ unsigned long long rdtsc(){
-            unsigned hi, lo;
-            __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
-            return ((unsigned long long) lo) | (((unsigned long long) hi) << 32);
-        }
-    #else
-        #error no rdtsc implementation
-    #endif
-#endif
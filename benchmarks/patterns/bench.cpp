@@ -35,8 +35,8 @@
 #include <type_traits>
 #include <utility>
 #include <vector>
+#include <cpp-sort/metrics/cpu_cycles.h>
 #include <cpp-sort/sorters.h>
-#include "../benchmarking-tools/cpu_cycles.h"
 #include "../benchmarking-tools/distributions.h"
 
 // Type of data to sort during the benchmark
@@ -101,7 +101,7 @@ int main()
                 while (total_end - total_start < 5s) {
                     collection_t collection;
                     distribution.second(std::back_inserter(collection), size);
-                    auto do_sort = cpu_cycles<sort_f>(sort.second);
+                    auto do_sort = cppsort::metrics::cpu_cycles<sort_f>(sort.second);
                     auto nb_cycles = do_sort(collection);
                     assert(std::is_sorted(std::begin(collection), std::end(collection)));
                     cycles_per_element.push_back(double(nb_cycles.value()) / size + 0.5);
@@ -15,9 +15,9 @@
 #include <utility>
 #include <vector>
 #include <cpp-sort/adapters.h>
+#include <cpp-sort/metrics/cpu_cycles.h>
 #include <cpp-sort/probes.h>
 #include <cpp-sort/sorters.h>
-#include "../benchmarking-tools/cpu_cycles.h"
 #include "../benchmarking-tools/distributions.h"
 #include "../benchmarking-tools/filesystem.h"
 
@@ -101,7 +101,7 @@ int main(int argc, char* argv[])
             while (total_end - total_start < max_run_time && cycles.size() < max_runs_per_size) {
                 collection_t collection;
                 distribution(std::back_inserter(collection), size);
-                auto do_sort = cpu_cycles<sort_f>(sort.second);
+                auto do_sort = cppsort::metrics::cpu_cycles<sort_f>(sort.second);
                 auto nb_cycles = do_sort(collection);
                 assert(std::is_sorted(std::begin(collection), std::end(collection)));
                 cycles.push_back(double(nb_cycles.value()) / size + 0.5);
@@ -16,8 +16,8 @@
 #include <vector>
 #include <cpp-sort/adapters.h>
 #include <cpp-sort/fixed_sorters.h>
+#include <cpp-sort/metrics/cpu_cycles.h>
 #include <cpp-sort/sorters.h>
-#include "../benchmarking-tools/cpu_cycles.h"
 #include "../benchmarking-tools/distributions.h"
 
 using namespace std::chrono_literals;
@@ -63,7 +63,7 @@ auto time_it(Sorter sorter, Dist distribution)
     while (total_end - total_start < max_run_time && cycles.size() < max_runs_per_size) {
         std::array<T, N> arr;
         distribution(arr.begin(), N);
-        auto do_sort = cpu_cycles<Sorter>(sorter);
+        auto do_sort = cppsort::metrics::cpu_cycles<Sorter>(sorter);
         auto nb_cycles = do_sort(arr);
         assert(std::is_sorted(arr.begin(), arr.end()));
         cycles.push_back(double(nb_cycles.value()) / N);
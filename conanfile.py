@@ -63,6 +63,9 @@ class CppSortConan(ConanFile):
         self.cpp_info.bindirs = []
         self.cpp_info.libdirs = []
 
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs = ["pthread"]
+
         if is_msvc(self):
             self.cpp_info.cxxflags = ["/permissive-", "/Zc:preprocessor"]
 
@@ -13,7 +13,9 @@
 #include <cpp-sort/adapters/drop_merge_adapter.h>
 #include <cpp-sort/adapters/hybrid_adapter.h>
 #include <cpp-sort/adapters/indirect_adapter.h>
+#include <cpp-sort/adapters/memory_resource_adapter.h>
 #include <cpp-sort/adapters/out_of_place_adapter.h>
+#include <cpp-sort/adapters/packed_schwartz_adapter.h>
 #include <cpp-sort/adapters/schwartz_adapter.h>
 #include <cpp-sort/adapters/self_sort_adapter.h>
 #include <cpp-sort/adapters/small_array_adapter.h>
@@ -8,17 +8,17 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/adapter_storage.h>
 #include <cpp-sort/utility/functional.h>
-#include <cpp-sort/utility/iter_move.h>
 #include <cpp-sort/utility/size.h>
+#include "../detail/apply_permutation.h"
 #include "../detail/checkers.h"
 #include "../detail/immovable_vector.h"
 #include "../detail/indiesort.h"
@@ -68,8 +68,6 @@ namespace cppsort
             >
 #endif
         {
-            using utility::iter_move;
-
             ////////////////////////////////////////////////////////////
             // Indirectly sort the iterators
 
@@ -92,37 +90,9 @@ namespace cppsort
                 ////////////////////////////////////////////////////////////
                 // Move the values according the iterator's positions
 
-                std::vector<bool> sorted(last - first, false);
-
-                // Element where the current cycle starts
-                auto start = first;
-
-                while (start != last) {
-                    // Find the element to put in current's place
-                    auto current = start;
-                    auto next_pos = current - first;
-                    auto next = iterators[next_pos];
-                    sorted[next_pos] = true;
-
-                    // Process the current cycle
-                    if (next != current) {
-                        auto tmp = iter_move(current);
-                        while (next != start) {
-                            *current = iter_move(next);
-                            current = next;
-                            auto next_pos = next - first;
-                            next = iterators[next_pos];
-                            sorted[next_pos] = true;
-                        }
-                        *current = std::move(tmp);
-                    }
-
-                    // Find the next cycle
-                    do {
-                        ++start;
-                    } while (start != last && sorted[start - first]);
-
-                }
+                permute(first, static_cast<std::size_t>(size), [&](std::size_t pos) {
+                    return static_cast<std::size_t>(iterators[static_cast<std::ptrdiff_t>(pos)] - first);
+                });
 #ifdef __cpp_lib_uncaught_exceptions
             });
 
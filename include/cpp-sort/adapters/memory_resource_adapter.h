@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_ADAPTERS_MEMORY_RESOURCE_ADAPTER_H_
+#define CPPSORT_ADAPTERS_MEMORY_RESOURCE_ADAPTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../detail/config.h"
+
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#include <memory_resource>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/scoped_memory_resource.h>
+#include "../detail/checkers.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Adapter
+
+    namespace detail
+    {
+        template<typename Sorter>
+        struct memory_resource_adapter_impl:
+            utility::adapter_storage<Sorter>,
+            check_iterator_category<Sorter>,
+            check_is_always_stable<Sorter>
+        {
+            memory_resource_adapter_impl() = default;
+
+            constexpr explicit memory_resource_adapter_impl(Sorter&& sorter,
+                                                            std::pmr::memory_resource* resource):
+                utility::adapter_storage<Sorter>(std::move(sorter)),
+                resource(resource)
+            {}
+
+            template<typename... Args>
+            auto operator()(Args&&... args) const
+                -> decltype(this->get()(std::forward<Args>(args)...))
+            {
+                utility::scoped_memory_resource scope(resource);
+                return this->get()(std::forward<Args>(args)...);
+            }
+
+            auto memory_resource() const noexcept
+                -> std::pmr::memory_resource*
+            {
+                return resource;
+            }
+
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource();
+        };
+    }
+
+    template<typename Sorter>
+    struct memory_resource_adapter:
+        sorter_facade<detail::memory_resource_adapter_impl<Sorter>>
+    {
+        memory_resource_adapter() = default;
+
+        explicit memory_resource_adapter(std::pmr::memory_resource* resource):
+            memory_resource_adapter(Sorter{}, resource)
+        {}
+
+        explicit memory_resource_adapter(Sorter sorter):
+            memory_resource_adapter(std::move(sorter), std::pmr::get_default_resource())
+        {}
+
+        memory_resource_adapter(Sorter sorter, std::pmr::memory_resource* resource):
+            sorter_facade<detail::memory_resource_adapter_impl<Sorter>>(std::move(sorter), resource)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<memory_resource_adapter<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#endif // CPPSORT_ADAPTERS_MEMORY_RESOURCE_ADAPTER_H_
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_ADAPTERS_PACKED_SCHWARTZ_ADAPTER_H_
+#define CPPSORT_ADAPTERS_PACKED_SCHWARTZ_ADAPTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/adapters/schwartz_adapter.h>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/apply_permutation.h"
+#include "../detail/checkers.h"
+#include "../detail/config.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
+#include "../detail/scope_exit.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Projected key packed with the position of its element
+
+        // The key is named data so that data_getter can be reused
+        template<typename Key, typename Index>
+        struct packed_key
+        {
+            Key data;
+            Index index;
+        };
+
+        template<typename RandomAccessIterator, typename Key, typename Index>
+        auto apply_packed_permutation(RandomAccessIterator first,
+                                      const scratch_vector<packed_key<Key, Index>>& keys)
+            -> void
+        {
+            permute(first, keys.size(), [&keys](std::size_t pos) {
+                return static_cast<std::size_t>(keys[pos].index);
+            });
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Algorithm proper
+
+        template<
+            typename Index,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection,
+            typename Sorter
+        >
+        auto sort_with_packed_keys(RandomAccessIterator first,
+                                   difference_type_t<RandomAccessIterator> size,
+                                   Compare compare, Projection projection, Sorter&& sorter)
+            -> decltype(auto)
+        {
+            auto&& proj = utility::as_function(projection);
+            using key_t = packed_key<projected_t<RandomAccessIterator, Projection>, Index>;
+
+            // Only the keys and their indices are moved around during
+            // the sort, the original elements are moved once at the end
+            scratch_vector<key_t> keys;
+            keys.reserve(static_cast<std::size_t>(size));
+            auto it = first;
+            for (Index idx = 0 ; idx < static_cast<Index>(size) ; ++idx) {
+                keys.push_back(key_t{ proj(*it), idx });
+                ++it;
+            }
+
+#ifndef __cpp_lib_uncaught_exceptions
+            std::forward<Sorter>(sorter)(keys.begin(), keys.end(),
+                                         std::move(compare), data_getter{});
+            apply_packed_permutation(first, keys);
+#else
+            // Work around the sorters that return void
+            auto exit_function = make_scope_success([&] {
+                apply_packed_permutation(first, keys);
+            });
+            return std::forward<Sorter>(sorter)(keys.begin(), keys.end(),
+                                                std::move(compare), data_getter{});
+#endif
+        }
+
+        // A 32-bit index only makes a key smaller when the alignment
+        // of the key is small enough: packed_key<double, std::uint32_t>
+        // is padded to the size of packed_key<double, std::uint64_t>
+        template<typename Key>
+        struct shrinks_with_small_index:
+            std::integral_constant<
+                bool,
+                (sizeof(packed_key<Key, std::uint32_t>) < sizeof(packed_key<Key, std::uint64_t>))
+            >
+        {};
+
+        template<
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection,
+            typename Sorter
+        >
+        auto sort_with_packed_schwartz(RandomAccessIterator first, RandomAccessIterator last,
+                                       Compare compare, Projection projection, Sorter&& sorter,
+                                       std::false_type /* shrinks_with_small_index */)
+            -> decltype(auto)
+        {
+            return sort_with_packed_keys<std::uint64_t>(first, last - first,
+                                                        std::move(compare), std::move(projection),
+                                                        std::forward<Sorter>(sorter));
+        }
+
+        template<
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection,
+            typename Sorter
+        >
+        auto sort_with_packed_schwartz(RandomAccessIterator first, RandomAccessIterator last,
+                                       Compare compare, Projection projection, Sorter&& sorter,
+                                       std::true_type /* shrinks_with_small_index */)
+            -> decltype(auto)
+        {
+            auto size = last - first;
+            if (static_cast<std::uint64_t>(size) <= (std::numeric_limits<std::uint32_t>::max)()) {
+                return sort_with_packed_keys<std::uint32_t>(first, size,
+                                                            std::move(compare), std::move(projection),
+                                                            std::forward<Sorter>(sorter));
+            }
+            return sort_with_packed_keys<std::uint64_t>(first, size,
+                                                        std::move(compare), std::move(projection),
+                                                        std::forward<Sorter>(sorter));
+        }
+
+        template<
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection,
+            typename Sorter
+        >
+        auto sort_with_packed_schwartz(RandomAccessIterator first, RandomAccessIterator last,
+                                       Compare compare, Projection projection, Sorter&& sorter)
+            -> decltype(auto)
+        {
+            using key_t = projected_t<RandomAccessIterator, Projection>;
+            return sort_with_packed_schwartz(first, last,
+                                             std::move(compare), std::move(projection),
+                                             std::forward<Sorter>(sorter),
+                                             shrinks_with_small_index<key_t>{});
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Adapter
+
+        template<typename Sorter>
+        struct packed_schwartz_adapter_impl:
+            utility::adapter_storage<Sorter>,
+            check_is_always_stable<Sorter>
+        {
+            packed_schwartz_adapter_impl() = default;
+
+            constexpr explicit packed_schwartz_adapter_impl(Sorter&& sorter):
+                utility::adapter_storage<Sorter>(std::move(sorter))
+            {}
+
+            template<
+                typename RandomAccessIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_v<Projection, RandomAccessIterable, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterable&& iterable, Compare compare, Projection projection) const
+                -> decltype(auto)
+            {
+                return sort_with_packed_schwartz(std::begin(iterable), std::end(iterable),
+                                                 std::move(compare), std::move(projection),
+                                                 this->get());
+            }
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, Projection projection) const
+                -> decltype(auto)
+            {
+                return sort_with_packed_schwartz(first, last,
+                                                 std::move(compare), std::move(projection),
+                                                 this->get());
+            }
+
+            template<typename RandomAccessIterable, typename Compare=std::less<>>
+            auto operator()(RandomAccessIterable&& iterable, Compare compare={}) const
+                -> detail::enable_if_t<
+                    not is_projection_v<Compare, RandomAccessIterable>,
+                    decltype(this->get()(std::forward<RandomAccessIterable>(iterable), std::move(compare)))
+                >
+            {
+                // No projection to handle, forward everything to the adapted sorter
+                return this->get()(std::forward<RandomAccessIterable>(iterable), std::move(compare));
+            }
+
+            template<typename RandomAccessIterator, typename Compare=std::less<>>
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}) const
+                -> detail::enable_if_t<
+                    not is_projection_iterator_v<Compare, RandomAccessIterator>,
+                    decltype(this->get()(std::move(first), std::move(last), std::move(compare)))
+                >
+            {
+                // No projection to handle, forward everything to the adapted sorter
+                return this->get()(std::move(first), std::move(last), std::move(compare));
+            }
+
+            template<typename RandomAccessIterable, typename Compare>
+            auto operator()(RandomAccessIterable&& iterable, Compare compare, utility::identity projection) const
+                -> decltype(this->get()(std::forward<RandomAccessIterable>(iterable), std::move(compare), projection))
+            {
+                // utility::identity does nothing, bypass packed_schwartz_adapter entirely
+                return this->get()(std::forward<RandomAccessIterable>(iterable), std::move(compare), projection);
+            }
+
+            template<typename RandomAccessIterator, typename Compare>
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, utility::identity projection) const
+                -> decltype(this->get()(std::move(first), std::move(last), std::move(compare), projection))
+            {
+                // utility::identity does nothing, bypass packed_schwartz_adapter entirely
+                return this->get()(std::move(first), std::move(last), std::move(compare), projection);
+            }
+
+#if CPPSORT_STD_IDENTITY_AVAILABLE
+            template<typename RandomAccessIterable, typename Compare>
+            auto operator()(RandomAccessIterable&& iterable, Compare compare, std::identity projection) const
+                -> decltype(this->get()(std::forward<RandomAccessIterable>(iterable), std::move(compare), projection))
+            {
+                // std::identity does nothing, bypass packed_schwartz_adapter entirely
+                return this->get()(std::forward<RandomAccessIterable>(iterable), std::move(compare), projection);
+            }
+
+            template<typename RandomAccessIterator, typename Compare>
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare, std::identity projection) const
+                -> decltype(this->get()(std::move(first), std::move(last), std::move(compare), projection))
+            {
+                // std::identity does nothing, bypass packed_schwartz_adapter entirely
+                return this->get()(std::move(first), std::move(last), std::move(compare), projection);
+            }
+#endif
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+        };
+    }
+
+    template<typename Sorter>
+    struct packed_schwartz_adapter:
+        sorter_facade<detail::packed_schwartz_adapter_impl<Sorter>>
+    {
+        packed_schwartz_adapter() = default;
+
+        constexpr explicit packed_schwartz_adapter(Sorter sorter):
+            sorter_facade<detail::packed_schwartz_adapter_impl<Sorter>>(std::move(sorter))
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<packed_schwartz_adapter<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_ADAPTERS_PACKED_SCHWARTZ_ADAPTER_H_
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_ALGORITHM_EVENTS_H_
+#define CPPSORT_DETAIL_ALGORITHM_EVENTS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // When CPPSORT_ENABLE_ALGORITHM_EVENTS is defined, some
+    // algorithms report the decisions they make at runtime to
+    // the events installed for the current thread, which is
+    // what metrics::algorithm_events reports
+
+    struct algorithm_events
+    {
+        // pdqsort
+        std::uint64_t partitions = 0;
+        std::uint64_t unbalanced_partitions = 0;
+        std::uint64_t heapsort_fallbacks = 0;
+        // timsort
+        std::uint64_t runs = 0;
+        std::uint64_t gallop_enters = 0;
+        std::uint64_t gallop_exits = 0;
+        // temporary_buffer::try_grow
+        std::uint64_t buffer_growths = 0;
+        std::uint64_t buffer_partial_growths = 0;
+        std::uint64_t buffer_growth_failures = 0;
+    };
+
+    inline auto current_algorithm_events() noexcept
+        -> algorithm_events*&
+    {
+        static thread_local algorithm_events* events = nullptr;
+        return events;
+    }
+
+    inline auto record_algorithm_event(std::uint64_t algorithm_events::* event) noexcept
+        -> void
+    {
+        auto events = current_algorithm_events();
+        if (events != nullptr) {
+            ++(events->*event);
+        }
+    }
+
+    // Installs events for the current thread for as long as
+    // it lives, then adds them to the previous ones if any
+    class scoped_algorithm_events
+    {
+        public:
+
+            explicit scoped_algorithm_events(algorithm_events& events) noexcept:
+                previous_(current_algorithm_events()),
+                events_(&events)
+            {
+                current_algorithm_events() = events_;
+            }
+
+            scoped_algorithm_events(const scoped_algorithm_events&) = delete;
+            scoped_algorithm_events& operator=(const scoped_algorithm_events&) = delete;
+
+            ~scoped_algorithm_events()
+            {
+                current_algorithm_events() = previous_;
+                if (previous_ != nullptr) {
+                    previous_->partitions += events_->partitions;
+                    previous_->unbalanced_partitions += events_->unbalanced_partitions;
+                    previous_->heapsort_fallbacks += events_->heapsort_fallbacks;
+                    previous_->runs += events_->runs;
+                    previous_->gallop_enters += events_->gallop_enters;
+                    previous_->gallop_exits += events_->gallop_exits;
+                    previous_->buffer_growths += events_->buffer_growths;
+                    previous_->buffer_partial_growths += events_->buffer_partial_growths;
+                    previous_->buffer_growth_failures += events_->buffer_growth_failures;
+                }
+            }
+
+        private:
+
+            algorithm_events* previous_;
+            algorithm_events* events_;
+    };
+}}
+
+////////////////////////////////////////////////////////////
+// CPPSORT_ALGORITHM_EVENT
+
+// Algorithm events are compiled out unless explicitly enabled,
+// in which case recording one costs a thread-local read and a
+// branch even when no metric is listening
+
+#if defined(CPPSORT_ENABLE_ALGORITHM_EVENTS)
+#   define CPPSORT_ALGORITHM_EVENT(event) \
+        ::cppsort::detail::record_algorithm_event(&::cppsort::detail::algorithm_events::event)
+#else
+#   define CPPSORT_ALGORITHM_EVENT(event) ((void)0)
+#endif
+
+#endif // CPPSORT_DETAIL_ALGORITHM_EVENTS_H_
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_APPLY_PERMUTATION_H_
+#define CPPSORT_DETAIL_APPLY_PERMUTATION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "move.h"
+#include "scope_exit.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Dense bitmap of the positions already processed
+
+    class position_bitmap
+    {
+        public:
+
+            explicit position_bitmap(std::size_t size):
+                words((size + word_size - 1) / word_size, 0),
+                size(size)
+            {}
+
+            auto set(std::size_t pos) noexcept
+                -> void
+            {
+                words[pos / word_size] |= word_type(1) << (pos % word_size);
+            }
+
+            // Returns the first position not set starting at pos, or
+            // the size of the bitmap if there is none; full words are
+            // skipped at once
+            auto next_unset(std::size_t pos) const noexcept
+                -> std::size_t
+            {
+                auto idx = pos / word_size;
+                if (idx >= words.size()) {
+                    return size;
+                }
+                // Consider the positions before pos as set
+                auto word = words[idx] | ((word_type(1) << (pos % word_size)) - 1);
+                while (word == ~word_type(0)) {
+                    if (++idx == words.size()) {
+                        return size;
+                    }
+                    word = words[idx];
+                }
+                auto res = idx * word_size + static_cast<std::size_t>(detail::countr_zero(~word));
+                return res < size ? res : size;
+            }
+
+        private:
+
+            using word_type = std::uint64_t;
+            static constexpr std::size_t word_size = 64;
+
+            scratch_vector<word_type> words;
+            std::size_t size;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Permutation engine
+    //
+    // The permutation is given as a function source such that
+    // source(pos) is the position of the element that has to be
+    // moved to pos. Following the cycles of the permutation moves
+    // every element once (plus one move per cycle) but almost
+    // every move is a cache miss when the collection is big since
+    // the next position to read depends on the previous one; when
+    // a buffer is available, gathering the elements into it in
+    // order makes the reads independent from each other, which is
+    // much faster for big collections of small elements despite
+    // moving every element twice
+
+    template<typename RandomAccessIterator, typename Source>
+    auto permute_cycles(RandomAccessIterator first, std::size_t size, Source source)
+        -> void
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        auto at = [first](std::size_t pos) {
+            return first + static_cast<difference_type>(pos);
+        };
+
+        position_bitmap done(size);
+        for (auto start = done.next_unset(0) ; start != size ; start = done.next_unset(start + 1)) {
+            done.set(start);
+            auto next = source(start);
+            if (next == start) {
+                continue;
+            }
+
+            auto current = start;
+            auto tmp = iter_move(at(current));
+            do {
+                *at(current) = iter_move(at(next));
+                current = next;
+                done.set(current);
+                next = source(current);
+            } while (next != start);
+            *at(current) = std::move(tmp);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Source>
+    auto permute_gather(RandomAccessIterator first, std::size_t size, Source source,
+                        rvalue_type_t<RandomAccessIterator>* buffer)
+        -> void
+    {
+        using utility::iter_move;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        destruct_n<rvalue_type> d(0);
+        std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer, d);
+        for (std::size_t pos = 0 ; pos < size ; ++pos) {
+            auto it = first + static_cast<difference_type>(source(pos));
+            ::new(static_cast<void*>(buffer + pos)) rvalue_type(iter_move(it));
+            ++d;
+        }
+        detail::move(buffer, buffer + size, first);
+    }
+
+    // The gather only pays off when the collection doesn't fit
+    // in cache, and the cost of the second pass grows with the
+    // size of the elements
+    template<typename T>
+    constexpr auto gather_pays_off(std::size_t size) noexcept
+        -> bool
+    {
+        return sizeof(T) <= 64
+            && size >= (sizeof(T) <= 16 ? std::size_t(1) << 14 : std::size_t(1) << 18);
+    }
+
+    template<typename RandomAccessIterator, typename Source>
+    auto permute(RandomAccessIterator first, std::size_t size, Source source)
+        -> void
+    {
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        if (gather_pays_off<rvalue_type>(size)) {
+            temporary_buffer<rvalue_type> buffer(static_cast<std::ptrdiff_t>(size));
+            if (static_cast<std::size_t>(buffer.size()) >= size) {
+                permute_gather(first, size, std::move(source), buffer.data());
+                return;
+            }
+        }
+        permute_cycles(first, size, std::move(source));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Several collections permuted at once
+    //
+    // When several collections have to be permuted the same way,
+    // the cycles of the permutation are only followed once: they
+    // are recorded, then replayed for every collection, reading
+    // the positions sequentially instead of chasing them through
+    // the source function and the bitmap again
+
+    struct permutation_cycles
+    {
+        // Positions of the cycles longer than 1, one after the other
+        scratch_vector<std::size_t> positions;
+        // Lengths of the cycles in the same order
+        scratch_vector<std::size_t> lengths;
+    };
+
+    template<typename Source>
+    auto record_cycles(std::size_t size, Source source)
+        -> permutation_cycles
+    {
+        permutation_cycles res;
+        position_bitmap done(size);
+        for (auto start = done.next_unset(0) ; start != size ; start = done.next_unset(start + 1)) {
+            done.set(start);
+            auto next = source(start);
+            if (next == start) {
+                continue;
+            }
+
+            std::size_t length = 1;
+            res.positions.push_back(start);
+            for (auto current = next ; current != start ; current = source(current)) {
+                done.set(current);
+                res.positions.push_back(current);
+                ++length;
+            }
+            res.lengths.push_back(length);
+        }
+        return res;
+    }
+
+    template<typename RandomAccessIterator>
+    auto replay_cycles(RandomAccessIterator first, const permutation_cycles& cycles)
+        -> void
+    {
+        using utility::iter_move;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+        auto at = [first](std::size_t pos) {
+            return first + static_cast<difference_type>(pos);
+        };
+
+        const std::size_t* positions = cycles.positions.data();
+        for (auto length: cycles.lengths) {
+            auto tmp = iter_move(at(positions[0]));
+            for (std::size_t idx = 1 ; idx < length ; ++idx) {
+                *at(positions[idx - 1]) = iter_move(at(positions[idx]));
+            }
+            *at(positions[length - 1]) = std::move(tmp);
+            positions += length;
+        }
+    }
+
+    template<typename Source, typename... RandomAccessIterators>
+    auto permute_columns(std::size_t size, Source source, RandomAccessIterators... firsts)
+        -> void
+    {
+        if (sizeof...(RandomAccessIterators) == 1) {
+            (void)std::initializer_list<int>{
+                (permute(firsts, size, source), 0)...
+            };
+            return;
+        }
+
+        // Only record the cycles if a collection needs them
+        permutation_cycles cycles;
+        bool recorded = false;
+        auto permute_column = [&](auto first) {
+            using rvalue_type = rvalue_type_t<decltype(first)>;
+            if (gather_pays_off<rvalue_type>(size)) {
+                temporary_buffer<rvalue_type> buffer(static_cast<std::ptrdiff_t>(size));
+                if (static_cast<std::size_t>(buffer.size()) >= size) {
+                    permute_gather(first, size, source, buffer.data());
+                    return;
+                }
+            }
+            if (not recorded) {
+                cycles = record_cycles(size, source);
+                recorded = true;
+            }
+            replay_cycles(first, cycles);
+        };
+        (void)std::initializer_list<int>{
+            (permute_column(firsts), 0)...
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Parallel permutation
+    //
+    // Every collection is permuted by its own task; the gathers
+    // are split into chunks handled by several workers, while the
+    // collections permuted by following cycles are handled by a
+    // single worker each, the cycles being recorded only once
+
+    // Minimal number of elements handled by a gather task
+    constexpr std::size_t parallel_gather_grain = std::size_t(1) << 14;
+
+    template<typename RandomAccessIterator, typename Source>
+    auto parallel_permute_gather(work_stealing_pool& pool, std::size_t worker,
+                                 RandomAccessIterator first, std::size_t size, Source source,
+                                 rvalue_type_t<RandomAccessIterator>* buffer)
+        -> void
+    {
+        using utility::iter_move;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        using difference_type = difference_type_t<RandomAccessIterator>;
+
+        auto chunk_size = size / pool.size();
+        if (chunk_size < parallel_gather_grain) {
+            chunk_size = parallel_gather_grain;
+        }
+        std::size_t chunks_count = (size + chunk_size - 1) / chunk_size;
+
+        // Every chunk counts the elements it constructed in the buffer
+        // so that they can be destroyed no matter what happens
+        scratch_vector<std::size_t> constructed(chunks_count, 0);
+        std::atomic<std::size_t> latch(0);
+        auto destroy_buffer = make_scope_exit([&] {
+            pool.wait(worker, latch);
+            for (std::size_t chunk = 0 ; chunk < chunks_count ; ++chunk) {
+                detail::destroy_n(buffer + chunk * chunk_size, constructed[chunk]);
+            }
+        });
+
+        for (std::size_t chunk = 0 ; chunk < chunks_count ; ++chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = (std::min)(begin + chunk_size, size);
+            auto count = constructed.data() + chunk;
+            pool.push(worker, [=](std::size_t) {
+                for (auto pos = begin ; pos < end ; ++pos) {
+                    auto it = first + static_cast<difference_type>(source(pos));
+                    ::new(static_cast<void*>(buffer + pos)) rvalue_type(iter_move(it));
+                    ++*count;
+                }
+            }, latch);
+        }
+        pool.wait(worker, latch);
+        if (pool.cancelled()) return;
+
+        for (std::size_t chunk = 0 ; chunk < chunks_count ; ++chunk) {
+            auto begin = chunk * chunk_size;
+            auto end = (std::min)(begin + chunk_size, size);
+            pool.push(worker, [=](std::size_t) {
+                detail::move(buffer + begin, buffer + end,
+                             first + static_cast<difference_type>(begin));
+            }, latch);
+        }
+    }
+
+    template<typename Source, typename... RandomAccessIterators>
+    auto parallel_permute_columns(std::size_t size, Source source, std::size_t max_threads,
+                                  RandomAccessIterators... firsts)
+        -> void
+    {
+        auto workers = parallel_workers_count(size * sizeof...(RandomAccessIterators),
+                                              parallel_gather_grain, max_threads);
+        if (workers < 2) {
+            permute_columns(size, std::move(source), firsts...);
+            return;
+        }
+
+        permutation_cycles cycles;
+        std::once_flag cycles_recorded;
+
+        work_stealing_pool pool(workers);
+        pool.run([&](std::size_t worker) {
+            std::atomic<std::size_t> latch(0);
+            auto permute_column = [&](auto first) {
+                pool.push(worker, [&, first](std::size_t column_worker) {
+                    using rvalue_type = rvalue_type_t<decltype(first)>;
+                    if (gather_pays_off<rvalue_type>(size)) {
+                        temporary_buffer<rvalue_type> buffer(static_cast<std::ptrdiff_t>(size));
+                        if (static_cast<std::size_t>(buffer.size()) >= size) {
+                            parallel_permute_gather(pool, column_worker, first, size,
+                                                    source, buffer.data());
+                            return;
+                        }
+                    }
+                    if (sizeof...(RandomAccessIterators) == 1) {
+                        permute_cycles(first, size, source);
+                        return;
+                    }
+                    std::call_once(cycles_recorded, [&] {
+                        cycles = record_cycles(size, source);
+                    });
+                    replay_cycles(first, cycles);
+                }, latch);
+            };
+            try {
+                (void)std::initializer_list<int>{
+                    (permute_column(firsts), 0)...
+                };
+            } catch (...) {
+                pool.wait(worker, latch);
+                throw;
+            }
+            pool.wait(worker, latch);
+        });
+    }
+}}
+
+#endif // CPPSORT_DETAIL_APPLY_PERMUTATION_H_
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_ARGUMENTS_RANGE_H_
+#define CPPSORT_DETAIL_ARGUMENTS_RANGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/size.h>
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Metrics forward whatever they are given to the adapted
+    // sorter, but sometimes need to know which collection is
+    // being sorted: the arguments either start with a pair of
+    // iterators, or with an iterable
+
+    template<typename T>
+    using iterator_category_of = typename std::iterator_traits<T>::iterator_category;
+
+    template<typename... Args>
+    struct starts_with_iterators:
+        std::false_type
+    {};
+
+    template<typename T, typename U, typename... Args>
+    struct starts_with_iterators<T, U, Args...>:
+        conjunction<
+            std::is_same<remove_cvref_t<T>, remove_cvref_t<U>>,
+            is_detected<iterator_category_of, remove_cvref_t<T>>
+        >
+    {};
+
+    template<typename Iterator, typename... Args>
+    auto arguments_range_impl(std::true_type, Iterator& first, Iterator& last, Args&...)
+        -> std::pair<remove_cvref_t<Iterator>, remove_cvref_t<Iterator>>
+    {
+        return { first, last };
+    }
+
+    template<typename Iterable, typename... Args>
+    auto arguments_range_impl(std::false_type, Iterable& iterable, Args&...)
+        -> std::pair<decltype(std::begin(iterable)), decltype(std::end(iterable))>
+    {
+        return { std::begin(iterable), std::end(iterable) };
+    }
+
+    template<typename... Args>
+    auto arguments_range(Args&... args)
+        -> decltype(arguments_range_impl(starts_with_iterators<Args...>{}, args...))
+    {
+        return arguments_range_impl(starts_with_iterators<Args...>{}, args...);
+    }
+
+    template<typename Iterator, typename... Args>
+    auto arguments_size_impl(std::true_type, Iterator& first, Iterator& last, Args&...)
+        -> decltype(std::distance(first, last))
+    {
+        return std::distance(first, last);
+    }
+
+    template<typename Iterable, typename... Args>
+    auto arguments_size_impl(std::false_type, Iterable& iterable, Args&...)
+        -> decltype(utility::size(iterable))
+    {
+        return utility::size(iterable);
+    }
+
+    template<typename... Args>
+    auto arguments_size(Args&... args)
+        -> decltype(arguments_size_impl(starts_with_iterators<Args...>{}, args...))
+    {
+        return arguments_size_impl(starts_with_iterators<Args...>{}, args...);
+    }
+}}
+
+#endif // CPPSORT_DETAIL_ARGUMENTS_RANGE_H_
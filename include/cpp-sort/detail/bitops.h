@@ -100,6 +100,40 @@ namespace detail
         return log;
     }
 
+    // Returns the number of trailing zero bits, assumes n > 0
+
+#if defined(__GNUC__) || defined(__clang__)
+    constexpr auto countr_zero(unsigned int n)
+        -> int
+    {
+        return __builtin_ctz(n);
+    }
+
+    constexpr auto countr_zero(unsigned long n)
+        -> int
+    {
+        return __builtin_ctzl(n);
+    }
+
+    constexpr auto countr_zero(unsigned long long n)
+        -> int
+    {
+        return __builtin_ctzll(n);
+    }
+#endif
+
+    template<typename Unsigned>
+    constexpr auto countr_zero(Unsigned n)
+        -> int
+    {
+        int res = 0;
+        while ((n & 1u) == 0) {
+            n >>= 1;
+            ++res;
+        }
+        return res;
+    }
+
     // Halves a positive number, using unsigned division if possible
 
     template<typename Integer>
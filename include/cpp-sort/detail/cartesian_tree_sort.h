@@ -11,7 +11,6 @@
 #include <cstddef>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/comparators/flip.h>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
@@ -19,6 +18,7 @@
 #include "heapsort.h"
 #include "immovable_vector.h"
 #include "iterator_traits.h"
+#include "memory.h"
 #include "type_traits.h"
 
 namespace cppsort
@@ -124,7 +124,7 @@ namespace detail
         }
 
         tree_type tree(first, last, size, compare, projection);
-        std::vector<binary_tree_node_base*> pq; // Priority queue
+        scratch_vector<binary_tree_node_base*> pq; // Priority queue
         pq.push_back(tree.root());
 
         auto&& comp = cppsort::flip(compare);
@@ -39,6 +39,15 @@
 #   define CPPSORT_INLINE_VARIABLE static
 #endif
 
+// Scratch memory can only be redirected to a user-provided
+// memory resource when <memory_resource> is available
+
+#if defined(__cpp_lib_memory_resource)
+#   define CPPSORT_MEMORY_RESOURCE_AVAILABLE 1
+#else
+#   define CPPSORT_MEMORY_RESOURCE_AVAILABLE 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // Check for C++20 features
 
@@ -58,6 +67,27 @@
 #   define CPPSORT_STD_IDENTITY_AVAILABLE 0
 #endif
 
+////////////////////////////////////////////////////////////
+// Check for platform features
+
+// Hardware performance counters are read with perf_event_open,
+// which only exists on Linux
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#   define CPPSORT_HARDWARE_COUNTERS_AVAILABLE 1
+#else
+#   define CPPSORT_HARDWARE_COUNTERS_AVAILABLE 0
+#endif
+
+// CPU cycles are read from the time-stamp counter of x86
+// processors
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#   define CPPSORT_TIME_STAMP_COUNTER_AVAILABLE 1
+#else
+#   define CPPSORT_TIME_STAMP_COUNTER_AVAILABLE 0
+#endif
+
 ////////////////////////////////////////////////////////////
 // General: assertions
 
@@ -14,7 +14,6 @@
 #include <list>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/comparators/flip.h>
 #include <cpp-sort/comparators/projection_compare.h>
 #include <cpp-sort/fwd.h>
@@ -23,6 +22,7 @@
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include "../lower_bound.h"
+#include "../memory.h"
 #include "../type_traits.h"
 
 namespace cppsort
@@ -40,7 +40,7 @@ namespace cppsort
             if (collection.size() < 2) return;
 
             // Encroaching lists
-            std::vector<std::list<Args...>> lists;
+            scratch_vector<std::list<Args...>> lists;
             lists.emplace_back();
             lists.back().splice(lists.back().begin(), collection, collection.begin());
 
@@ -125,7 +125,7 @@ namespace cppsort
             };
 
             // Encroaching lists
-            std::vector<flist> lists;
+            scratch_vector<flist> lists;
             lists.emplace_back();
             lists.back().list.splice_after(lists.back().list.before_begin(),
                                            collection, collection.before_begin());
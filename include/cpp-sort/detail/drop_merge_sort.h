@@ -30,10 +30,10 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
 #include "iterator_traits.h"
+#include "memory.h"
 #include "type_traits.h"
 
 namespace cppsort
@@ -63,7 +63,7 @@ namespace detail
 
         using difference_type = difference_type_t<BidirectionalIterator>;
         using rvalue_type = rvalue_type_t<BidirectionalIterator>;
-        std::vector<rvalue_type> dropped;
+        scratch_vector<rvalue_type> dropped;
 
         difference_type num_dropped_in_row = 0;
         auto write = begin;
@@ -0,0 +1,434 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_EXTERNAL_SORT_H_
+#define CPPSORT_DETAIL_EXTERNAL_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <system_error>
+#include <utility>
+#include "loser_tree.h"
+#include "memory.h"
+
+#if defined(_WIN32)
+#   include <cstring>
+#else
+#   include <sys/stat.h>
+#   include <sys/types.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace external_sort_detail
+    {
+        // Maximum size of the blocks read from and written to the
+        // files, big enough to make I/O mostly sequential
+        constexpr std::size_t max_block_bytes = 1 << 20;
+
+        ////////////////////////////////////////////////////////////
+        // File handling
+
+        [[noreturn]] inline auto throw_io_error(const char* message)
+            -> void
+        {
+            int error = errno != 0 ? errno : EIO;
+            throw std::system_error(error, std::generic_category(), message);
+        }
+
+        struct file_closer
+        {
+            auto operator()(std::FILE* file) const noexcept
+                -> void
+            {
+                std::fclose(file);
+            }
+        };
+
+        using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+        inline auto open_file(const char* path, const char* mode)
+            -> file_ptr
+        {
+            errno = 0;
+            file_ptr file(std::fopen(path, mode));
+            if (not file) {
+                throw_io_error("cpp-sort: could not open a file to sort");
+            }
+            return file;
+        }
+
+        // Whether path refers to the file already open as file: the
+        // output must not be opened for writing in that case since
+        // it would truncate the input before it was read
+        inline auto is_same_file(std::FILE* file, const char* file_path, const char* path)
+            -> bool
+        {
+#if defined(_WIN32)
+            (void)file;
+            return std::strcmp(file_path, path) == 0;
+#else
+            (void)file_path;
+            struct stat file_stat;
+            struct stat path_stat;
+            if (::fstat(fileno(file), &file_stat) != 0 || ::stat(path, &path_stat) != 0) {
+                return false;
+            }
+            return file_stat.st_dev == path_stat.st_dev && file_stat.st_ino == path_stat.st_ino;
+#endif
+        }
+
+        // The temporary files are removed when closed
+        inline auto make_temporary_file()
+            -> file_ptr
+        {
+            errno = 0;
+            file_ptr file(std::tmpfile());
+            if (not file) {
+                throw_io_error("cpp-sort: could not create a temporary file");
+            }
+            return file;
+        }
+
+        // Offsets of the runs don't fit in a long on every platform,
+        // hence the platform-specific seek functions
+        using file_offset = long long int;
+
+        inline auto seek(std::FILE* file, file_offset offset)
+            -> void
+        {
+#if defined(_WIN32)
+            int res = _fseeki64(file, offset, SEEK_SET);
+#else
+            int res = fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+            if (res != 0) {
+                throw_io_error("cpp-sort: could not seek in a temporary file");
+            }
+        }
+
+        // Reads up to count records, a trailing partial record means
+        // that the file is not made of records of type T
+        template<typename T>
+        auto read_records(std::FILE* file, T* buffer, std::size_t count)
+            -> std::size_t
+        {
+            errno = 0;
+            std::size_t bytes = std::fread(buffer, 1, count * sizeof(T), file);
+            if (bytes < count * sizeof(T) && std::ferror(file)) {
+                throw_io_error("cpp-sort: could not read records");
+            }
+            if (bytes % sizeof(T) != 0) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                        "cpp-sort: the size of the file is not a multiple "
+                                        "of the size of the records");
+            }
+            return bytes / sizeof(T);
+        }
+
+        template<typename T>
+        auto write_records(std::FILE* file, const T* buffer, std::size_t count)
+            -> void
+        {
+            errno = 0;
+            if (std::fwrite(buffer, sizeof(T), count, file) != count) {
+                throw_io_error("cpp-sort: could not write records");
+            }
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Buffered readers and writers
+
+        // Sorted run stored in a file
+        struct run_info
+        {
+            file_offset offset;
+            std::size_t size;
+        };
+
+        template<typename T>
+        class run_reader
+        {
+            public:
+
+                run_reader(std::FILE* file, run_info run, std::size_t block_size):
+                    file(file),
+                    position(run.offset),
+                    remaining(run.size),
+                    buffer(std::min(block_size, run.size))
+                {
+                    load();
+                }
+
+                auto empty() const noexcept
+                    -> bool
+                {
+                    return current == size;
+                }
+
+                auto front() const noexcept
+                    -> const T&
+                {
+                    return buffer[current];
+                }
+
+                auto pop()
+                    -> void
+                {
+                    if (++current == size && remaining > 0) {
+                        load();
+                    }
+                }
+
+            private:
+
+                // Several readers share the same file, so the position
+                // is set again before reading every block
+                auto load()
+                    -> void
+                {
+                    std::size_t count = std::min(remaining, buffer.size());
+                    seek(file, position);
+                    if (read_records(file, buffer.data(), count) != count) {
+                        throw_io_error("cpp-sort: unexpected end of a temporary file");
+                    }
+                    position += static_cast<file_offset>(count * sizeof(T));
+                    remaining -= count;
+                    current = 0;
+                    size = count;
+                }
+
+                std::FILE* file;
+                file_offset position;
+                std::size_t remaining;
+                scratch_vector<T> buffer;
+                std::size_t current = 0;
+                std::size_t size = 0;
+        };
+
+        // Input iterator over a run reader, iterators equal to the
+        // default-constructed one once the run is exhausted; copies
+        // share the position of the reader, which is enough for the
+        // loser tree
+        template<typename T>
+        class run_iterator
+        {
+            public:
+
+                using iterator_category = std::input_iterator_tag;
+                using value_type = T;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const T*;
+                using reference = const T&;
+
+                run_iterator() = default;
+
+                explicit run_iterator(run_reader<T>& reader):
+                    reader(&reader)
+                {}
+
+                auto operator*() const
+                    -> reference
+                {
+                    return reader->front();
+                }
+
+                auto operator->() const
+                    -> pointer
+                {
+                    return &reader->front();
+                }
+
+                auto operator++()
+                    -> run_iterator&
+                {
+                    reader->pop();
+                    return *this;
+                }
+
+                friend auto operator==(const run_iterator& lhs, const run_iterator& rhs)
+                    -> bool
+                {
+                    return lhs.is_end() == rhs.is_end();
+                }
+
+                friend auto operator!=(const run_iterator& lhs, const run_iterator& rhs)
+                    -> bool
+                {
+                    return lhs.is_end() != rhs.is_end();
+                }
+
+            private:
+
+                auto is_end() const noexcept
+                    -> bool
+                {
+                    return reader == nullptr || reader->empty();
+                }
+
+                run_reader<T>* reader = nullptr;
+        };
+
+        template<typename T>
+        class record_writer
+        {
+            public:
+
+                record_writer(std::FILE* file, std::size_t block_size):
+                    file(file),
+                    buffer(block_size)
+                {}
+
+                auto push(const T& value)
+                    -> void
+                {
+                    buffer[size] = value;
+                    if (++size == buffer.size()) {
+                        flush();
+                    }
+                }
+
+                auto flush()
+                    -> void
+                {
+                    write_records(file, buffer.data(), size);
+                    size = 0;
+                }
+
+            private:
+
+                std::FILE* file;
+                scratch_vector<T> buffer;
+                std::size_t size = 0;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Merge of sorted runs
+
+        template<typename T, typename Compare, typename Projection>
+        auto merge_runs(std::FILE* input, const run_info* first, const run_info* last,
+                        record_writer<T>& writer, std::size_t block_size,
+                        Compare compare, Projection projection)
+            -> void
+        {
+            // The readers must not be moved once the tree refers to them
+            scratch_vector<run_reader<T>> readers;
+            readers.reserve(static_cast<std::size_t>(last - first));
+            loser_tree<run_iterator<T>, Compare, Projection> tree(std::move(compare),
+                                                                    std::move(projection));
+            for (; first != last ; ++first) {
+                readers.emplace_back(input, *first, block_size);
+                tree.add_source(run_iterator<T>(readers.back()), run_iterator<T>());
+            }
+
+            multiway_merge(tree, &writer,
+                [](run_iterator<T> it, record_writer<T>* out) {
+                    out->push(*it);
+                    return out;
+                },
+                [](run_iterator<T> it, run_iterator<T> end, record_writer<T>* out) {
+                    for (; it != end ; ++it) {
+                        out->push(*it);
+                    }
+                    return out;
+                }
+            );
+            writer.flush();
+        }
+    }
+
+    template<typename T, typename Sorter, typename Compare, typename Projection>
+    auto external_sort(std::FILE* input, std::FILE* output, std::size_t memory_budget,
+                       const Sorter& sorter, Compare compare, Projection projection)
+        -> void
+    {
+        using namespace external_sort_detail;
+
+        // Read the input by chunks as big as the memory budget allows,
+        // sort them and write them to a temporary file as sorted runs
+        scratch_vector<T> buffer((std::max)(memory_budget / sizeof(T), std::size_t(1)));
+        file_ptr runs_file;
+        scratch_vector<run_info> runs;
+        file_offset offset = 0;
+        while (true) {
+            std::size_t size = read_records(input, buffer.data(), buffer.size());
+            if (size == 0) {
+                break;
+            }
+            sorter(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(size),
+                   compare, projection);
+
+            if (size < buffer.size() && runs.empty()) {
+                // Everything fits in memory, no need for temporary files
+                write_records(output, buffer.data(), size);
+                return;
+            }
+            if (not runs_file) {
+                runs_file = make_temporary_file();
+            }
+            write_records(runs_file.get(), buffer.data(), size);
+            runs.push_back({ offset, size });
+            offset += static_cast<file_offset>(size * sizeof(T));
+        }
+        if (runs.size() < 2) {
+            if (runs.size() == 1) {
+                write_records(output, buffer.data(), runs[0].size);
+            }
+            return;
+        }
+        // Give the memory back before the merge passes
+        scratch_vector<T>(buffer.get_allocator()).swap(buffer);
+
+        // Every run being merged needs a block, and so does the output,
+        // so the size of the blocks limits the number of runs merged
+        // at once; a bigger fan-in means fewer passes over the data
+        std::size_t block_bytes = (std::min)(max_block_bytes, memory_budget / 16);
+        std::size_t block_size = (std::max)(block_bytes / sizeof(T), std::size_t(1));
+        std::size_t fan_in = (std::max)(memory_budget / (block_size * sizeof(T)), std::size_t(3)) - 1;
+
+        // Merge groups of runs until they can be merged directly
+        // into the output, ping-ponging between temporary files
+        file_ptr merge_file;
+        while (runs.size() > fan_in) {
+            if (not merge_file) {
+                merge_file = make_temporary_file();
+            }
+            seek(merge_file.get(), 0);
+            record_writer<T> writer(merge_file.get(), block_size);
+
+            scratch_vector<run_info> merged_runs;
+            offset = 0;
+            for (std::size_t idx = 0 ; idx < runs.size() ; idx += fan_in) {
+                std::size_t end = (std::min)(idx + fan_in, runs.size());
+                merge_runs(runs_file.get(), runs.data() + idx, runs.data() + end,
+                           writer, block_size, compare, projection);
+
+                std::size_t size = 0;
+                for (std::size_t run = idx ; run < end ; ++run) {
+                    size += runs[run].size;
+                }
+                merged_runs.push_back({ offset, size });
+                offset += static_cast<file_offset>(size * sizeof(T));
+            }
+
+            runs.swap(merged_runs);
+            runs_file.swap(merge_file);
+        }
+
+        record_writer<T> writer(output, block_size);
+        merge_runs(runs_file.get(), runs.data(), runs.data() + runs.size(),
+                   writer, block_size, std::move(compare), std::move(projection));
+    }
+}}
+
+#endif // CPPSORT_DETAIL_EXTERNAL_SORT_H_
@@ -23,6 +23,7 @@
 #include <cpp-sort/utility/iter_move.h>
 #include "config.h"
 #include "iterator_traits.h"
+#include "scope_exit.h"
 
 namespace cppsort
 {
@@ -63,6 +64,8 @@ namespace detail
         }
 
         auto top = iter_move(start);
+        // Fill the hole if a comparison throws
+        auto fill_hole = make_scope_exit([&] { *start = std::move(top); });
         do {
             // we are not in heap-order, swap the parent with it's largest child
             *start = iter_move(child_i);
@@ -84,13 +87,15 @@ namespace detail
 
             // check if we are in heap-order
         } while (not comp(proj(*child_i), proj(top)));
+        fill_hole.deactivate();
         *start = std::move(top);
     }
 
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     auto floyd_sift_down(RandomAccessIterator first, Compare compare, Projection projection,
-                         difference_type_t<RandomAccessIterator> len)
-        -> RandomAccessIterator
+                         difference_type_t<RandomAccessIterator> len,
+                         RandomAccessIterator& hole)
+        -> void
     {
         CPPSORT_ASSERT(len >= 2);
 
@@ -99,7 +104,6 @@ namespace detail
         auto&& proj = utility::as_function(projection);
         using difference_type = difference_type_t<RandomAccessIterator>;
 
-        auto hole = first;
         auto child_i = first;
         difference_type child = 0;
 
@@ -119,7 +123,7 @@ namespace detail
 
             // if hole is now a leaf, we're done
             if (child > (len - 2) / 2) {
-                return hole;
+                return;
             }
         }
     }
@@ -139,6 +143,8 @@ namespace detail
             if (comp(proj(*ptr), proj(*--last))) {
                 auto t = iter_move(last);
                 auto&& proj_t = proj(t);
+                // Fill the hole if a comparison throws
+                auto fill_hole = make_scope_exit([&] { *last = std::move(t); });
                 do {
                     *last = iter_move(ptr);
                     last = ptr;
@@ -148,6 +154,7 @@ namespace detail
                     len = (len - 1) / 2;
                     ptr = first + len;
                 } while (comp(proj(*ptr), proj_t));
+                fill_hole.deactivate();
                 *last = std::move(t);
             }
         }
@@ -163,7 +170,11 @@ namespace detail
 
         if (len > 1) {
             auto top = iter_move(first);  // create a hole at first
-            auto hole = detail::floyd_sift_down(first, compare, projection, len);
+            auto hole = first;
+            // Fill the hole if a comparison throws
+            auto fill_hole = make_scope_exit([&] { *hole = std::move(top); });
+            detail::floyd_sift_down(first, compare, projection, len, hole);
+            fill_hole.deactivate();
             if (hole == --last) {
                 *hole = std::move(top);
             } else {
@@ -47,8 +47,9 @@ namespace detail
 
             explicit immovable_vector(std::ptrdiff_t n):
                 capacity_(n),
+                resource_(current_scratch_resource()),
                 memory_(
-                    static_cast<T*>(::operator new(n * sizeof(T)))
+                    static_cast<T*>(scratch_allocate(n * sizeof(T), resource_))
                 ),
                 end_(memory_)
             {}
@@ -62,11 +63,7 @@ namespace detail
                 detail::destroy(memory_, end_);
 
                 // Free the allocated memory
-#ifdef __cpp_sized_deallocation
-                ::operator delete(memory_, capacity_ * sizeof(T));
-#else
-                ::operator delete(memory_);
-#endif
+                scratch_deallocate(memory_, capacity_ * sizeof(T), resource_);
             }
 
             ////////////////////////////////////////////////////////////
@@ -152,6 +149,7 @@ namespace detail
         private:
 
             std::ptrdiff_t capacity_;
+            scratch_resource_pointer resource_;
             T* memory_;
             T* end_;
     };
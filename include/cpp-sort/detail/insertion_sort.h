@@ -33,6 +33,7 @@
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "scope_exit.h"
 
 namespace cppsort
 {
@@ -58,10 +59,13 @@ namespace detail
             if (comp(proj(*sift), proj(*sift_1))) {
                 auto tmp = iter_move(sift);
                 auto&& tmp_proj = proj(tmp);
+                // Fill the hole if a comparison throws
+                auto fill_hole = make_scope_exit([&] { *sift = std::move(tmp); });
 
                 do {
                     *sift = iter_move(sift_1);
                 } while (--sift != first && comp(tmp_proj, proj(*--sift_1)));
+                fill_hole.deactivate();
                 *sift = std::move(tmp);
             }
         }
@@ -0,0 +1,685 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_IPS4O_H_
+#define CPPSORT_DETAIL_IPS4O_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "pdqsort.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // In-place (parallel) super scalar samplesort
+    //
+    // Implementation of IPS4o as described by Axtmann, Witt,
+    // Ferizovic and Sanders in *In-place Parallel Super Scalar
+    // Samplesort*. Every distribution step works as follows:
+    // - A sample of the collection is sorted and used to pick
+    //   up to 255 splitters, which are stored in an implicit
+    //   binary search tree
+    // - Every element is classified by descending that tree
+    //   without branches, and moved to a per-bucket buffer; full
+    //   buffers are written back to the front of the collection
+    //   as blocks
+    // - The blocks are permuted in place so that every bucket
+    //   gets its blocks next to each other
+    // - The partially filled buffers and the blocks overlapping
+    //   the bucket boundaries are moved to their final place
+    // The buckets are then sorted recursively, by different
+    // workers when threads are available. Only the buffers are
+    // allocated: 1 KiB per bucket and per worker.
+    //
+    // When several splitters are equal, equality buckets are
+    // added between the regular ones: they hold the elements
+    // equivalent to a splitter and need no further sorting,
+    // which makes the algorithm handle many duplicates well.
+
+    namespace ips4o_detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Tuning parameters
+
+        // Collections smaller than this are sorted with pdqsort
+        constexpr std::ptrdiff_t base_case_size = 2048;
+
+        // The number of buckets is chosen to give them at least
+        // that many elements on average
+        constexpr std::ptrdiff_t min_average_bucket_size = 256;
+
+        // Maximum number of buckets: equality buckets nearly
+        // double the number of regular buckets
+        constexpr int max_log_buckets = 8;
+        constexpr std::ptrdiff_t max_buckets = 2 * (std::ptrdiff_t(1) << max_log_buckets) - 1;
+
+        // Size of the blocks moved during the distribution
+        constexpr std::size_t block_bytes = 1024;
+
+        // Buckets smaller than this are sorted by the task that
+        // distributed them instead of being forked
+        constexpr std::ptrdiff_t parallel_threshold = 1 << 16;
+
+        template<typename T>
+        constexpr auto block_size() noexcept
+            -> std::ptrdiff_t
+        {
+            return sizeof(T) >= block_bytes ? 1 : static_cast<std::ptrdiff_t>(block_bytes / sizeof(T));
+        }
+
+        // Use enough buckets to have big enough buckets on average
+        inline auto log_buckets(std::ptrdiff_t size) noexcept
+            -> int
+        {
+            return static_cast<int>(std::min<std::ptrdiff_t>(
+                max_log_buckets,
+                detail::log2(size / min_average_bucket_size)
+            ));
+        }
+
+        // Number of blocks needed by the distribution of a collection
+        // of the given size: one block per bucket, equality buckets
+        // included, two swap blocks and an overflow block
+        inline auto buffer_blocks(std::ptrdiff_t size) noexcept
+            -> std::ptrdiff_t
+        {
+            return 2 * (std::ptrdiff_t(1) << log_buckets(size)) - 1 + 3;
+        }
+
+        // Number of elements needed by the distribution steps of
+        // a collection of the given size and of its buckets
+        template<typename T>
+        auto buffer_size(std::ptrdiff_t size) noexcept
+            -> std::ptrdiff_t
+        {
+            return buffer_blocks(size) * block_size<T>();
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Block buffers
+        //
+        // Raw memory split into blocks, keeps track of the number
+        // of objects constructed in every block so that they can
+        // be destroyed if the distribution is interrupted by an
+        // exception
+
+        template<typename T>
+        class block_buffers
+        {
+            public:
+
+                block_buffers(T* memory, std::ptrdiff_t blocks) noexcept:
+                    memory(memory),
+                    blocks(blocks),
+                    sizes()
+                {}
+
+                block_buffers(const block_buffers&) = delete;
+                block_buffers& operator=(const block_buffers&) = delete;
+
+                ~block_buffers()
+                {
+                    for (std::ptrdiff_t block = 0 ; block < blocks ; ++block) {
+                        clear(block);
+                    }
+                }
+
+                auto data(std::ptrdiff_t block) const noexcept
+                    -> T*
+                {
+                    return memory + block * block_size<T>();
+                }
+
+                auto size(std::ptrdiff_t block) const noexcept
+                    -> std::ptrdiff_t
+                {
+                    return sizes[block];
+                }
+
+                auto full(std::ptrdiff_t block) const noexcept
+                    -> bool
+                {
+                    return sizes[block] == block_size<T>();
+                }
+
+                // Move an element at the end of a block
+                template<typename Iterator>
+                auto push(std::ptrdiff_t block, Iterator it)
+                    -> void
+                {
+                    using utility::iter_move;
+                    ::new(data(block) + sizes[block]) T(iter_move(it));
+                    ++sizes[block];
+                }
+
+                // Move a whole block of the collection into a buffer
+                template<typename Iterator>
+                auto load(std::ptrdiff_t block, Iterator first)
+                    -> void
+                {
+                    for (std::ptrdiff_t i = 0 ; i < block_size<T>() ; ++i) {
+                        push(block, first);
+                        ++first;
+                    }
+                }
+
+                // Move the contents of a buffer to the collection,
+                // which leaves the buffer empty
+                template<typename Iterator>
+                auto flush(std::ptrdiff_t block, Iterator out)
+                    -> Iterator
+                {
+                    T* ptr = data(block);
+                    for (std::ptrdiff_t i = 0 ; i < sizes[block] ; ++i) {
+                        *out = std::move(ptr[i]);
+                        ++out;
+                    }
+                    clear(block);
+                    return out;
+                }
+
+                // Move the contents of a buffer to another one
+                auto transfer(std::ptrdiff_t from, std::ptrdiff_t to)
+                    -> void
+                {
+                    T* ptr = data(from);
+                    for (std::ptrdiff_t i = 0 ; i < sizes[from] ; ++i) {
+                        push(to, ptr + i);
+                    }
+                    clear(from);
+                }
+
+                auto clear(std::ptrdiff_t block) noexcept
+                    -> void
+                {
+                    detail::destroy_n(data(block), sizes[block]);
+                    sizes[block] = 0;
+                }
+
+            private:
+
+                T* memory;
+                std::ptrdiff_t blocks;
+                std::array<std::ptrdiff_t, max_buckets + 3> sizes;
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Classifier
+        //
+        // The splitters are stored in an implicit binary search
+        // tree: the children of the node i are the nodes 2i and
+        // 2i+1 and the root is the node 1, which allows to find
+        // the bucket of an element with a fixed number of
+        // comparisons and no branch
+
+        template<typename Key, typename Compare, typename Projection>
+        class classifier
+        {
+            public:
+
+                // The splitters must be sorted and distinct
+                classifier(const scratch_vector<Key>& splitters, bool use_equality_buckets,
+                           Compare compare, Projection projection):
+                    log_leaves(static_cast<int>(detail::log2(splitters.size())) + 1),
+                    use_equality_buckets(use_equality_buckets),
+                    compare(std::move(compare)),
+                    projection(std::move(projection))
+                {
+                    std::size_t leaves = std::size_t(1) << log_leaves;
+
+                    // sorted_splitters[b] is the lower bound of the leaf b,
+                    // the leaf 0 has none so the first slot is unused; the
+                    // splitters are padded with copies of the last one,
+                    // which only creates empty buckets
+                    sorted_splitters.reserve(leaves);
+                    sorted_splitters.push_back(splitters.front());
+                    for (std::size_t i = 0 ; i < leaves - 1 ; ++i) {
+                        sorted_splitters.push_back(splitters[std::min(i, splitters.size() - 1)]);
+                    }
+
+                    // Node i at depth d covers leaves / 2^d leaves,
+                    // and its splitter is the one between the two
+                    // halves of that range; the node 0 is unused
+                    tree.reserve(leaves);
+                    tree.push_back(splitters.front());
+                    for (std::size_t node = 1 ; node < leaves ; ++node) {
+                        auto depth = detail::log2(node);
+                        auto width = leaves >> depth;
+                        auto mid = (node - (std::size_t(1) << depth)) * width + width / 2;
+                        tree.push_back(sorted_splitters[mid]);
+                    }
+                }
+
+                auto num_buckets() const noexcept
+                    -> std::ptrdiff_t
+                {
+                    std::ptrdiff_t leaves = std::ptrdiff_t(1) << log_leaves;
+                    return use_equality_buckets ? 2 * leaves - 1 : leaves;
+                }
+
+                auto is_equality_bucket(std::ptrdiff_t bucket) const noexcept
+                    -> bool
+                {
+                    return use_equality_buckets && bucket % 2 == 1;
+                }
+
+                template<typename Iterator>
+                auto classify_one(Iterator it)
+                    -> std::ptrdiff_t
+                {
+                    auto&& comp = utility::as_function(compare);
+                    auto&& proj = utility::as_function(projection);
+
+                    std::size_t bucket = 1;
+                    for (int level = 0 ; level < log_leaves ; ++level) {
+                        bucket = 2 * bucket + static_cast<std::size_t>(not comp(proj(*it), tree[bucket]));
+                    }
+                    return finish(bucket, it);
+                }
+
+                // Classify the elements of [first, last) and call the
+                // given function with the bucket of every element; the
+                // elements are classified in small groups to process
+                // several independent tree descents at once, which is
+                // what makes the classification super scalar
+                template<typename Iterator, typename Function>
+                auto classify(Iterator first, Iterator last, Function func)
+                    -> void
+                {
+                    constexpr int unroll = 8;
+                    auto&& comp = utility::as_function(compare);
+                    auto&& proj = utility::as_function(projection);
+
+                    for (auto size = last - first ; size >= unroll ; size -= unroll) {
+                        std::size_t buckets[unroll];
+                        for (int i = 0 ; i < unroll ; ++i) {
+                            buckets[i] = 1;
+                        }
+                        for (int level = 0 ; level < log_leaves ; ++level) {
+                            for (int i = 0 ; i < unroll ; ++i) {
+                                buckets[i] = 2 * buckets[i] + static_cast<std::size_t>(
+                                    not comp(proj(first[i]), tree[buckets[i]])
+                                );
+                            }
+                        }
+
+                        std::ptrdiff_t results[unroll];
+                        for (int i = 0 ; i < unroll ; ++i) {
+                            results[i] = finish(buckets[i], first + i);
+                        }
+                        for (int i = 0 ; i < unroll ; ++i) {
+                            func(results[i], first);
+                            ++first;
+                        }
+                    }
+                    for (; first != last ; ++first) {
+                        func(classify_one(first), first);
+                    }
+                }
+
+            private:
+
+                // Turn the index of a leaf into the index of a bucket
+                template<typename Iterator>
+                auto finish(std::size_t leaf, Iterator it)
+                    -> std::ptrdiff_t
+                {
+                    auto bucket = static_cast<std::ptrdiff_t>(leaf - (std::size_t(1) << log_leaves));
+                    if (use_equality_buckets && bucket != 0) {
+                        // The elements of the leaf b > 0 are not smaller
+                        // than sorted_splitters[b], they go to the equality
+                        // bucket 2b-1 when they are equivalent to it
+                        auto&& comp = utility::as_function(compare);
+                        auto&& proj = utility::as_function(projection);
+                        bucket = 2 * bucket - static_cast<std::ptrdiff_t>(
+                            not comp(sorted_splitters[bucket], proj(*it))
+                        );
+                    }
+                    return bucket;
+                }
+
+                int log_leaves;
+                bool use_equality_buckets;
+                scratch_vector<Key> tree;
+                scratch_vector<Key> sorted_splitters;
+                Compare compare;
+                Projection projection;
+        };
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto make_classifier(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection)
+            -> classifier<projected_t<RandomAccessIterator, Projection>, Compare, Projection>
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            using key_type = projected_t<RandomAccessIterator, Projection>;
+
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            // Oversample to get better splitters
+            difference_type size = last - first;
+            difference_type num_buckets = difference_type(1) << log_buckets(size);
+            difference_type oversampling = std::max<difference_type>(1, detail::log2(size) / 5);
+            difference_type sample_size = oversampling * num_buckets - 1;
+
+            // Move a pseudo-random sample to the front of the collection,
+            // the generator is seeded with the size to keep the algorithm
+            // deterministic
+            std::uint_fast64_t state = 0x9e3779b97f4a7c15u ^ static_cast<std::uint_fast64_t>(size);
+            for (difference_type i = 0 ; i < sample_size ; ++i) {
+                state ^= state << 13;
+                state ^= state >> 7;
+                state ^= state << 17;
+                auto offset = static_cast<difference_type>(state % static_cast<std::uint_fast64_t>(size - i));
+                iter_swap(first + i, first + (i + offset));
+            }
+            pdqsort(first, first + sample_size, compare, projection);
+
+            // Pick equidistant splitters in the sorted sample
+            scratch_vector<key_type> splitters;
+            splitters.reserve(num_buckets - 1);
+            bool has_duplicates = false;
+            for (difference_type i = 1 ; i < num_buckets ; ++i) {
+                auto it = first + (i * oversampling - 1);
+                if (not splitters.empty() && not comp(splitters.back(), proj(*it))) {
+                    has_duplicates = true;
+                    continue;
+                }
+                splitters.emplace_back(proj(*it));
+            }
+
+            // Equality buckets are also used when there is a single
+            // splitter since it is the only way to guarantee that
+            // the distribution makes progress
+            bool use_equality_buckets = has_duplicates || splitters.size() == 1;
+            return { splitters, use_equality_buckets, std::move(compare), std::move(projection) };
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Distribution step
+        //
+        // Distributes the elements of the collection into buckets,
+        // writes the bucket boundaries to bounds and returns the
+        // classifier that was used to do it
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto distribute(RandomAccessIterator first, RandomAccessIterator last,
+                        rvalue_type_t<RandomAccessIterator>* buffer,
+                        Compare compare, Projection projection,
+                        scratch_vector<difference_type_t<RandomAccessIterator>>& bounds)
+            -> classifier<projected_t<RandomAccessIterator, Projection>, Compare, Projection>
+        {
+            using utility::iter_move;
+            using value_type = rvalue_type_t<RandomAccessIterator>;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            constexpr difference_type block = block_size<value_type>();
+
+            auto classes = make_classifier(first, last, std::move(compare), std::move(projection));
+            difference_type size = last - first;
+            difference_type num_buckets = classes.num_buckets();
+            const difference_type swap_blocks[] = { num_buckets, num_buckets + 1 };
+            const difference_type overflow_block = num_buckets + 2;
+
+            ////////////////////////////////////////////////////////////
+            // Local classification: full buffers are written back as
+            // blocks at the front of the collection, which is always
+            // possible since at least as many elements were read
+
+            block_buffers<value_type> buffers(buffer, num_buckets + 3);
+            bounds.assign(num_buckets + 1, 0);
+            auto write = first;
+            classes.classify(first, last, [&](difference_type bucket, RandomAccessIterator it) {
+                buffers.push(bucket, it);
+                if (buffers.full(bucket)) {
+                    write = buffers.flush(bucket, write);
+                    bounds[bucket + 1] += block;
+                }
+            });
+            for (difference_type bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                bounds[bucket + 1] += buffers.size(bucket) + bounds[bucket];
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Block permutation: the blocks of a bucket go to the
+            // block-aligned slots between its aligned boundaries, the
+            // slots in [next_write[b], next_read[b]) still hold blocks
+            // that were not moved to their final bucket
+
+            auto align = [](difference_type offset) -> difference_type {
+                return (offset + block - 1) / block * block;
+            };
+            difference_type written = write - first;
+            scratch_vector<difference_type> next_write(num_buckets);
+            scratch_vector<difference_type> next_read(num_buckets);
+            for (difference_type bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                next_write[bucket] = align(bounds[bucket]);
+                next_read[bucket] = std::max(next_write[bucket],
+                                             std::min(align(bounds[bucket + 1]), written));
+            }
+
+            // The slot straddling the end of the collection, if any,
+            // is written to the overflow buffer instead
+            difference_type overflow_bucket = -1;
+            for (difference_type bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                while (next_write[bucket] < next_read[bucket]) {
+                    next_read[bucket] -= block;
+                    int current = 0;
+                    auto dest = classes.classify_one(first + next_read[bucket]);
+                    buffers.load(swap_blocks[current], first + next_read[bucket]);
+
+                    while (true) {
+                        // Skip the blocks already in the right bucket
+                        difference_type next = dest;
+                        while (next_write[dest] < next_read[dest]) {
+                            next = classes.classify_one(first + next_write[dest]);
+                            if (next != dest) break;
+                            next_write[dest] += block;
+                        }
+
+                        if (next_write[dest] < next_read[dest]) {
+                            // Swap the block with one that must be moved
+                            auto slot = first + next_write[dest];
+                            buffers.load(swap_blocks[1 - current], slot);
+                            buffers.flush(swap_blocks[current], slot);
+                            next_write[dest] += block;
+                            current = 1 - current;
+                            dest = next;
+                        } else {
+                            // Empty slot, the cycle ends here
+                            if (next_write[dest] + block > size) {
+                                buffers.transfer(swap_blocks[current], overflow_block);
+                                overflow_bucket = dest;
+                            } else {
+                                buffers.flush(swap_blocks[current], first + next_write[dest]);
+                            }
+                            next_write[dest] += block;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Cleanup: fill the holes at both ends of every bucket with
+            // the elements of its buffer, of the overflow buffer, or of
+            // its last block when it spills over the next bucket; the
+            // buckets are processed in order so that those spilt
+            // elements are moved away before the next bucket is filled
+
+            for (difference_type bucket = 0 ; bucket < num_buckets ; ++bucket) {
+                difference_type begin = bounds[bucket];
+                difference_type end = bounds[bucket + 1];
+                difference_type blocks_end = next_write[bucket];
+                if (bucket == overflow_bucket) {
+                    blocks_end -= block;
+                }
+
+                // The holes are [begin, head_end) and [tail_begin, end)
+                auto out = first + begin;
+                auto out_end = first + std::min(align(begin), end);
+                auto tail_begin = first + std::min(blocks_end, end);
+                auto fill = [&](auto&& value) {
+                    if (out == out_end) {
+                        out = tail_begin;
+                    }
+                    *out = std::move(value);
+                    ++out;
+                };
+
+                if (bucket != overflow_bucket) {
+                    // Buckets without blocks start their empty region
+                    // after their end, they have nothing spilt
+                    auto spill_end = blocks_end > align(begin) ? blocks_end : end;
+                    for (auto offset = end ; offset < spill_end ; ++offset) {
+                        fill(iter_move(first + offset));
+                    }
+                } else {
+                    value_type* ptr = buffers.data(overflow_block);
+                    for (difference_type i = 0 ; i < buffers.size(overflow_block) ; ++i) {
+                        fill(std::move(ptr[i]));
+                    }
+                    buffers.clear(overflow_block);
+                }
+                value_type* ptr = buffers.data(bucket);
+                for (difference_type i = 0 ; i < buffers.size(bucket) ; ++i) {
+                    fill(std::move(ptr[i]));
+                }
+                buffers.clear(bucket);
+            }
+
+            return classes;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Recursive algorithm
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto ips4o_loop(work_stealing_pool* pool, std::size_t worker,
+                        scratch_vector<temporary_buffer<rvalue_type_t<RandomAccessIterator>>>& buffers,
+                        RandomAccessIterator first, RandomAccessIterator last,
+                        Compare compare, Projection projection, int depth_limit)
+            -> void
+        {
+            using value_type = rvalue_type_t<RandomAccessIterator>;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+
+            // Fall back to pdqsort for small collections, when the
+            // distribution fails to make progress too often, or when
+            // the buffer could not be allocated
+            auto& buffer = buffers[worker];
+            if (last - first <= base_case_size || depth_limit == 0 ||
+                buffer.size() < buffer_size<value_type>(last - first)) {
+                pdqsort(std::move(first), std::move(last),
+                        std::move(compare), std::move(projection));
+                return;
+            }
+
+            scratch_vector<difference_type> bounds;
+            auto classes = distribute(first, last, buffer.data(), compare, projection, bounds);
+
+            for (difference_type bucket = 0 ; bucket < classes.num_buckets() ; ++bucket) {
+                auto bucket_first = first + bounds[bucket];
+                auto bucket_last = first + bounds[bucket + 1];
+                if (classes.is_equality_bucket(bucket) || bucket_last - bucket_first < 2) {
+                    continue;
+                }
+
+                if (pool != nullptr && bucket_last - bucket_first >= parallel_threshold) {
+                    pool->push(worker, [pool, &buffers, bucket_first, bucket_last,
+                                        compare, projection, depth_limit](std::size_t current_worker) {
+                        ips4o_loop(pool, current_worker, buffers, bucket_first, bucket_last,
+                                   compare, projection, depth_limit - 1);
+                    });
+                } else {
+                    ips4o_loop(pool, worker, buffers, bucket_first, bucket_last,
+                               compare, projection, depth_limit - 1);
+                }
+            }
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto ips4o(RandomAccessIterator first, RandomAccessIterator last,
+                   Compare compare, Projection projection,
+                   std::size_t max_threads, std::true_type /* copyable keys */)
+            -> void
+        {
+            using value_type = rvalue_type_t<RandomAccessIterator>;
+
+            auto size = last - first;
+            if (size <= base_case_size) {
+                pdqsort(std::move(first), std::move(last),
+                        std::move(compare), std::move(projection));
+                return;
+            }
+            int depth_limit = static_cast<int>(detail::log2(size));
+
+            auto workers = parallel_workers_count(static_cast<std::size_t>(size),
+                                                  static_cast<std::size_t>(parallel_threshold),
+                                                  max_threads);
+            // The buckets are smaller than the collection, so they
+            // never need more memory than the first distribution step
+            scratch_vector<temporary_buffer<value_type>> buffers;
+            buffers.reserve(workers);
+            for (std::size_t i = 0 ; i < workers ; ++i) {
+                buffers.emplace_back(buffer_size<value_type>(size));
+            }
+
+            if (workers < 2) {
+                ips4o_loop(nullptr, 0, buffers, std::move(first), std::move(last),
+                           std::move(compare), std::move(projection), depth_limit);
+                return;
+            }
+
+            work_stealing_pool pool(workers);
+            pool.run([&](std::size_t worker) {
+                ips4o_loop(&pool, worker, buffers, first, last,
+                           compare, projection, depth_limit);
+            });
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto ips4o(RandomAccessIterator first, RandomAccessIterator last,
+                   Compare compare, Projection projection,
+                   std::size_t /* max_threads */, std::false_type /* copyable keys */)
+            -> void
+        {
+            // The splitters are copies of projected elements, which is
+            // not possible when the projection yields non-copyable values
+            pdqsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto ips4o(RandomAccessIterator first, RandomAccessIterator last,
+               Compare compare, Projection projection,
+               std::size_t max_threads)
+        -> void
+    {
+        using key_type = projected_t<RandomAccessIterator, Projection>;
+        ips4o_detail::ips4o(std::move(first), std::move(last),
+                            std::move(compare), std::move(projection), max_threads,
+                            std::is_copy_constructible<key_type>{});
+    }
+}}
+
+#endif // CPPSORT_DETAIL_IPS4O_H_
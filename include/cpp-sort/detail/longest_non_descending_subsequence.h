@@ -11,10 +11,10 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include "iterator_traits.h"
+#include "memory.h"
 #include "upper_bound.h"
 
 namespace cppsort
@@ -59,7 +59,7 @@ namespace detail
         auto&& proj = utility::as_function(projection);
 
         // Top (smaller) elements in patience sorting stacks
-        std::vector<ForwardIterator> stack_tops;
+        scratch_vector<ForwardIterator> stack_tops;
 
         while (first != last) {
             auto it = detail::upper_bound(
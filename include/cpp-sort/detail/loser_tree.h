@@ -0,0 +1,227 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_LOSER_TREE_H_
+#define CPPSORT_DETAIL_LOSER_TREE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include "memory.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Tournament tree of losers
+    //
+    // Engine for k-way merges: the leaves of the tree are the
+    // sorted sources to merge and every internal node holds the
+    // source that lost the match played there, the overall
+    // winner being kept apart. Once the current element of the
+    // winning source is consumed, only the matches on the path
+    // from its leaf to the root need to be replayed, which takes
+    // about log2(k) comparisons per element.
+    //
+    // The nodes live in an array where the children of the node
+    // i are the nodes 2i and 2i+1 and the leaf of the source i is
+    // k+i, which gives a valid tree for any number of sources.
+    // Exhausted sources are removed from the tree, and equivalent
+    // elements are won by the source with the smallest index, which
+    // makes the merge stable when the sources are given in order.
+    //
+    // The sources can be changed with clear() and add_source(),
+    // which allows to reuse the memory of the tree for several
+    // merges.
+
+    template<typename Iterator, typename Compare, typename Projection>
+    class loser_tree
+    {
+        public:
+
+            loser_tree(Compare compare, Projection projection):
+                compare(std::move(compare)),
+                projection(std::move(projection))
+            {}
+
+            ////////////////////////////////////////////////////////////
+            // Sources management
+
+            auto clear() noexcept
+                -> void
+            {
+                sources.clear();
+            }
+
+            auto add_source(Iterator first, Iterator last)
+                -> void
+            {
+                sources.emplace_back(std::move(first), std::move(last));
+            }
+
+            // Play the initial matches, must be called once every
+            // source has been added and before accessing the winner
+            auto build()
+                -> void
+            {
+                // Empty sources don't take part in the tournament
+                sources.erase(
+                    std::remove_if(sources.begin(), sources.end(), [](const auto& source) {
+                        return source.first == source.second;
+                    }),
+                    sources.end()
+                );
+                rebuild();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Merge interface
+
+            // Number of sources that still have elements
+            auto active_sources() const noexcept
+                -> std::size_t
+            {
+                return sources.size();
+            }
+
+            // Iterator to the smallest element among the sources
+            auto top() const
+                -> Iterator
+            {
+                return nodes[0].current;
+            }
+
+            // Remaining elements of the winning source
+            auto top_range() const
+                -> std::pair<Iterator, Iterator>
+            {
+                return { nodes[0].current, sources[nodes[0].source].second };
+            }
+
+            // Consume the smallest element and replay the matches of its source
+            auto pop()
+                -> void
+            {
+                node winner = nodes[0];
+                if (++winner.current == sources[winner.source].second) {
+                    // Remove the exhausted source and play the matches
+                    // again, which is cheap enough for small k and
+                    // spares checking for exhausted sources in every
+                    // single match
+                    for (auto& elem: nodes) {
+                        sources[elem.source].first = elem.current;
+                    }
+                    sources.erase(sources.begin() + static_cast<std::ptrdiff_t>(winner.source));
+                    rebuild();
+                    return;
+                }
+
+                for (std::size_t idx = (sources.size() + winner.source) / 2 ; idx > 0 ; idx /= 2) {
+                    if (beats(nodes[idx], winner)) {
+                        std::swap(nodes[idx], winner);
+                    }
+                }
+                nodes[0] = winner;
+            }
+
+        private:
+
+            // Nodes store the current element of their source to
+            // avoid an indirection in every match
+            struct node
+            {
+                Iterator current;
+                std::size_t source;
+            };
+
+            auto rebuild()
+                -> void
+            {
+                std::size_t size = sources.size();
+                nodes.clear();
+                if (size == 0) {
+                    return;
+                }
+                nodes.resize(size, node{ sources[0].first, 0 });
+                if (size == 1) {
+                    return;
+                }
+
+                // Winners of the subtrees, only needed to build the tree
+                winners.clear();
+                winners.resize(2 * size, node{ sources[0].first, 0 });
+                for (std::size_t idx = 0 ; idx < size ; ++idx) {
+                    winners[size + idx] = node{ sources[idx].first, idx };
+                }
+                for (std::size_t idx = size - 1 ; idx > 0 ; --idx) {
+                    const node& lhs = winners[2 * idx];
+                    const node& rhs = winners[2 * idx + 1];
+                    if (beats(lhs, rhs)) {
+                        winners[idx] = lhs;
+                        nodes[idx] = rhs;
+                    } else {
+                        winners[idx] = rhs;
+                        nodes[idx] = lhs;
+                    }
+                }
+                nodes[0] = winners[1];
+            }
+
+            // Whether the current element of lhs comes before the
+            // current element of rhs, sources with smaller indices
+            // winning ties; the arguments are swapped instead of
+            // branching on the indices, which helps the compiler to
+            // avoid an unpredictable branch
+            auto beats(const node& lhs, const node& rhs)
+                -> bool
+            {
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                bool lhs_first = lhs.source < rhs.source;
+                const node& first = lhs_first ? rhs : lhs;
+                const node& second = lhs_first ? lhs : rhs;
+                return static_cast<bool>(comp(proj(*first.current), proj(*second.current))) != lhs_first;
+            }
+
+            scratch_vector<std::pair<Iterator, Iterator>> sources;
+            // nodes[0] is the overall winner, the other ones are losers
+            scratch_vector<node> nodes;
+            scratch_vector<node> winners;
+            Compare compare;
+            Projection projection;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // K-way merge
+
+    // Merges the sources of the tree into result, transfer(it, out)
+    // is called to write every element to the output and returns
+    // the incremented output iterator; the remaining elements of
+    // the last source are passed to transfer_range(first, last, out)
+    template<typename Iterator, typename Compare, typename Projection,
+             typename OutputIterator, typename Transfer, typename TransferRange>
+    auto multiway_merge(loser_tree<Iterator, Compare, Projection>& tree, OutputIterator result,
+                        Transfer transfer, TransferRange transfer_range)
+        -> OutputIterator
+    {
+        tree.build();
+        while (tree.active_sources() > 1) {
+            result = transfer(tree.top(), result);
+            tree.pop();
+        }
+        if (tree.active_sources() == 1) {
+            auto range = tree.top_range();
+            result = transfer_range(range.first, range.second, result);
+        }
+        return result;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_LOSER_TREE_H_
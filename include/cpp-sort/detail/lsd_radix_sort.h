@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+#define CPPSORT_DETAIL_LSD_RADIX_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "insertion_sort.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "merge_sort.h"
+#include "move.h"
+#include "ska_sort.h" // to_unsigned_or_bool
+#include "type_traits.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace lsd_radix_sort_detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Radix keys
+        //
+        // A radix key describes how to read a fixed-size key one
+        // byte at a time, byte 0 being the least significant one.
+        // Scalars are converted to unsigned integers the same way
+        // ska_sort does it, and pairs and tuples are seen as the
+        // concatenation of the keys of their elements
+
+        template<typename T, typename=void>
+        struct radix_key
+        {
+            static constexpr bool is_sortable = false;
+        };
+
+        template<typename T>
+        struct radix_key<T, void_t<decltype(to_unsigned_or_bool(std::declval<const T&>()))>>
+        {
+            static constexpr bool is_sortable = true;
+
+            using unsigned_type = decltype(to_unsigned_or_bool(std::declval<const T&>()));
+            static constexpr std::size_t size = sizeof(unsigned_type);
+
+            static auto byte(const T& value, std::size_t index)
+                -> std::uint8_t
+            {
+                return static_cast<std::uint8_t>(to_unsigned_or_bool(value) >> (index * 8));
+            }
+
+            static auto less(const T& lhs, const T& rhs)
+                -> bool
+            {
+                return to_unsigned_or_bool(lhs) < to_unsigned_or_bool(rhs);
+            }
+        };
+
+        template<typename First, typename Second>
+        struct radix_key<
+            std::pair<First, Second>,
+            enable_if_t<
+                radix_key<remove_cvref_t<First>>::is_sortable &&
+                radix_key<remove_cvref_t<Second>>::is_sortable
+            >
+        >
+        {
+            using first_key = radix_key<remove_cvref_t<First>>;
+            using second_key = radix_key<remove_cvref_t<Second>>;
+
+            static constexpr bool is_sortable = true;
+            static constexpr std::size_t size = first_key::size + second_key::size;
+
+            static auto byte(const std::pair<First, Second>& value, std::size_t index)
+                -> std::uint8_t
+            {
+                if (index < second_key::size) {
+                    return second_key::byte(value.second, index);
+                }
+                return first_key::byte(value.first, index - second_key::size);
+            }
+
+            static auto less(const std::pair<First, Second>& lhs, const std::pair<First, Second>& rhs)
+                -> bool
+            {
+                if (first_key::less(lhs.first, rhs.first)) return true;
+                if (first_key::less(rhs.first, lhs.first)) return false;
+                return second_key::less(lhs.second, rhs.second);
+            }
+        };
+
+        // Key made of the elements of a tuple starting at Index
+        template<std::size_t Index, typename Tuple,
+                 bool=(Index == std::tuple_size<Tuple>::value)>
+        struct tuple_radix_key
+        {
+            using element_key = radix_key<remove_cvref_t<std::tuple_element_t<Index, Tuple>>>;
+            using next_key = tuple_radix_key<Index + 1, Tuple>;
+
+            static constexpr bool is_sortable = true;
+            static constexpr std::size_t size = element_key::size + next_key::size;
+
+            static auto byte(const Tuple& value, std::size_t index)
+                -> std::uint8_t
+            {
+                if (index < next_key::size) {
+                    return next_key::byte(value, index);
+                }
+                return element_key::byte(std::get<Index>(value), index - next_key::size);
+            }
+
+            static auto less(const Tuple& lhs, const Tuple& rhs)
+                -> bool
+            {
+                if (element_key::less(std::get<Index>(lhs), std::get<Index>(rhs))) return true;
+                if (element_key::less(std::get<Index>(rhs), std::get<Index>(lhs))) return false;
+                return next_key::less(lhs, rhs);
+            }
+        };
+
+        template<std::size_t Index, typename Tuple>
+        struct tuple_radix_key<Index, Tuple, true>
+        {
+            static constexpr bool is_sortable = true;
+            static constexpr std::size_t size = 0;
+
+            static auto byte(const Tuple&, std::size_t)
+                -> std::uint8_t
+            {
+                return 0;
+            }
+
+            static auto less(const Tuple&, const Tuple&)
+                -> bool
+            {
+                return false;
+            }
+        };
+
+        template<typename... Args>
+        struct radix_key<
+            std::tuple<Args...>,
+            enable_if_t<
+                sizeof...(Args) != 0 &&
+                conjunction<
+                    std::integral_constant<bool, radix_key<remove_cvref_t<Args>>::is_sortable>...
+                >::value
+            >
+        >:
+            tuple_radix_key<0, std::tuple<Args...>>
+        {};
+
+        // Comparison consistent with the order produced by the radix sort,
+        // used to sort small collections and when no memory is available
+        template<typename Key>
+        struct radix_key_less
+        {
+            template<typename T>
+            auto operator()(const T& lhs, const T& rhs) const
+                -> bool
+            {
+                return Key::less(lhs, rhs);
+            }
+        };
+
+        // Collections smaller than this are sorted with an insertion sort
+        constexpr std::ptrdiff_t insertion_sort_threshold = 64;
+
+        ////////////////////////////////////////////////////////////
+        // Distribution passes
+
+        template<typename Key, typename InputIterator, typename T, typename Projection>
+        auto uninitialized_scatter(InputIterator first, InputIterator last, T* out,
+                                   std::size_t* offsets, std::size_t digit,
+                                   Projection projection)
+            -> void
+        {
+            using utility::iter_move;
+            auto&& proj = utility::as_function(projection);
+
+            for (; first != last ; ++first) {
+                auto offset = offsets[Key::byte(proj(*first), digit)]++;
+                ::new(static_cast<void*>(out + offset)) T(iter_move(first));
+            }
+        }
+
+        template<typename Key, typename InputIterator, typename OutputIterator, typename Projection>
+        auto scatter(InputIterator first, InputIterator last, OutputIterator out,
+                     std::size_t* offsets, std::size_t digit,
+                     Projection projection)
+            -> void
+        {
+            using utility::iter_move;
+            using difference_type = difference_type_t<OutputIterator>;
+            auto&& proj = utility::as_function(projection);
+
+            for (; first != last ; ++first) {
+                auto offset = offsets[Key::byte(proj(*first), digit)]++;
+                out[static_cast<difference_type>(offset)] = iter_move(first);
+            }
+        }
+
+        // Ping-pong between the collection and the buffer for every
+        // digit to distribute, the passes read the elements from
+        // the buffer first when in_buffer is true; returns whether
+        // the sorted elements end up in the buffer
+        template<typename Key, typename RandomAccessIterator, typename T, typename Projection>
+        auto distribute(RandomAccessIterator first, RandomAccessIterator last, T* buffer,
+                        std::array<std::size_t, 256>* counts, const std::size_t* digits,
+                        std::size_t digits_count, bool in_buffer,
+                        Projection projection)
+            -> bool
+        {
+            auto size = last - first;
+            for (std::size_t idx = 0 ; idx < digits_count ; ++idx) {
+                auto digit = digits[idx];
+                if (in_buffer) {
+                    scatter<Key>(buffer, buffer + size, first, counts[digit].data(), digit, projection);
+                } else {
+                    scatter<Key>(first, last, buffer, counts[digit].data(), digit, projection);
+                }
+                in_buffer = not in_buffer;
+            }
+            return in_buffer;
+        }
+    }
+
+    template<typename T>
+    constexpr bool is_lsd_radix_sortable_v
+        = lsd_radix_sort_detail::radix_key<remove_cvref_t<T>>::is_sortable;
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto lsd_radix_sort(RandomAccessIterator first, RandomAccessIterator last,
+                        Projection projection)
+        -> void
+    {
+        using namespace lsd_radix_sort_detail;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+        using key = radix_key<remove_cvref_t<projected_t<RandomAccessIterator, Projection>>>;
+        auto&& proj = utility::as_function(projection);
+
+        auto size = last - first;
+        if (size < insertion_sort_threshold) {
+            insertion_sort(std::move(first), std::move(last),
+                           radix_key_less<key>{}, std::move(projection));
+            return;
+        }
+
+        // The histograms of big keys don't fit on the stack, fall
+        // back to a stable comparison sort if they can't be allocated
+        constexpr auto counts_size = static_cast<std::ptrdiff_t>(key::size);
+        temporary_buffer<std::array<std::size_t, 256>> counts_buffer(counts_size);
+        if (counts_buffer.size() < counts_size) {
+            merge_sort(std::move(first), std::move(last), size,
+                       radix_key_less<key>{}, std::move(projection));
+            return;
+        }
+        auto counts = counts_buffer.data();
+        std::uninitialized_fill_n(counts, key::size, std::array<std::size_t, 256>{});
+
+        // Compute the histograms of every digit in a single pass
+        for (auto it = first ; it != last ; ++it) {
+            auto&& value = proj(*it);
+            for (std::size_t digit = 0 ; digit < key::size ; ++digit) {
+                ++counts[digit][key::byte(value, digit)];
+            }
+        }
+
+        // Skip the digits shared by every element, and turn the
+        // histograms of the other ones into offsets
+        std::size_t digits[key::size];
+        std::size_t digits_count = 0;
+        auto&& first_value = proj(*first);
+        for (std::size_t digit = 0 ; digit < key::size ; ++digit) {
+            if (counts[digit][key::byte(first_value, digit)] == static_cast<std::size_t>(size)) {
+                continue;
+            }
+            digits[digits_count] = digit;
+            ++digits_count;
+            std::size_t total = 0;
+            for (auto& count: counts[digit]) {
+                auto tmp = count;
+                count = total;
+                total += tmp;
+            }
+        }
+        if (digits_count == 0) {
+            return;
+        }
+
+        temporary_buffer<rvalue_type> buffer(size);
+        if (buffer.size() < size) {
+            // Not enough memory: fall back to a stable comparison sort
+            merge_sort(std::move(first), std::move(last), size,
+                       radix_key_less<key>{}, std::move(projection));
+            return;
+        }
+
+        if (std::is_trivially_copyable<rvalue_type>::value) {
+            // The first pass can directly construct the elements in the
+            // buffer, and they don't need to be destroyed afterwards
+            uninitialized_scatter<key>(first, last, buffer.data(),
+                                       counts[digits[0]].data(), digits[0], projection);
+            bool in_buffer = distribute<key>(first, last, buffer.data(), counts,
+                                             digits + 1, digits_count - 1, true, projection);
+            if (in_buffer) {
+                detail::move(buffer.data(), buffer.data() + size, first);
+            }
+        } else {
+            // Move all the elements to the buffer first so that the
+            // following passes only need to assign elements
+            destruct_n<rvalue_type> d(0);
+            std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.data(), d);
+            uninitialized_move(first, last, buffer.data(), d);
+            bool in_buffer = distribute<key>(first, last, buffer.data(), counts,
+                                             digits, digits_count, true, projection);
+            if (in_buffer) {
+                detail::move(buffer.data(), buffer.data() + size, first);
+            }
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_LSD_RADIX_SORT_H_
@@ -23,8 +23,15 @@
 #include <new>
 #include <type_traits>
 #include <utility>
+#include <vector>
+#include "algorithm_events.h"
+#include "config.h"
 #include "type_traits.h"
 
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+#   include <memory_resource>
+#endif
+
 namespace cppsort
 {
 namespace detail
@@ -61,35 +68,276 @@ namespace detail
     }
 
     ////////////////////////////////////////////////////////////
-    // Deleter for ::operator new(std::size_t)
+    // Scratch memory
+    //
+    // Every buffer that the library allocates for the duration
+    // of an algorithm goes through these functions: they use
+    // the memory resource installed for the current thread when
+    // there is one, and ::operator new otherwise. The resource
+    // is recorded alongside the memory so that the memory is
+    // always given back to the resource it comes from.
+
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+    using scratch_resource_pointer = std::pmr::memory_resource*;
+
+    inline auto current_scratch_resource() noexcept
+        -> scratch_resource_pointer&
+    {
+        static thread_local scratch_resource_pointer resource = nullptr;
+        return resource;
+    }
+#else
+    struct scratch_resource_pointer {};
+
+    inline auto current_scratch_resource() noexcept
+        -> scratch_resource_pointer
+    {
+        return {};
+    }
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Scratch memory statistics
+    //
+    // When statistics are installed for the current thread, the
+    // scratch memory functions record the memory they allocate
+    // and free, which is what metrics::allocations reports
+
+    struct scratch_statistics
+    {
+        std::size_t allocations = 0;
+        std::size_t bytes = 0;
+        std::size_t live_bytes = 0;
+        std::size_t peak_bytes = 0;
+    };
+
+    inline auto current_scratch_statistics() noexcept
+        -> scratch_statistics*&
+    {
+        static thread_local scratch_statistics* statistics = nullptr;
+        return statistics;
+    }
+
+    inline auto record_scratch_allocation(std::size_t size) noexcept
+        -> void
+    {
+        auto statistics = current_scratch_statistics();
+        if (statistics != nullptr) {
+            ++statistics->allocations;
+            statistics->bytes += size;
+            statistics->live_bytes += size;
+            if (statistics->live_bytes > statistics->peak_bytes) {
+                statistics->peak_bytes = statistics->live_bytes;
+            }
+        }
+    }
+
+    inline auto record_scratch_deallocation(std::size_t size) noexcept
+        -> void
+    {
+        auto statistics = current_scratch_statistics();
+        if (statistics != nullptr) {
+            // The memory might have been allocated before the
+            // statistics were installed
+            statistics->live_bytes -= size < statistics->live_bytes ? size : statistics->live_bytes;
+        }
+    }
+
+    // Installs statistics for the current thread for as long as
+    // it lives, then adds them to the previous ones if any
+    class scoped_scratch_statistics
+    {
+        public:
+
+            explicit scoped_scratch_statistics(scratch_statistics& statistics) noexcept:
+                previous_(current_scratch_statistics()),
+                statistics_(&statistics)
+            {
+                current_scratch_statistics() = statistics_;
+            }
+
+            scoped_scratch_statistics(const scoped_scratch_statistics&) = delete;
+            scoped_scratch_statistics& operator=(const scoped_scratch_statistics&) = delete;
+
+            ~scoped_scratch_statistics()
+            {
+                current_scratch_statistics() = previous_;
+                if (previous_ != nullptr) {
+                    previous_->allocations += statistics_->allocations;
+                    previous_->bytes += statistics_->bytes;
+                    if (previous_->live_bytes + statistics_->peak_bytes > previous_->peak_bytes) {
+                        previous_->peak_bytes = previous_->live_bytes + statistics_->peak_bytes;
+                    }
+                    previous_->live_bytes += statistics_->live_bytes;
+                }
+            }
+
+        private:
+
+            scratch_statistics* previous_;
+            scratch_statistics* statistics_;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Scratch memory allocation functions
+
+    inline auto scratch_allocate(std::size_t size, scratch_resource_pointer resource)
+        -> void*
+    {
+        void* res;
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+        if (resource != nullptr) {
+            res = resource->allocate(size);
+        } else {
+            res = ::operator new(size);
+        }
+#else
+        (void)resource;
+        res = ::operator new(size);
+#endif
+        record_scratch_allocation(size);
+        return res;
+    }
+
+    inline auto scratch_allocate(std::size_t size, scratch_resource_pointer resource,
+                                 const std::nothrow_t&) noexcept
+        -> void*
+    {
+        void* res;
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+        if (resource != nullptr) {
+            try {
+                res = resource->allocate(size);
+            } catch (...) {
+                return nullptr;
+            }
+        } else {
+            res = ::operator new(size, std::nothrow);
+        }
+#else
+        (void)resource;
+        res = ::operator new(size, std::nothrow);
+#endif
+        if (res != nullptr) {
+            record_scratch_allocation(size);
+        }
+        return res;
+    }
+
+    inline auto scratch_deallocate(void* pointer, std::size_t size,
+                                   scratch_resource_pointer resource) noexcept
+        -> void
+    {
+        if (pointer != nullptr) {
+            record_scratch_deallocation(size);
+        }
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+        if (resource != nullptr) {
+            if (pointer != nullptr) {
+                resource->deallocate(pointer, size);
+            }
+            return;
+        }
+#else
+        (void)resource;
+#endif
+#ifdef __cpp_sized_deallocation
+        ::operator delete(pointer, size);
+#else
+        (void)size;
+        ::operator delete(pointer);
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Deleter for scratch memory
 
     struct operator_deleter
     {
         operator_deleter() = default;
 
-#ifdef __cpp_sized_deallocation
+        explicit operator_deleter(std::size_t size) noexcept:
+            size(size),
+            resource(current_scratch_resource())
+        {}
+
+        auto operator()(void* pointer) const noexcept
+            -> void
+        {
+            scratch_deallocate(pointer, size, resource);
+        }
+
         std::size_t size = 0;
+        scratch_resource_pointer resource{};
+    };
 
-        constexpr explicit operator_deleter(std::size_t size) noexcept:
-            size(size)
+    // Allocates uninitialized memory for count objects of type T
+    template<typename T>
+    auto make_scratch_buffer(std::size_t count)
+        -> std::unique_ptr<T, operator_deleter>
+    {
+        operator_deleter deleter(count * sizeof(T));
+        return std::unique_ptr<T, operator_deleter>(
+            static_cast<T*>(scratch_allocate(deleter.size, deleter.resource)),
+            deleter
+        );
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Allocator for scratch std::vector instances
+
+    template<typename T>
+    struct scratch_allocator
+    {
+        using value_type = T;
+
+        scratch_allocator() noexcept:
+            resource(current_scratch_resource())
         {}
 
-        inline auto operator()(void* pointer) const noexcept
-            -> void
+        template<typename U>
+        scratch_allocator(const scratch_allocator<U>& other) noexcept:
+            resource(other.resource)
+        {}
+
+        auto allocate(std::size_t count)
+            -> T*
         {
-            ::operator delete(pointer, size);
+            return static_cast<T*>(scratch_allocate(count * sizeof(T), resource));
         }
-#else
-        constexpr explicit operator_deleter(std::size_t) noexcept {}
 
-        inline auto operator()(void* pointer) const noexcept
+        auto deallocate(T* pointer, std::size_t count) noexcept
             -> void
         {
-            ::operator delete(pointer);
+            scratch_deallocate(pointer, count * sizeof(T), resource);
         }
-#endif
+
+        scratch_resource_pointer resource;
     };
 
+    template<typename T, typename U>
+    auto operator==(const scratch_allocator<T>& lhs, const scratch_allocator<U>& rhs) noexcept
+        -> bool
+    {
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+        return lhs.resource == rhs.resource;
+#else
+        (void)lhs;
+        (void)rhs;
+        return true;
+#endif
+    }
+
+    template<typename T, typename U>
+    auto operator!=(const scratch_allocator<T>& lhs, const scratch_allocator<U>& rhs) noexcept
+        -> bool
+    {
+        return not (lhs == rhs);
+    }
+
+    template<typename T>
+    using scratch_vector = std::vector<T, scratch_allocator<T>>;
+
     ////////////////////////////////////////////////////////////
     // Deleter for placement new-allocated memory
 
@@ -151,7 +399,8 @@ namespace detail
      * than \a min_count objects.
      */
     template<typename T>
-    auto get_temporary_buffer(std::ptrdiff_t count, std::ptrdiff_t min_count) noexcept
+    auto get_temporary_buffer(std::ptrdiff_t count, std::ptrdiff_t min_count,
+                              scratch_resource_pointer resource) noexcept
         -> std::pair<T*, std::ptrdiff_t>
     {
         std::pair<T*, std::ptrdiff_t> res(nullptr, 0);
@@ -165,7 +414,7 @@ namespace detail
         // Try to gradually allocate less memory until we get a valid buffer
         // or until the amount of memory to allocate reaches 0
         while (count > min_count) {
-            res.first = static_cast<T*>(::operator new(count * sizeof(T), std::nothrow));
+            res.first = static_cast<T*>(scratch_allocate(count * sizeof(T), resource, std::nothrow));
             if (res.first) {
                 res.second = count;
                 break;
@@ -175,16 +424,26 @@ namespace detail
         return res;
     }
 
+    template<typename T>
+    auto get_temporary_buffer(std::ptrdiff_t count, std::ptrdiff_t min_count) noexcept
+        -> std::pair<T*, std::ptrdiff_t>
+    {
+        return get_temporary_buffer<T>(count, min_count, current_scratch_resource());
+    }
+
+    template<typename T>
+    auto return_temporary_buffer(T* ptr, std::size_t count,
+                                 scratch_resource_pointer resource) noexcept
+        -> void
+    {
+        scratch_deallocate(ptr, count * sizeof(T), resource);
+    }
+
     template<typename T>
     auto return_temporary_buffer(T* ptr, std::size_t count) noexcept
         -> void
     {
-#ifdef __cpp_sized_deallocation
-        ::operator delete(ptr, count * sizeof(T));
-#else
-        (void)count;
-        ::operator delete(ptr);
-#endif
+        return_temporary_buffer(ptr, count, current_scratch_resource());
     }
 
     ////////////////////////////////////////////////////////////
@@ -209,7 +468,8 @@ namespace detail
 
             temporary_buffer(temporary_buffer&& other) noexcept:
                 buffer(other.buffer),
-                buffer_size(other.buffer_size)
+                buffer_size(other.buffer_size),
+                resource(other.resource)
             {
                 other.buffer = nullptr;
                 other.buffer_size = 0;
@@ -217,16 +477,17 @@ namespace detail
 
             constexpr temporary_buffer(std::nullptr_t) noexcept {}
 
-            explicit temporary_buffer(std::ptrdiff_t count) noexcept
+            explicit temporary_buffer(std::ptrdiff_t count) noexcept:
+                resource(current_scratch_resource())
             {
-                auto tmp = get_temporary_buffer<T>(count, 0);
+                auto tmp = get_temporary_buffer<T>(count, 0, resource);
                 buffer = tmp.first;
                 buffer_size = tmp.second;
             }
 
             ~temporary_buffer() noexcept
             {
-                return_temporary_buffer<T>(buffer, buffer_size);
+                return_temporary_buffer<T>(buffer, buffer_size, resource);
             }
 
             ////////////////////////////////////////////////////////////
@@ -240,6 +501,7 @@ namespace detail
                 using std::swap;
                 swap(buffer, other.buffer);
                 swap(buffer_size, other.buffer_size);
+                swap(resource, other.resource);
                 return *this;
             }
 
@@ -264,13 +526,23 @@ namespace detail
             auto try_grow(std::ptrdiff_t count) noexcept
                 -> bool
             {
-                auto tmp = get_temporary_buffer<T>(count, buffer_size);
+                auto new_resource = current_scratch_resource();
+                auto tmp = get_temporary_buffer<T>(count, buffer_size, new_resource);
                 if (not tmp.first) {
                     // If it failed to allocate a bigger buffer, keep the old one
+                    if (count > buffer_size) {
+                        CPPSORT_ALGORITHM_EVENT(buffer_growth_failures);
+                    }
                     return false;
                 }
+                if (tmp.second < count) {
+                    CPPSORT_ALGORITHM_EVENT(buffer_partial_growths);
+                } else {
+                    CPPSORT_ALGORITHM_EVENT(buffer_growths);
+                }
                 // If the allocated buffer is big enough, replace the previous one
-                return_temporary_buffer(buffer, buffer_size);
+                return_temporary_buffer(buffer, buffer_size, resource);
+                resource = new_resource;
                 buffer = tmp.first;
                 buffer_size = tmp.second;
                 return true;
@@ -280,6 +552,7 @@ namespace detail
 
             T* buffer = nullptr;
             std::ptrdiff_t buffer_size = 0;
+            scratch_resource_pointer resource{};
     };
 }}
 
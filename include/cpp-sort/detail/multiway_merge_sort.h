@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_MULTIWAY_MERGE_SORT_H_
+#define CPPSORT_DETAIL_MULTIWAY_MERGE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cpp-sort/utility/iter_move.h>
+#include "insertion_sort.h"
+#include "iterator_traits.h"
+#include "loser_tree.h"
+#include "memory.h"
+#include "merge_sort.h"
+#include "move.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace multiway_merge_sort_detail
+    {
+        // Size of the runs sorted with insertion sort
+        constexpr std::ptrdiff_t run_size = 32;
+
+        // Number of runs merged together by every merge
+        constexpr std::ptrdiff_t fan_in = 8;
+
+        // Merges every group of fan_in consecutive runs of size
+        // run_length of [first, first + size) into out, transfer and
+        // transfer_range are passed to the k-way merge
+        template<typename InputIterator, typename OutputIterator,
+                 typename Compare, typename Projection,
+                 typename Transfer, typename TransferRange>
+        auto merge_pass(loser_tree<InputIterator, Compare, Projection>& tree,
+                        InputIterator first, std::ptrdiff_t size,
+                        OutputIterator out, std::ptrdiff_t run_length,
+                        Transfer transfer, TransferRange transfer_range)
+            -> void
+        {
+            for (std::ptrdiff_t begin = 0 ; begin < size ; begin += run_length * fan_in) {
+                tree.clear();
+                for (std::ptrdiff_t run = begin ;
+                     run < size && run < begin + run_length * fan_in ;
+                     run += run_length) {
+                    auto run_end = size - run > run_length ? run + run_length : size;
+                    tree.add_source(first + run, first + run_end);
+                }
+                multiway_merge(tree, out + begin, transfer, transfer_range);
+            }
+        }
+
+        // Merge pass between two initialized sequences
+        template<typename InputIterator, typename OutputIterator,
+                 typename Compare, typename Projection>
+        auto merge_pass(loser_tree<InputIterator, Compare, Projection>& tree,
+                        InputIterator first, std::ptrdiff_t size,
+                        OutputIterator out, std::ptrdiff_t run_length)
+            -> void
+        {
+            using utility::iter_move;
+            merge_pass(tree, first, size, out, run_length,
+                [](InputIterator it, OutputIterator res) {
+                    *res = iter_move(it);
+                    return ++res;
+                },
+                [](InputIterator it, InputIterator last, OutputIterator res) {
+                    return detail::move(it, last, res);
+                }
+            );
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto multiway_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection)
+        -> void
+    {
+        using namespace multiway_merge_sort_detail;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+
+        std::ptrdiff_t size = last - first;
+        if (size <= run_size) {
+            insertion_sort(std::move(first), std::move(last),
+                           std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Without a buffer big enough, fall back to the memory-adaptive
+        // merge sort used by merge_sorter
+        temporary_buffer<rvalue_type> buffer(size);
+        if (buffer.size() < size) {
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        for (std::ptrdiff_t begin = 0 ; begin < size ; begin += run_size) {
+            auto end = size - begin > run_size ? begin + run_size : size;
+            insertion_sort(first + begin, first + end, compare, projection);
+        }
+
+        // The first pass constructs the elements in the buffer
+        loser_tree<RandomAccessIterator, Compare, Projection> collection_tree(compare, projection);
+        loser_tree<rvalue_type*, Compare, Projection> buffer_tree(compare, projection);
+        destruct_n<rvalue_type> d(0);
+        std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.data(), d);
+        merge_pass(collection_tree, first, size, buffer.data(), run_size,
+            [&d](RandomAccessIterator it, rvalue_type* res) {
+                using utility::iter_move;
+                ::new(static_cast<void*>(res)) rvalue_type(iter_move(it));
+                ++d;
+                return ++res;
+            },
+            [&d](RandomAccessIterator it, RandomAccessIterator last, rvalue_type* res) {
+                return uninitialized_move(it, last, res, d);
+            }
+        );
+
+        // Merge the next groups of runs, ping-ponging between the
+        // collection and the buffer, which needs log_k(n) passes
+        // instead of the log2(n) passes of a 2-way merge sort
+        bool in_buffer = true;
+        for (std::ptrdiff_t run_length = run_size * fan_in ; run_length < size ; run_length *= fan_in) {
+            if (in_buffer) {
+                merge_pass(buffer_tree, buffer.data(), size, first, run_length);
+            } else {
+                merge_pass(collection_tree, first, size, buffer.data(), run_length);
+            }
+            in_buffer = not in_buffer;
+        }
+
+        if (in_buffer) {
+            detail::move(buffer.data(), buffer.data() + size, first);
+        }
+    }
+}}
+
+#endif // CPPSORT_DETAIL_MULTIWAY_MERGE_SORT_H_
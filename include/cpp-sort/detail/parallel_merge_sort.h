@@ -0,0 +1,280 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "inplace_merge.h"
+#include "iterator_traits.h"
+#include "memory.h"
+#include "merge_sort.h"
+#include "move.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_merge_sort_detail
+    {
+        // Minimum number of elements sorted or merged by a task
+        constexpr std::ptrdiff_t sequential_threshold = 1 << 14;
+
+        ////////////////////////////////////////////////////////////
+        // Merge path
+        //
+        // Returns the number of elements of the first range among
+        // the first k elements of the stable merge of both ranges,
+        // which allows to split a merge into independent pieces
+
+        template<typename Iterator1, typename Iterator2, typename Compare, typename Projection>
+        auto co_rank(Iterator1 first1, std::ptrdiff_t len1,
+                     Iterator2 first2, std::ptrdiff_t len2,
+                     std::ptrdiff_t k, Compare compare, Projection projection)
+            -> std::ptrdiff_t
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            std::ptrdiff_t lo = k > len2 ? k - len2 : 0;
+            std::ptrdiff_t hi = k < len1 ? k : len1;
+            while (lo < hi) {
+                std::ptrdiff_t mid = lo + (hi - lo) / 2;
+                // Elements of the first range win ties to keep the merge stable
+                if (comp(proj(first2[k - mid - 1]), proj(first1[mid]))) {
+                    hi = mid;
+                } else {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+
+        // Piece of the merge of [begin, middle) and [middle, end): the
+        // elements [k_first, k_last) of the merged range come from the
+        // elements [i_first, i_last) of the first range and from the
+        // elements [k_first - i_first, k_last - i_last) of the second one
+        struct merge_piece_bounds
+        {
+            std::ptrdiff_t begin, middle, end;
+            std::ptrdiff_t k_first, k_last;
+            std::ptrdiff_t i_first, i_last;
+        };
+
+        // Merges a piece of the stable merge of two ranges, moving
+        // the elements to the corresponding positions of out
+        template<typename InputIterator, typename OutputIterator, typename Compare, typename Projection>
+        auto merge_piece(InputIterator first1, InputIterator first2, OutputIterator out,
+                         const merge_piece_bounds& piece,
+                         Compare compare, Projection projection)
+            -> void
+        {
+            using utility::iter_move;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto it1 = first1 + piece.i_first;
+            auto last1 = first1 + piece.i_last;
+            auto it2 = first2 + (piece.k_first - piece.i_first);
+            auto last2 = first2 + (piece.k_last - piece.i_last);
+            out += piece.k_first;
+
+            if (it1 != last1 && it2 != last2) {
+                while (true) {
+                    if (comp(proj(*it2), proj(*it1))) {
+                        *out = iter_move(it2);
+                        ++out;
+                        if (++it2 == last2) break;
+                    } else {
+                        *out = iter_move(it1);
+                        ++out;
+                        if (++it1 == last1) break;
+                    }
+                }
+            }
+            out = detail::move(it1, last1, out);
+            detail::move(it2, last2, out);
+        }
+
+        // Merges every pair of consecutive runs of [first, first + size)
+        // into out, a lone last run is moved as is; bounds holds the
+        // boundaries of the runs and is updated to the new ones
+        template<typename InputIterator, typename OutputIterator,
+                 typename Compare, typename Projection>
+        auto merge_pass(work_stealing_pool& pool, std::size_t worker,
+                        InputIterator first, OutputIterator out,
+                        scratch_vector<std::ptrdiff_t>& bounds,
+                        std::ptrdiff_t piece_size,
+                        Compare compare, Projection projection)
+            -> void
+        {
+            scratch_vector<std::ptrdiff_t> new_bounds;
+            new_bounds.reserve(bounds.size() / 2 + 1);
+            new_bounds.push_back(0);
+
+            // Split the merges into pieces of similar sizes; the split
+            // points are computed before any piece is merged since the
+            // merges move the elements the binary searches would read
+            scratch_vector<merge_piece_bounds> pieces;
+            for (std::size_t idx = 0 ; idx + 1 < bounds.size() ; idx += 2) {
+                std::ptrdiff_t begin = bounds[idx];
+                std::ptrdiff_t middle = bounds[idx + 1];
+                std::ptrdiff_t end = idx + 2 < bounds.size() ? bounds[idx + 2] : middle;
+                new_bounds.push_back(end);
+
+                std::ptrdiff_t len1 = middle - begin;
+                std::ptrdiff_t len2 = end - middle;
+                std::ptrdiff_t i_first = 0;
+                for (std::ptrdiff_t k = 0 ; k < len1 + len2 ; k += piece_size) {
+                    std::ptrdiff_t k_last = (len1 + len2 - k) > piece_size ? k + piece_size : len1 + len2;
+                    auto i_last = co_rank(first + begin, len1, first + middle, len2,
+                                          k_last, compare, projection);
+                    pieces.push_back({ begin, middle, end, k, k_last, i_first, i_last });
+                    i_first = i_last;
+                }
+            }
+
+            std::atomic<std::size_t> latch(0);
+            for (const auto& piece: pieces) {
+                pool.push(worker, [=](std::size_t) {
+                    merge_piece(first + piece.begin, first + piece.middle, out + piece.begin,
+                                piece, compare, projection);
+                }, latch);
+            }
+            pool.wait(worker, latch);
+            bounds = std::move(new_bounds);
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_merge_sort(RandomAccessIterator first, RandomAccessIterator last,
+                             Compare compare, Projection projection,
+                             std::size_t max_threads)
+        -> void
+    {
+        using namespace parallel_merge_sort_detail;
+        using rvalue_type = rvalue_type_t<RandomAccessIterator>;
+
+        auto size = last - first;
+        auto workers = parallel_workers_count(static_cast<std::size_t>(size),
+                                              static_cast<std::size_t>(sequential_threshold),
+                                              max_threads);
+        if (workers < 2) {
+            merge_sort(std::move(first), std::move(last), size,
+                       std::move(compare), std::move(projection));
+            return;
+        }
+
+        // Boundaries of the runs sorted by the first pass
+        scratch_vector<std::ptrdiff_t> bounds;
+        bounds.reserve(workers + 1);
+        for (std::size_t idx = 0 ; idx <= workers ; ++idx) {
+            bounds.push_back(static_cast<std::ptrdiff_t>(
+                static_cast<std::size_t>(size) / workers * idx
+                + (static_cast<std::size_t>(size) % workers) * idx / workers
+            ));
+        }
+
+        // Merges are performed out-of-place when enough memory is available
+        temporary_buffer<rvalue_type> buffer(size);
+        bool has_buffer = buffer.size() >= size;
+
+        destruct_n<rvalue_type> d(0);
+        std::unique_ptr<rvalue_type, destruct_n<rvalue_type>&> h2(buffer.data(), d);
+
+        work_stealing_pool pool(workers);
+        pool.run([&](std::size_t worker) {
+            // Sort the runs concurrently, every task uses the
+            // sequential merge sort with its own memory buffer
+            std::atomic<std::size_t> latch(0);
+            for (std::size_t idx = 0 ; idx + 1 < bounds.size() ; ++idx) {
+                auto begin = first + bounds[idx];
+                auto end = first + bounds[idx + 1];
+                pool.push(worker, [=](std::size_t) {
+                    merge_sort(begin, end, end - begin, compare, projection);
+                }, latch);
+            }
+            pool.wait(worker, latch);
+            if (pool.cancelled()) return;
+
+            if (not has_buffer) {
+                // Not enough memory: merge pairs of runs concurrently
+                // with the buffered merge used by merge_sort, which
+                // can still work with a smaller buffer
+                while (bounds.size() > 2) {
+                    scratch_vector<std::ptrdiff_t> new_bounds;
+                    new_bounds.push_back(0);
+                    for (std::size_t idx = 0 ; idx + 1 < bounds.size() ; idx += 2) {
+                        if (idx + 2 >= bounds.size()) {
+                            new_bounds.push_back(bounds[idx + 1]);
+                            break;
+                        }
+                        auto begin = first + bounds[idx];
+                        auto middle = first + bounds[idx + 1];
+                        auto end = first + bounds[idx + 2];
+                        pool.push(worker, [=](std::size_t) {
+                            inplace_merge(begin, middle, end, compare, projection,
+                                          middle - begin, end - middle);
+                        }, latch);
+                        new_bounds.push_back(bounds[idx + 2]);
+                    }
+                    pool.wait(worker, latch);
+                    if (pool.cancelled()) return;
+                    bounds = std::move(new_bounds);
+                }
+                return;
+            }
+
+            // Split the merges into pieces so that every worker takes part
+            // in the last passes too, and ping-pong between the collection
+            // and the buffer; non-trivial elements are first moved to the
+            // buffer so that the merges only have to assign elements, in
+            // which case the first pass reads them from the buffer
+            bool in_buffer = false;
+            if (not std::is_trivial<rvalue_type>::value) {
+                uninitialized_move(first, last, buffer.data(), d);
+                in_buffer = true;
+            }
+            auto piece_size = size / static_cast<std::ptrdiff_t>(workers);
+            if (piece_size < sequential_threshold) {
+                piece_size = sequential_threshold;
+            }
+
+            while (bounds.size() > 2) {
+                if (in_buffer) {
+                    merge_pass(pool, worker, buffer.data(), first, bounds,
+                               piece_size, compare, projection);
+                } else {
+                    merge_pass(pool, worker, first, buffer.data(), bounds,
+                               piece_size, compare, projection);
+                }
+                if (pool.cancelled()) return;
+                in_buffer = not in_buffer;
+            }
+
+            if (in_buffer) {
+                for (std::ptrdiff_t idx = 0 ; idx < size ; idx += piece_size) {
+                    auto piece_last = (size - idx) > piece_size ? idx + piece_size : size;
+                    auto buffer_first = buffer.data();
+                    pool.push(worker, [=](std::size_t) {
+                        detail::move(buffer_first + idx, buffer_first + piece_last, first + idx);
+                    }, latch);
+                }
+                pool.wait(worker, latch);
+            }
+        });
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_MERGE_SORT_H_
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+#define CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "bitops.h"
+#include "heapsort.h"
+#include "iterator_traits.h"
+#include "iter_sort3.h"
+#include "pdqsort.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_pdqsort_detail
+    {
+        // Partitions smaller than this are sorted sequentially by
+        // the task that produced them instead of being forked
+        constexpr std::ptrdiff_t sequential_threshold = 1 << 14;
+
+        // Same algorithm as pdqsort_loop, except that the left partition
+        // is pushed to the pool instead of being sorted recursively, and
+        // that the sequential loop takes over once the partition to sort
+        // gets small enough. Every task carries its own bad_allowed counter
+        // which gives it the same O(n log n) guarantee as the sequential
+        // algorithm
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto parallel_pdqsort_loop(work_stealing_pool& pool, std::size_t worker,
+                                   RandomAccessIterator begin, RandomAccessIterator end,
+                                   Compare compare, Projection projection,
+                                   int bad_allowed, bool leftmost)
+            -> void
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
+
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            while (true) {
+                difference_type size = end - begin;
+
+                // Small partitions are not worth the scheduling overhead
+                if (size < sequential_threshold) {
+                    pdqsort_detail::pdqsort_loop(std::move(begin), std::move(end),
+                                                 std::move(compare), std::move(projection),
+                                                 bad_allowed, leftmost);
+                    return;
+                }
+
+                // Partitions are always big enough to choose the pivot
+                // as a pseudomedian of 9
+                difference_type s2 = size / 2;
+                iter_sort3(begin, begin + s2, end - 1, compare, projection);
+                iter_sort3(begin + 1, begin + (s2 - 1), end - 2, compare, projection);
+                iter_sort3(begin + 2, begin + (s2 + 1), end - 3, compare, projection);
+                iter_sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1), compare, projection);
+                iter_swap(begin, begin + s2);
+
+                // Elements equal to the pivot of the previous partition
+                // don't need to be sorted, see pdqsort_loop
+                if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                    begin = pdqsort_detail::partition_left(begin, end, compare, projection) + 1;
+                    continue;
+                }
+
+                std::pair<RandomAccessIterator, bool> part_result =
+                    pdqsort_detail::partition_right_dispatch(begin, end, compare, projection);
+                RandomAccessIterator pivot_pos = part_result.first;
+                bool already_partitioned = part_result.second;
+
+                difference_type l_size = pivot_pos - begin;
+                difference_type r_size = end - (pivot_pos + 1);
+                bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+                if (highly_unbalanced) {
+                    if (--bad_allowed == 0) {
+                        heapsort(std::move(begin), std::move(end),
+                                 std::move(compare), std::move(projection));
+                        return;
+                    }
+                    pdqsort_detail::break_patterns(begin, pivot_pos, end);
+                } else {
+                    if (already_partitioned &&
+                        pdqsort_detail::partial_insertion_sort(begin, pivot_pos, compare, projection) &&
+                        pdqsort_detail::partial_insertion_sort(pivot_pos + 1, end, compare, projection)) {
+                        return;
+                    }
+                }
+
+                // Fork the left partition and keep working on the right one,
+                // idle workers steal the oldest and thus biggest partitions
+                if (l_size < sequential_threshold) {
+                    pdqsort_detail::pdqsort_loop(begin, pivot_pos, compare, projection,
+                                                 bad_allowed, leftmost);
+                } else {
+                    pool.push(worker, [&pool, begin, pivot_pos, compare, projection,
+                                       bad_allowed, leftmost](std::size_t current_worker) {
+                        parallel_pdqsort_loop(pool, current_worker, begin, pivot_pos,
+                                              compare, projection, bad_allowed, leftmost);
+                    });
+                }
+                begin = pivot_pos + 1;
+                leftmost = false;
+            }
+        }
+    }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto parallel_pdqsort(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection,
+                          std::size_t max_threads)
+        -> void
+    {
+        using parallel_pdqsort_detail::sequential_threshold;
+
+        auto size = end - begin;
+        auto workers = parallel_workers_count(static_cast<std::size_t>(size),
+                                              static_cast<std::size_t>(sequential_threshold),
+                                              max_threads);
+        if (workers < 2) {
+            pdqsort(std::move(begin), std::move(end),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        work_stealing_pool pool(workers);
+        pool.run([&](std::size_t worker) {
+            parallel_pdqsort_detail::parallel_pdqsort_loop(
+                pool, worker, begin, end, compare, projection,
+                detail::log2(size), true
+            );
+        });
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_PDQSORT_H_
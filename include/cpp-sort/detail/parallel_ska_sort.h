@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+#define CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "iterator_traits.h"
+#include "memory.h"
+#include "partition.h"
+#include "scope_exit.h"
+#include "ska_sort.h"
+#include "type_traits.h"
+#include "work_stealing_pool.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    namespace parallel_ska_sort_detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Constants & helper types
+
+        // Same thresholds as ska_sort
+        constexpr std::ptrdiff_t std_sort_threshold = 128;
+        constexpr std::ptrdiff_t american_flag_sort_threshold = 1024;
+
+        // Partitions smaller than this are sorted sequentially
+        constexpr std::ptrdiff_t parallel_threshold = 1 << 16;
+
+        template<typename RandomAccessIterator, typename Projection>
+        using next_sort_t = void (*)(RandomAccessIterator, RandomAccessIterator,
+                                     std::ptrdiff_t, Projection, void*);
+
+        // Scratch memory shared by all the tasks: every partition
+        // uses the part of the buffers that corresponds to its own
+        // position in the collection, so tasks never overlap. When
+        // the buffers could not be allocated, the elements pointer
+        // is null and the scatter is performed in-place
+        template<typename T>
+        struct scatter_buffers
+        {
+            T* elements;
+            std::uint8_t* digits;
+
+            auto offset(std::ptrdiff_t n) const noexcept
+                -> scatter_buffers
+            {
+                if (elements == nullptr) {
+                    return *this;
+                }
+                return { elements + n, digits + n };
+            }
+        };
+
+        // Splits [0, size) into count chunks of similar sizes
+        inline auto chunk_bound(std::ptrdiff_t size, std::size_t count, std::size_t index)
+            -> std::ptrdiff_t
+        {
+            return static_cast<std::ptrdiff_t>(
+                static_cast<std::size_t>(size) / count * index
+                + (static_cast<std::size_t>(size) % count) * index / count
+            );
+        }
+
+        template<typename CurrentSubKey, typename SubKeyType=typename CurrentSubKey::sub_key_type,
+                 typename Enable=void>
+        struct ParallelInplaceSorter;
+
+        ////////////////////////////////////////////////////////////
+        // Parallel radix sort step for unsigned sub-keys
+        //
+        // Every step distributes a partition according to one byte of
+        // the current sub-key:
+        // - The histogram is computed per chunk by every worker
+        // - When the scratch buffers are available, every worker
+        //   scatters its own chunk to the buffer at offsets computed
+        //   from the per-chunk histograms, then the elements are
+        //   moved back cooperatively
+        // - Otherwise the in-place ska_sort scatter is used
+        // - Every bucket is finally handed to a worker: big buckets
+        //   are distributed again in parallel according to the next
+        //   byte, small ones are sorted with the sequential algorithm
+
+        template<typename CurrentSubKey, std::size_t NumBytes, std::size_t Offset=0>
+        struct ParallelUnsignedSorter
+        {
+            using sequential_sorter = UnsignedInplaceSorter<
+                std_sort_threshold, american_flag_sort_threshold,
+                CurrentSubKey, NumBytes, Offset
+            >;
+
+            template<typename RandomAccessIterator, typename Projection, typename T>
+            static auto sort(work_stealing_pool& pool, std::size_t worker,
+                             RandomAccessIterator begin, RandomAccessIterator end,
+                             std::ptrdiff_t num_elements, Projection projection,
+                             next_sort_t<RandomAccessIterator, Projection> next_sort,
+                             void* sort_data, scatter_buffers<T> buffers)
+                -> void
+            {
+                if (num_elements < parallel_threshold) {
+                    sequential_sorter::sort(std::move(begin), std::move(end), num_elements,
+                                            std::move(projection), next_sort, sort_data);
+                    return;
+                }
+
+                // Compute one histogram per chunk
+                std::size_t nb_chunks = pool.size();
+                scratch_vector<std::size_t> offsets(nb_chunks * 256, 0);
+                std::atomic<std::size_t> latch(0);
+                // The tasks refer to local variables: wait for them
+                // even if scheduling one of them throws
+                auto wait_tasks = make_scope_exit([&] {
+                    pool.wait(worker, latch);
+                });
+                for (std::size_t chunk = 0 ; chunk < nb_chunks ; ++chunk) {
+                    pool.push(worker, [&, chunk](std::size_t) {
+                        auto&& proj = utility::as_function(projection);
+                        std::size_t* counts = offsets.data() + chunk * 256;
+                        auto first = chunk_bound(num_elements, nb_chunks, chunk);
+                        auto last = chunk_bound(num_elements, nb_chunks, chunk + 1);
+                        for (auto idx = first ; idx != last ; ++idx) {
+                            auto digit = sequential_sorter::current_byte(proj(begin[idx]), sort_data);
+                            if (buffers.elements != nullptr) {
+                                buffers.digits[idx] = digit;
+                            }
+                            ++counts[digit];
+                        }
+                    }, latch);
+                }
+                pool.wait(worker, latch);
+                if (pool.cancelled()) return;
+
+                // Turn the histograms into per-chunk write offsets
+                PartitionInfo partitions[256];
+                std::size_t total = 0;
+                int num_partitions = 0;
+                for (std::size_t digit = 0 ; digit < 256 ; ++digit) {
+                    partitions[digit].offset = total;
+                    for (std::size_t chunk = 0 ; chunk < nb_chunks ; ++chunk) {
+                        std::size_t count = offsets[chunk * 256 + digit];
+                        offsets[chunk * 256 + digit] = total;
+                        total += count;
+                    }
+                    partitions[digit].next_offset = total;
+                    num_partitions += (partitions[digit].offset != total);
+                }
+
+                // Distribute the elements unless they all share the same digit
+                if (num_partitions > 1) {
+                    if (buffers.elements != nullptr) {
+                        scatter(pool, worker, begin, num_elements, offsets.data(), nb_chunks, buffers);
+                    } else {
+                        inplace_scatter(begin, projection, partitions, sort_data);
+                    }
+                }
+
+                // Sort every bucket according to the next byte
+                if (Offset + 1 != NumBytes || next_sort) {
+                    std::size_t start_offset = 0;
+                    for (std::size_t digit = 0 ; digit < 256 ; ++digit) {
+                        std::size_t end_offset = partitions[digit].next_offset;
+                        auto bucket_size = static_cast<std::ptrdiff_t>(end_offset - start_offset);
+                        if (bucket_size > 1) {
+                            auto bucket_begin = begin + start_offset;
+                            auto bucket_end = begin + end_offset;
+                            auto bucket_buffers = buffers.offset(static_cast<std::ptrdiff_t>(start_offset));
+                            pool.push(worker, [=, &pool](std::size_t current_worker) {
+                                sort_partition(pool, current_worker, bucket_begin, bucket_end,
+                                               bucket_size, projection, next_sort, sort_data,
+                                               bucket_buffers);
+                            }, latch);
+                        }
+                        start_offset = end_offset;
+                    }
+                    pool.wait(worker, latch);
+                }
+            }
+
+            template<typename RandomAccessIterator, typename Projection, typename T>
+            static auto sort_partition(work_stealing_pool& pool, std::size_t worker,
+                                       RandomAccessIterator begin, RandomAccessIterator end,
+                                       std::ptrdiff_t num_elements, Projection projection,
+                                       next_sort_t<RandomAccessIterator, Projection> next_sort,
+                                       void* sort_data, scatter_buffers<T> buffers)
+                -> void
+            {
+                if (not StdSortIfLessThanThreshold<std_sort_threshold>(begin, end, num_elements, projection)) {
+                    ParallelUnsignedSorter<CurrentSubKey, NumBytes, Offset + 1>::sort(
+                        pool, worker, begin, end, num_elements, projection,
+                        next_sort, sort_data, buffers);
+                }
+            }
+
+            // Cooperative out-of-place scatter: the digits of the elements
+            // were stored during the histogram pass, which means that this
+            // step can't throw as long as moving the elements can't throw.
+            // Tasks discarded because another task threw are run by the
+            // current worker instead so that no element is left behind
+            template<typename RandomAccessIterator, typename T>
+            static auto scatter(work_stealing_pool& pool, std::size_t worker,
+                                RandomAccessIterator begin, std::ptrdiff_t num_elements,
+                                std::size_t* offsets, std::size_t nb_chunks,
+                                scatter_buffers<T> buffers)
+                -> void
+            {
+                using utility::iter_move;
+
+                auto scatter_chunk = [=](std::size_t chunk) {
+                    std::size_t* chunk_offsets = offsets + chunk * 256;
+                    auto first = chunk_bound(num_elements, nb_chunks, chunk);
+                    auto last = chunk_bound(num_elements, nb_chunks, chunk + 1);
+                    for (auto idx = first ; idx != last ; ++idx) {
+                        auto position = chunk_offsets[buffers.digits[idx]]++;
+                        ::new(buffers.elements + position) T(iter_move(begin + idx));
+                    }
+                };
+                auto move_back_chunk = [=](std::size_t chunk) {
+                    auto first = chunk_bound(num_elements, nb_chunks, chunk);
+                    auto last = chunk_bound(num_elements, nb_chunks, chunk + 1);
+                    for (auto idx = first ; idx != last ; ++idx) {
+                        begin[idx] = std::move(buffers.elements[idx]);
+                        detail::destroy_at(buffers.elements + idx);
+                    }
+                };
+
+                scratch_vector<char> done(nb_chunks, false);
+                auto run_phase = [&](auto phase) {
+                    std::fill(done.begin(), done.end(), false);
+                    std::atomic<std::size_t> latch(0);
+                    auto wait_tasks = make_scope_exit([&] {
+                        pool.wait(worker, latch);
+                    });
+                    for (std::size_t chunk = 0 ; chunk < nb_chunks ; ++chunk) {
+                        pool.push(worker, [&, phase, chunk](std::size_t) {
+                            phase(chunk);
+                            done[chunk] = true;
+                        }, latch);
+                    }
+                    pool.wait(worker, latch);
+                    for (std::size_t chunk = 0 ; chunk < nb_chunks ; ++chunk) {
+                        if (not done[chunk]) {
+                            phase(chunk);
+                        }
+                    }
+                };
+                run_phase(scatter_chunk);
+                run_phase(move_back_chunk);
+            }
+
+            // Sequential in-place scatter, same as the one in ska_byte_sort
+            // except that the histogram is already known
+            template<typename RandomAccessIterator, typename Projection>
+            static auto inplace_scatter(RandomAccessIterator begin, Projection projection,
+                                        PartitionInfo* partitions, void* sort_data)
+                -> void
+            {
+                auto&& proj = utility::as_function(projection);
+
+                std::uint8_t remaining_partitions[256];
+                int num_partitions = 0;
+                for (int i = 0 ; i < 256 ; ++i) {
+                    if (partitions[i].offset != partitions[i].next_offset) {
+                        remaining_partitions[num_partitions] = static_cast<std::uint8_t>(i);
+                        ++num_partitions;
+                    }
+                }
+
+                // Work on copies: the offsets must be preserved for the caller
+                PartitionInfo work_partitions[256];
+                for (int i = 0 ; i < 256 ; ++i) {
+                    work_partitions[i].offset = partitions[i].offset;
+                    work_partitions[i].next_offset = partitions[i].next_offset;
+                }
+
+                for (std::uint8_t *last_remaining = remaining_partitions + num_partitions,
+                                  *end_partition = remaining_partitions + 1 ;
+                     last_remaining > end_partition ;) {
+                    last_remaining = detail::partition(remaining_partitions, last_remaining,
+                                                        [&](std::uint8_t partition) {
+                        std::size_t& begin_offset = work_partitions[partition].offset;
+                        std::size_t& end_offset = work_partitions[partition].next_offset;
+                        if (begin_offset == end_offset) {
+                            return false;
+                        }
+
+                        unroll_loop_four_times(begin + begin_offset, end_offset - begin_offset,
+                                               [&](RandomAccessIterator it) {
+                            std::uint8_t this_partition = sequential_sorter::current_byte(proj(*it), sort_data);
+                            std::size_t offset = work_partitions[this_partition].offset++;
+                            using utility::iter_swap;
+                            iter_swap(it, begin + offset);
+                        });
+                        return begin_offset != end_offset;
+                    });
+                }
+            }
+        };
+
+        template<typename CurrentSubKey, std::size_t NumBytes>
+        struct ParallelUnsignedSorter<CurrentSubKey, NumBytes, NumBytes>
+        {
+            template<typename RandomAccessIterator, typename Projection, typename T>
+            static auto sort(work_stealing_pool&, std::size_t,
+                             RandomAccessIterator begin, RandomAccessIterator end,
+                             std::ptrdiff_t num_elements, Projection projection,
+                             next_sort_t<RandomAccessIterator, Projection> next_sort,
+                             void* next_sort_data, scatter_buffers<T>)
+                -> void
+            {
+                // The next sub-key is sorted sequentially
+                next_sort(std::move(begin), std::move(end), num_elements,
+                          std::move(projection), next_sort_data);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Parallel radix sort step for list sub-keys
+        //
+        // The common prefix is skipped sequentially like ska_sort
+        // does, then the elements are distributed in parallel
+        // according to the first character that differs
+
+        template<typename CurrentSubKey, typename ListType>
+        struct ParallelListSorter
+        {
+            using sequential_sorter = ListInplaceSorter<
+                std_sort_threshold, american_flag_sort_threshold,
+                CurrentSubKey, ListType
+            >;
+            using ElementSubKey = ListElementSubKey<CurrentSubKey, ListType>;
+
+            template<typename RandomAccessIterator, typename Projection, typename T>
+            static auto sort(work_stealing_pool& pool, std::size_t worker,
+                             RandomAccessIterator begin, RandomAccessIterator end,
+                             std::ptrdiff_t num_elements, Projection projection,
+                             next_sort_t<RandomAccessIterator, Projection> next_sort,
+                             void* next_sort_data, scatter_buffers<T> buffers)
+                -> void
+            {
+                if (num_elements < parallel_threshold) {
+                    sequential_sorter::sort(std::move(begin), std::move(end), num_elements,
+                                            std::move(projection), next_sort, next_sort_data);
+                    return;
+                }
+
+                auto&& proj = utility::as_function(projection);
+
+                // Lives until every subtask is done since we wait for them
+                ListSortData<RandomAccessIterator, Projection> sort_data;
+                sort_data.current_index = 0;
+                sort_data.recursion_limit = 16;
+                sort_data.next_sort = next_sort;
+                sort_data.next_sort_data = next_sort_data;
+
+                auto current_key = [&](auto&& elem) -> decltype(auto) {
+                    return CurrentSubKey::sub_key(proj(elem), next_sort_data);
+                };
+                auto element_key = [&](auto&& elem) -> decltype(auto) {
+                    return ElementSubKey::base::sub_key(elem, &sort_data);
+                };
+                std::size_t current_index = CommonPrefix(begin, end, 0, current_key, element_key);
+                sort_data.current_index = current_index;
+                auto end_of_shorter_ones = detail::partition(begin, end, [&](auto&& elem) {
+                    return current_key(elem).size() <= current_index;
+                });
+
+                std::atomic<std::size_t> latch(0);
+                auto wait_tasks = make_scope_exit([&] {
+                    pool.wait(worker, latch);
+                });
+                std::ptrdiff_t num_shorter_ones = end_of_shorter_ones - begin;
+                if (next_sort && num_shorter_ones > 1) {
+                    pool.push(worker, [=](std::size_t) {
+                        if (not StdSortIfLessThanThreshold<std_sort_threshold>(
+                                begin, end_of_shorter_ones, num_shorter_ones, projection)) {
+                            next_sort(begin, end_of_shorter_ones, num_shorter_ones,
+                                      projection, next_sort_data);
+                        }
+                    }, latch);
+                }
+
+                std::ptrdiff_t num_longer_ones = end - end_of_shorter_ones;
+                if (not StdSortIfLessThanThreshold<std_sort_threshold>(end_of_shorter_ones, end,
+                                                                       num_longer_ones, projection)) {
+                    using SortType = next_sort_t<RandomAccessIterator, Projection>;
+                    SortType sort_next_element = static_cast<SortType>(&sequential_sorter::sort_from_recursion);
+                    ParallelInplaceSorter<ElementSubKey>::sort(
+                        pool, worker, end_of_shorter_ones, end, num_longer_ones, projection,
+                        sort_next_element, &sort_data, buffers.offset(num_shorter_ones)
+                    );
+                }
+                pool.wait(worker, latch);
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Dispatch on the type of the sub-key
+
+        // Fallback: sequential algorithm
+        template<typename CurrentSubKey, typename SubKeyType, typename Enable>
+        struct ParallelInplaceSorter
+        {
+            template<typename RandomAccessIterator, typename Projection, typename T>
+            static auto sort(work_stealing_pool&, std::size_t,
+                             RandomAccessIterator begin, RandomAccessIterator end,
+                             std::ptrdiff_t num_elements, Projection projection,
+                             next_sort_t<RandomAccessIterator, Projection> next_sort,
+                             void* sort_data, scatter_buffers<T>)
+                -> void
+            {
+                InplaceSorter<std_sort_threshold, american_flag_sort_threshold, CurrentSubKey>::sort(
+                    std::move(begin), std::move(end), num_elements,
+                    std::move(projection), next_sort, sort_data);
+            }
+        };
+
+        template<typename CurrentSubKey>
+        struct ParallelInplaceSorter<CurrentSubKey, std::uint8_t>:
+            ParallelUnsignedSorter<CurrentSubKey, 1>
+        {};
+
+        template<typename CurrentSubKey>
+        struct ParallelInplaceSorter<CurrentSubKey, std::uint16_t>:
+            ParallelUnsignedSorter<CurrentSubKey, 2>
+        {};
+
+        template<typename CurrentSubKey>
+        struct ParallelInplaceSorter<CurrentSubKey, std::uint32_t>:
+            ParallelUnsignedSorter<CurrentSubKey, 4>
+        {};
+
+        template<typename CurrentSubKey>
+        struct ParallelInplaceSorter<CurrentSubKey, std::uint64_t>:
+            ParallelUnsignedSorter<CurrentSubKey, 8>
+        {};
+
+#ifdef __SIZEOF_INT128__
+        template<typename CurrentSubKey>
+        struct ParallelInplaceSorter<CurrentSubKey, __uint128_t>:
+            ParallelUnsignedSorter<CurrentSubKey, 16>
+        {};
+#endif
+
+        template<typename CurrentSubKey, typename SubKeyType>
+        struct ParallelInplaceSorter<
+            CurrentSubKey, SubKeyType,
+            detail::enable_if_t<not std::is_same<void, decltype(std::declval<SubKeyType>()[0])>::value>
+        >:
+            ParallelListSorter<CurrentSubKey, SubKeyType>
+        {};
+    }
+
+    template<typename RandomAccessIterator, typename Projection>
+    auto parallel_ska_sort(RandomAccessIterator begin, RandomAccessIterator end,
+                           Projection projection, std::size_t max_threads)
+        -> void
+    {
+        using namespace parallel_ska_sort_detail;
+        using value_type = value_type_t<RandomAccessIterator>;
+        using CurrentSubKey = SubKey<projected_t<RandomAccessIterator, Projection>>;
+
+        std::ptrdiff_t size = end - begin;
+        auto workers = parallel_workers_count(static_cast<std::size_t>(size),
+                                              static_cast<std::size_t>(parallel_threshold),
+                                              max_threads);
+        if (workers < 2) {
+            ska_sort(std::move(begin), std::move(end), std::move(projection));
+            return;
+        }
+
+        // Try to allocate the memory needed for the cooperative scatter,
+        // fall back to the in-place scatter if it isn't available; since
+        // elements are moved to the buffer without any safety net, this
+        // is only done when moving elements can't throw
+        temporary_buffer<value_type> elements_buffer(nullptr);
+        temporary_buffer<std::uint8_t> digits_buffer(nullptr);
+        if (std::is_nothrow_move_constructible<value_type>::value &&
+            std::is_nothrow_move_assignable<value_type>::value) {
+            elements_buffer.try_grow(size);
+            if (elements_buffer.size() == size) {
+                digits_buffer.try_grow(size);
+            }
+        }
+        scatter_buffers<value_type> buffers = { nullptr, nullptr };
+        if (digits_buffer.size() == size) {
+            buffers = { elements_buffer.data(), digits_buffer.data() };
+        }
+
+        using SortType = next_sort_t<RandomAccessIterator, Projection>;
+        SortType next_sort = static_cast<SortType>(&SortStarter<std_sort_threshold,
+                                                                american_flag_sort_threshold,
+                                                                typename CurrentSubKey::next>::sort);
+        if (next_sort == static_cast<SortType>(&SortStarter<std_sort_threshold, american_flag_sort_threshold, SubKey<void>>::sort)) {
+            next_sort = nullptr;
+        }
+
+        work_stealing_pool pool(workers);
+        pool.run([&](std::size_t worker) {
+            ParallelInplaceSorter<CurrentSubKey>::sort(pool, worker, begin, end, size,
+                                                       projection, next_sort, nullptr, buffers);
+        });
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARALLEL_SKA_SORT_H_
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_PARTIAL_SORT_H_
+#define CPPSORT_DETAIL_PARTIAL_SORT_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <utility>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/iter_move.h>
+#include "heapsort.h"
+#include "iterator_traits.h"
+#include "nth_element.h"
+#include "pdqsort.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Heap select
+    //
+    // Keeps the smallest elements seen so far in a max-heap: most
+    // of the elements are rejected after a single comparison with
+    // the root of the heap, which makes it cheaper than quickselect
+    // when the number of elements to select is small compared to
+    // the size of the collection
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto heap_select(RandomAccessIterator first, RandomAccessIterator middle,
+                     RandomAccessIterator last,
+                     Compare compare, Projection projection)
+        -> void
+    {
+        using utility::iter_swap;
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        auto len = middle - first;
+        detail::make_heap(first, middle, compare, projection);
+        for (auto it = middle ; it != last ; ++it) {
+            if (comp(proj(*it), proj(*first))) {
+                iter_swap(it, first);
+                detail::sift_down(first, middle, compare, projection, len, first);
+            }
+        }
+        detail::sort_heap(std::move(first), std::move(middle),
+                          std::move(compare), std::move(projection));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // partial_sort
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto partial_sort(RandomAccessIterator first, RandomAccessIterator middle,
+                      RandomAccessIterator last,
+                      Compare compare, Projection projection)
+        -> void
+    {
+        auto size = last - first;
+        auto len = middle - first;
+        if (len == 0) {
+            return;
+        }
+        if (len == size) {
+            pdqsort(std::move(first), std::move(last),
+                    std::move(compare), std::move(projection));
+            return;
+        }
+
+        if (len <= size / 64) {
+            heap_select(std::move(first), std::move(middle), std::move(last),
+                        std::move(compare), std::move(projection));
+        } else {
+            // Put the greatest element to sort in place, everything
+            // before it is then the elements to sort
+            detail::nth_element(first, last, len - 1, size, compare, projection);
+            pdqsort(std::move(first), std::move(middle),
+                    std::move(compare), std::move(projection));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // partial_sort_copy
+
+    // [result_first, result_last) holds copies of the first elements
+    // of the input, and [first, last) the rest of the input: the
+    // smallest elements of both are kept in the result, then sorted
+    template<typename InputIterator, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto heap_select_copy(InputIterator first, InputIterator last,
+                          RandomAccessIterator result_first, RandomAccessIterator result_last,
+                          Compare compare, Projection projection)
+        -> void
+    {
+        auto&& comp = utility::as_function(compare);
+        auto&& proj = utility::as_function(projection);
+
+        // Replace the greatest element of the result with every
+        // smaller element from the rest of the input
+        auto len = result_last - result_first;
+        detail::make_heap(result_first, result_last, compare, projection);
+        if (len > 0) {
+            for (; first != last ; ++first) {
+                if (comp(proj(*first), proj(*result_first))) {
+                    *result_first = *first;
+                    detail::sift_down(result_first, result_last, compare, projection,
+                                      len, result_first);
+                }
+            }
+        }
+        detail::sort_heap(std::move(result_first), std::move(result_last),
+                          std::move(compare), std::move(projection));
+    }
+
+    template<typename InputIterator, typename RandomAccessIterator,
+             typename Compare, typename Projection>
+    auto partial_sort_copy(InputIterator first, InputIterator last,
+                           RandomAccessIterator result_first, RandomAccessIterator result_last,
+                           Compare compare, Projection projection)
+        -> RandomAccessIterator
+    {
+        auto result_middle = result_first;
+        for (; first != last && result_middle != result_last ; ++first, (void) ++result_middle) {
+            *result_middle = *first;
+        }
+        detail::heap_select_copy(std::move(first), std::move(last),
+                                 result_first, result_middle,
+                                 std::move(compare), std::move(projection));
+        return result_middle;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_PARTIAL_SORT_H_
@@ -32,15 +32,19 @@
 #include <algorithm>
 #include <cstddef>
 #include <iterator>
+#include <type_traits>
 #include <utility>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/branchless_traits.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "algorithm_events.h"
 #include "bitops.h"
 #include "heapsort.h"
 #include "insertion_sort.h"
 #include "iterator_traits.h"
 #include "iter_sort3.h"
+#include "scope_exit.h"
+#include "simd_partition.h"
 
 #ifdef __MINGW32__
 #   include <cstdint> // std::uintptr_t
@@ -90,12 +94,15 @@ namespace detail
                 if (comp(proj(*sift), proj(*sift_1))) {
                     auto tmp = iter_move(sift);
                     auto&& tmp_proj = proj(tmp);
+                    // Fill the hole if a comparison throws
+                    auto fill_hole = make_scope_exit([&] { *sift = std::move(tmp); });
 
                     do {
                         *sift = iter_move(sift_1);
                         --sift;
                     } while (comp(tmp_proj, proj(*--sift_1)));
 
+                    fill_hole.deactivate();
                     *sift = std::move(tmp);
                 }
             }
@@ -124,11 +131,14 @@ namespace detail
                 if (comp(proj(*sift), proj(*sift_1))) {
                     auto tmp = iter_move(sift);
                     auto&& tmp_proj = proj(tmp);
+                    // Fill the hole if a comparison throws
+                    auto fill_hole = make_scope_exit([&] { *sift = std::move(tmp); });
 
                     do {
                         *sift = iter_move(sift_1);
                     } while (--sift != begin && comp(tmp_proj, proj(*--sift_1)));
 
+                    fill_hole.deactivate();
                     *sift = std::move(tmp);
                     limit += cur - sift;
                 }
@@ -202,6 +212,8 @@ namespace detail
             // Move pivot into local for speed.
             auto pivot = iter_move(begin);
             auto&& pivot_proj = proj(pivot);
+            // Put the pivot back if a comparison throws
+            auto restore_pivot = make_scope_exit([&] { *begin = std::move(pivot); });
 
             RandomAccessIterator first = begin;
             RandomAccessIterator last = end;
@@ -328,6 +340,7 @@ namespace detail
 
             // Put the pivot in the right place.
             auto pivot_pos = first - 1;
+            restore_pivot.deactivate();
             *begin = iter_move(pivot_pos);
             *pivot_pos = std::move(pivot);
 
@@ -352,6 +365,8 @@ namespace detail
             // Move pivot into local for speed.
             auto pivot = iter_move(begin);
             auto&& pivot_proj = proj(pivot);
+            // Put the pivot back if a comparison throws
+            auto restore_pivot = make_scope_exit([&] { *begin = std::move(pivot); });
 
             RandomAccessIterator first = begin;
             RandomAccessIterator last = end;
@@ -380,6 +395,7 @@ namespace detail
 
             // Put the pivot in the right place.
             RandomAccessIterator pivot_pos = first - 1;
+            restore_pivot.deactivate();
             *begin = iter_move(pivot_pos);
             *pivot_pos = std::move(pivot);
 
@@ -400,6 +416,8 @@ namespace detail
 
             auto pivot = iter_move(begin);
             auto&& pivot_proj = proj(pivot);
+            // Put the pivot back if a comparison throws
+            auto restore_pivot = make_scope_exit([&] { *begin = std::move(pivot); });
             RandomAccessIterator first = begin;
             RandomAccessIterator last = end;
 
@@ -415,28 +433,109 @@ namespace detail
             }
 
             RandomAccessIterator pivot_pos = last;
+            restore_pivot.deactivate();
             *begin = iter_move(pivot_pos);
             *pivot_pos = std::move(pivot);
 
             return pivot_pos;
         }
 
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_dispatch(std::integral_constant<int, 2>,
+                                      RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            return simd_partition_right(std::move(begin), std::move(end), std::move(compare));
+        }
 
         template<typename RandomAccessIterator, typename Compare, typename Projection>
-        auto pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end,
-                          Compare compare, Projection projection,
-                          int bad_allowed, bool leftmost=true)
-            -> void
+        auto partition_right_dispatch(std::integral_constant<int, 1>,
+                                      RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection projection)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            return partition_right_branchless(std::move(begin), std::move(end),
+                                              std::move(compare), std::move(projection));
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_dispatch(std::integral_constant<int, 0>,
+                                      RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection projection)
+            -> std::pair<RandomAccessIterator, bool>
+        {
+            return partition_right(std::move(begin), std::move(end),
+                                   std::move(compare), std::move(projection));
+        }
+
+        // Picks the fastest partitioning algorithm for the given types: the
+        // vectorized one for contiguous arithmetic types when the
+        // instruction set allows it, then the branchless one when the
+        // comparison and projection are likely branchless
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto partition_right_dispatch(RandomAccessIterator begin, RandomAccessIterator end,
+                                      Compare compare, Projection projection)
+            -> std::pair<RandomAccessIterator, bool>
         {
-            using utility::iter_swap;
-            using difference_type = difference_type_t<RandomAccessIterator>;
             using value_type = value_type_t<RandomAccessIterator>;
             using projected_type = projected_t<RandomAccessIterator, Projection>;
 
+            constexpr bool can_simd = can_simd_partition_v<RandomAccessIterator, Compare, Projection>;
             constexpr bool is_branchless =
                 utility::is_probably_branchless_comparison_v<Compare, projected_type> &&
                 utility::is_probably_branchless_projection_v<Projection, value_type>;
-            (void)is_branchless; // Silence a -Wunused-but-set-variable false positive
+
+            using category = std::integral_constant<int, can_simd ? 2 : (is_branchless ? 1 : 0)>;
+            return partition_right_dispatch(category{}, std::move(begin), std::move(end),
+                                            std::move(compare), std::move(projection));
+        }
+
+        // Swaps a few elements of both partitions around after a highly unbalanced partition in
+        // order to break many patterns that could lead to further unbalanced partitions.
+        template<typename RandomAccessIterator>
+        auto break_patterns(RandomAccessIterator begin, RandomAccessIterator pivot_pos,
+                            RandomAccessIterator end)
+            -> void
+        {
+            using utility::iter_swap;
+
+            auto l_size = pivot_pos - begin;
+            auto r_size = end - (pivot_pos + 1);
+
+            if (l_size >= insertion_sort_threshold) {
+                iter_swap(begin,             begin + l_size / 4);
+                iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                if (l_size > ninther_threshold) {
+                    iter_swap(begin + 1,         begin + (l_size / 4 + 1));
+                    iter_swap(begin + 2,         begin + (l_size / 4 + 2));
+                    iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if (r_size >= insertion_sort_threshold) {
+                iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                iter_swap(end - 1,                   end - r_size / 4);
+
+                if (r_size > ninther_threshold) {
+                    iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    iter_swap(end - 2,             end - (1 + r_size / 4));
+                    iter_swap(end - 3,             end - (2 + r_size / 4));
+                }
+            }
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto pdqsort_loop(RandomAccessIterator begin, RandomAccessIterator end,
+                          Compare compare, Projection projection,
+                          int bad_allowed, bool leftmost=true)
+            -> void
+        {
+            using utility::iter_swap;
+            using difference_type = difference_type_t<RandomAccessIterator>;
 
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
@@ -473,14 +572,15 @@ namespace detail
                 // the left partition, greater elements in the right partition. We do not have to
                 // recurse on the left partition, since it's sorted (all equal).
                 if (!leftmost && !comp(proj(*(begin - 1)), proj(*begin))) {
+                    CPPSORT_ALGORITHM_EVENT(partitions);
                     begin = partition_left(begin, end, compare, projection) + 1;
                     continue;
                 }
 
                 // Partition and get results.
-                std::pair<RandomAccessIterator, bool> part_result = is_branchless ?
-                    partition_right_branchless(begin, end, compare, projection) :
-                    partition_right(begin, end, compare, projection);
+                std::pair<RandomAccessIterator, bool> part_result =
+                    partition_right_dispatch(begin, end, compare, projection);
+                CPPSORT_ALGORITHM_EVENT(partitions);
                 RandomAccessIterator pivot_pos = part_result.first;
                 bool already_partitioned = part_result.second;
 
@@ -491,36 +591,16 @@ namespace detail
 
                 // If we got a highly unbalanced partition we shuffle elements to break many patterns.
                 if (highly_unbalanced) {
+                    CPPSORT_ALGORITHM_EVENT(unbalanced_partitions);
                     // If we had too many bad partitions, switch to heapsort to guarantee O(n log n).
                     if (--bad_allowed == 0) {
+                        CPPSORT_ALGORITHM_EVENT(heapsort_fallbacks);
                         heapsort(std::move(begin), std::move(end),
                                  std::move(compare), std::move(projection));
                         return;
                     }
 
-                    if (l_size >= insertion_sort_threshold) {
-                        iter_swap(begin,             begin + l_size / 4);
-                        iter_swap(pivot_pos - 1, pivot_pos - l_size / 4);
-
-                        if (l_size > ninther_threshold) {
-                            iter_swap(begin + 1,         begin + (l_size / 4 + 1));
-                            iter_swap(begin + 2,         begin + (l_size / 4 + 2));
-                            iter_swap(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
-                            iter_swap(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
-                        }
-                    }
-
-                    if (r_size >= insertion_sort_threshold) {
-                        iter_swap(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
-                        iter_swap(end - 1,                   end - r_size / 4);
-
-                        if (r_size > ninther_threshold) {
-                            iter_swap(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
-                            iter_swap(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
-                            iter_swap(end - 2,             end - (1 + r_size / 4));
-                            iter_swap(end - 3,             end - (2 + r_size / 4));
-                        }
-                    }
+                    break_patterns(begin, pivot_pos, end);
                 } else {
                     // If we were decently balanced and we tried to sort an already partitioned
                     // sequence try to use insertion sort.
@@ -11,12 +11,12 @@
 #include <iterator>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
 #include "bitops.h"
 #include "insertion_sort.h"
 #include "iterator_traits.h"
+#include "memory.h"
 
 namespace cppsort
 {
@@ -87,7 +87,7 @@ namespace detail
     }
 
     template<typename RandomAccessIterator, typename Compare, typename Projection>
-    auto relocate(const std::vector<poplar<RandomAccessIterator>>& poplars,
+    auto relocate(const scratch_vector<poplar<RandomAccessIterator>>& poplars,
                   Compare compare, Projection projection)
         -> void
     {
@@ -144,7 +144,7 @@ namespace detail
         poplar_size_t size = last - first;
         if (size < 2) return;
 
-        std::vector<poplar<RandomAccessIterator>> poplars;
+        scratch_vector<poplar<RandomAccessIterator>> poplars;
         // Harvey & Zatloukal, The Post-Order Heap:
         // [...] the number of trees, k, is at most floor(lg(n + 1)) + 1
         poplars.reserve(log2(size + 1) + 1);
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SAMPLING_H_
+#define CPPSORT_DETAIL_SAMPLING_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <cpp-sort/probes/estimate.h>
+#include "iterator_traits.h"
+#include "memory.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Uniform sample of positions
+    //
+    // Returns iterators to a uniformly chosen subset of at most
+    // sample_size positions of [first, first + size), in the
+    // order they appear in the collection. The positions are
+    // drawn with replacement then deduplicated, which still
+    // gives a uniform subset of the size that remains. When the
+    // sample is at least as big as the collection, it contains
+    // every position, which callers use to compute exact results.
+
+    template<typename ForwardIterator, typename URBG>
+    auto sample_iterators(ForwardIterator first, difference_type_t<ForwardIterator> size,
+                          std::size_t sample_size, URBG& engine)
+        -> scratch_vector<ForwardIterator>
+    {
+        using difference_type = difference_type_t<ForwardIterator>;
+
+        scratch_vector<ForwardIterator> res;
+        if (size <= 0) {
+            return res;
+        }
+
+        if (sample_size >= static_cast<std::size_t>(size)) {
+            res.reserve(static_cast<std::size_t>(size));
+            for (difference_type idx = 0 ; idx < size ; ++idx) {
+                res.push_back(first);
+                ++first;
+            }
+            return res;
+        }
+
+        std::uniform_int_distribution<std::uint64_t> dist(0, static_cast<std::uint64_t>(size - 1));
+        scratch_vector<std::uint64_t> positions(sample_size);
+        for (auto& pos: positions) {
+            pos = dist(engine);
+        }
+        std::sort(positions.begin(), positions.end());
+        positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+        // Walk the collection once, this is O(sample_size) for
+        // random-access iterators and O(size) otherwise
+        res.reserve(positions.size());
+        std::uint64_t current = 0;
+        for (auto pos: positions) {
+            std::advance(first, static_cast<difference_type>(pos - current));
+            current = pos;
+            res.push_back(first);
+        }
+        return res;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Confidence bounds
+
+    // Deviation t such that the mean of samples independent
+    // variables in [0, 1] exceeds its expected value by more
+    // than t with a probability of at most failure (Hoeffding)
+    inline auto hoeffding_deviation(double samples, double failure)
+        -> double
+    {
+        if (samples < 1.0) {
+            return 1.0;
+        }
+        return std::sqrt(std::log(1.0 / failure) / (2.0 * samples));
+    }
+
+    // Number of samples needed for hoeffding_deviation to
+    // return at most epsilon
+    inline auto hoeffding_samples(double epsilon, double failure)
+        -> std::size_t
+    {
+        return static_cast<std::size_t>(
+            std::ceil(std::log(1.0 / failure) / (2.0 * epsilon * epsilon))
+        );
+    }
+
+    // Turn ratios of the greatest possible value of a measure
+    // into an estimate of that measure, clamped to [0, max]
+    template<typename Integer>
+    auto make_estimate(double value, double lower, double upper, Integer max)
+        -> probe::estimate<Integer>
+    {
+        auto to_integer = [max](double ratio) {
+            auto res = std::round(ratio * static_cast<double>(max));
+            if (res <= 0.0) {
+                return static_cast<Integer>(0);
+            }
+            if (res >= static_cast<double>(max)) {
+                return max;
+            }
+            return static_cast<Integer>(res);
+        };
+        return { to_integer(value), to_integer(lower), to_integer(upper) };
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SAMPLING_H_
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_H_
+#define CPPSORT_DETAIL_SIMD_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include "type_traits.h"
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#   include <immintrin.h>
+#endif
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Common tools for the vectorized algorithms
+    //
+    // The vectorized algorithms are selected at compile time
+    // depending on the available instruction sets, and only
+    // handle a few arithmetic types compared with std::less or
+    // std::greater without projection
+
+    // Key type used for a given value type: integers are mapped
+    // to the fixed-size integer of the same size and signedness
+    template<typename T, typename=void>
+    struct simd_key
+    {
+        using type = void;
+    };
+
+    template<typename T>
+    struct simd_key<T, enable_if_t<std::is_integral<T>::value && not std::is_same<T, bool>::value>>
+    {
+        using type = conditional_t<
+            sizeof(T) == 4,
+            conditional_t<std::is_signed<T>::value, std::int32_t, std::uint32_t>,
+            conditional_t<sizeof(T) == 8 && std::is_signed<T>::value, std::int64_t, void>
+        >;
+    };
+
+    template<>
+    struct simd_key<float> { using type = float; };
+
+    template<>
+    struct simd_key<double> { using type = double; };
+
+    template<typename T>
+    using simd_key_t = typename simd_key<T>::type;
+
+    template<typename Compare, typename T>
+    struct is_simd_compare:
+        std::integral_constant<bool,
+            std::is_same<Compare, std::less<>>::value ||
+            std::is_same<Compare, std::less<T>>::value ||
+            std::is_same<Compare, std::greater<>>::value ||
+            std::is_same<Compare, std::greater<T>>::value
+        >
+    {};
+
+    template<typename Compare, typename T>
+    struct is_simd_descending_compare:
+        std::integral_constant<bool,
+            std::is_same<Compare, std::greater<>>::value ||
+            std::is_same<Compare, std::greater<T>>::value
+        >
+    {};
+
+    // Iterators known to point to contiguous memory
+    template<typename Iterator, typename T>
+    struct is_simd_contiguous_iterator:
+        std::integral_constant<bool,
+            std::is_same<Iterator, T*>::value ||
+            std::is_same<Iterator, typename std::vector<T>::iterator>::value
+        >
+    {};
+
+    inline auto simd_popcount(unsigned mask) noexcept
+        -> unsigned
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_popcount(mask));
+#else
+        unsigned res = 0;
+        for (; mask != 0 ; mask &= mask - 1) {
+            ++res;
+        }
+        return res;
+#endif
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_H_
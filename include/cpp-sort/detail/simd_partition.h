@@ -0,0 +1,537 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_PARTITION_H_
+#define CPPSORT_DETAIL_SIMD_PARTITION_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Vectorized partitioning
+    //
+    // Partitions contiguous arrays of arithmetic types around a
+    // pivot one vector at a time, in the style of vqsort: every
+    // vector is classified with a single comparison, then the
+    // elements going to the left are written contiguously at
+    // the left write position and the other ones at the right
+    // write position. AVX-512 provides compress-store
+    // instructions for that purpose, while AVX2 emulates them
+    // with a lane permutation read from a table.
+    //
+    // Keeping one vector of free space on each side of the
+    // array before the loop makes it possible to write the
+    // elements back in place: reading from the side with the
+    // less free space guarantees that there is always enough
+    // room for the writes of the other side.
+
+    // Lane traits, specialized for every supported type below
+    template<typename T>
+    struct simd_partition_traits
+    {
+        static constexpr bool is_available = false;
+    };
+
+    template<typename T>
+    constexpr bool has_simd_partition_traits_v = simd_partition_traits<simd_key_t<T>>::is_available;
+
+    // Whether a collection can be partitioned with the vectorized
+    // algorithm: the elements have to be contiguous, and their
+    // type has to be exactly the type handled by the kernels so
+    // that the memory can be accessed in place
+    template<typename RandomAccessIterator, typename Compare, typename Projection,
+             typename T = value_type_t<RandomAccessIterator>>
+    constexpr bool can_simd_partition_v =
+        is_simd_contiguous_iterator<RandomAccessIterator, T>::value &&
+        std::is_same<T, simd_key_t<T>>::value &&
+        std::is_same<Projection, utility::identity>::value &&
+        is_simd_compare<Compare, T>::value &&
+        has_simd_partition_traits_v<T>;
+
+#if defined(__AVX512F__)
+
+    ////////////////////////////////////////////////////////////
+    // AVX-512 kernels
+
+    template<>
+    struct simd_partition_traits<std::int32_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 16;
+        using vector_type = __m512i;
+
+        static auto load(const std::int32_t* ptr) noexcept -> vector_type { return _mm512_loadu_si512(ptr); }
+        static auto broadcast(std::int32_t value) noexcept -> vector_type { return _mm512_set1_epi32(value); }
+
+        // Bits set for the lanes where lhs < rhs
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epi32_mask(lhs, rhs);
+        }
+
+        static auto compress_store(std::int32_t* ptr, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            _mm512_mask_compressstoreu_epi32(ptr, static_cast<__mmask16>(mask), vec);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<std::uint32_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 16;
+        using vector_type = __m512i;
+
+        static auto load(const std::uint32_t* ptr) noexcept -> vector_type { return _mm512_loadu_si512(ptr); }
+        static auto broadcast(std::uint32_t value) noexcept -> vector_type { return _mm512_set1_epi32(static_cast<int>(value)); }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epu32_mask(lhs, rhs);
+        }
+
+        static auto compress_store(std::uint32_t* ptr, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            _mm512_mask_compressstoreu_epi32(ptr, static_cast<__mmask16>(mask), vec);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<std::int64_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m512i;
+
+        static auto load(const std::int64_t* ptr) noexcept -> vector_type { return _mm512_loadu_si512(ptr); }
+        static auto broadcast(std::int64_t value) noexcept -> vector_type { return _mm512_set1_epi64(value); }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return _mm512_cmplt_epi64_mask(lhs, rhs);
+        }
+
+        static auto compress_store(std::int64_t* ptr, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            _mm512_mask_compressstoreu_epi64(ptr, static_cast<__mmask8>(mask), vec);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<float>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 16;
+        using vector_type = __m512;
+
+        static auto load(const float* ptr) noexcept -> vector_type { return _mm512_loadu_ps(ptr); }
+        static auto broadcast(float value) noexcept -> vector_type { return _mm512_set1_ps(value); }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return _mm512_cmp_ps_mask(lhs, rhs, _CMP_LT_OQ);
+        }
+
+        static auto compress_store(float* ptr, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            _mm512_mask_compressstoreu_ps(ptr, static_cast<__mmask16>(mask), vec);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<double>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m512d;
+
+        static auto load(const double* ptr) noexcept -> vector_type { return _mm512_loadu_pd(ptr); }
+        static auto broadcast(double value) noexcept -> vector_type { return _mm512_set1_pd(value); }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return _mm512_cmp_pd_mask(lhs, rhs, _CMP_LT_OQ);
+        }
+
+        static auto compress_store(double* ptr, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            _mm512_mask_compressstoreu_pd(ptr, static_cast<__mmask8>(mask), vec);
+        }
+    };
+
+    template<typename Traits, typename T>
+    auto simd_partition_store(typename Traits::vector_type vec, unsigned mask,
+                              T*& write_left, T*& write_right) noexcept
+        -> void
+    {
+        constexpr unsigned full_mask = (1u << Traits::lanes) - 1u;
+        auto left_count = simd_popcount(mask);
+        Traits::compress_store(write_left, mask, vec);
+        write_left += left_count;
+        write_right -= Traits::lanes - left_count;
+        Traits::compress_store(write_right, ~mask & full_mask, vec);
+    }
+
+#elif defined(__AVX2__)
+
+    ////////////////////////////////////////////////////////////
+    // AVX2 kernels
+
+    // For every mask of 8 lanes, permutation moving the lanes
+    // whose bit is set first, then the other ones, preserving
+    // their relative order; the lane indices are packed on
+    // 3 bits each
+    struct avx2_partition_table
+    {
+        std::uint32_t values[256];
+    };
+
+    constexpr auto make_avx2_partition_table() noexcept
+        -> avx2_partition_table
+    {
+        avx2_partition_table table = {};
+        for (unsigned mask = 0 ; mask < 256 ; ++mask) {
+            std::uint32_t packed = 0;
+            unsigned pos = 0;
+            for (unsigned lane = 0 ; lane < 8 ; ++lane) {
+                if (mask & (1u << lane)) {
+                    packed |= lane << (3 * pos++);
+                }
+            }
+            for (unsigned lane = 0 ; lane < 8 ; ++lane) {
+                if (not (mask & (1u << lane))) {
+                    packed |= lane << (3 * pos++);
+                }
+            }
+            table.values[mask] = packed;
+        }
+        return table;
+    }
+
+    inline auto avx2_partition_indices(unsigned mask) noexcept
+        -> __m256i
+    {
+        static constexpr avx2_partition_table table = make_avx2_partition_table();
+        // permutevar8x32 only reads the 3 lowest bits of every index
+        return _mm256_srlv_epi32(
+            _mm256_set1_epi32(static_cast<int>(table.values[mask])),
+            _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21)
+        );
+    }
+
+    // Duplicates every bit of a mask of 64-bit lanes to get
+    // the corresponding mask of 32-bit lanes
+    inline auto avx2_widen_mask(unsigned mask) noexcept
+        -> unsigned
+    {
+        unsigned res = 0;
+        for (unsigned lane = 0 ; lane < 4 ; ++lane) {
+            if (mask & (1u << lane)) {
+                res |= 3u << (2 * lane);
+            }
+        }
+        return res;
+    }
+
+    template<typename Integer>
+    struct avx2_epi32_partition_traits
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m256i;
+
+        static auto load(const Integer* ptr) noexcept
+            -> vector_type
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+
+        static auto broadcast(Integer value) noexcept
+            -> vector_type
+        {
+            return _mm256_set1_epi32(static_cast<int>(value));
+        }
+
+        static auto permute_store(Integer* left, Integer* right, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            auto res = _mm256_permutevar8x32_epi32(vec, avx2_partition_indices(mask));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left), res);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right), res);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<std::int32_t>:
+        avx2_epi32_partition_traits<std::int32_t>
+    {
+        // Bits set for the lanes where lhs < rhs
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            auto res = _mm256_cmpgt_epi32(rhs, lhs);
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(res)));
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<std::uint32_t>:
+        avx2_epi32_partition_traits<std::uint32_t>
+    {
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            // There is no unsigned comparison in AVX2, flip the sign
+            // bits and use the signed one
+            auto sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+            auto res = _mm256_cmpgt_epi32(_mm256_xor_si256(rhs, sign), _mm256_xor_si256(lhs, sign));
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(res)));
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<std::int64_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 4;
+        using vector_type = __m256i;
+
+        static auto load(const std::int64_t* ptr) noexcept
+            -> vector_type
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+
+        static auto broadcast(std::int64_t value) noexcept
+            -> vector_type
+        {
+            return _mm256_set1_epi64x(static_cast<long long>(value));
+        }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            auto res = _mm256_cmpgt_epi64(rhs, lhs);
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(res)));
+        }
+
+        static auto permute_store(std::int64_t* left, std::int64_t* right,
+                                  unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            auto res = _mm256_permutevar8x32_epi32(vec, avx2_partition_indices(avx2_widen_mask(mask)));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(left), res);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(right), res);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<float>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m256;
+
+        static auto load(const float* ptr) noexcept -> vector_type { return _mm256_loadu_ps(ptr); }
+        static auto broadcast(float value) noexcept -> vector_type { return _mm256_set1_ps(value); }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ)));
+        }
+
+        static auto permute_store(float* left, float* right, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            auto res = _mm256_permutevar8x32_ps(vec, avx2_partition_indices(mask));
+            _mm256_storeu_ps(left, res);
+            _mm256_storeu_ps(right, res);
+        }
+    };
+
+    template<>
+    struct simd_partition_traits<double>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 4;
+        using vector_type = __m256d;
+
+        static auto load(const double* ptr) noexcept -> vector_type { return _mm256_loadu_pd(ptr); }
+        static auto broadcast(double value) noexcept -> vector_type { return _mm256_set1_pd(value); }
+
+        static auto less_mask(vector_type lhs, vector_type rhs) noexcept
+            -> unsigned
+        {
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_LT_OQ)));
+        }
+
+        static auto permute_store(double* left, double* right, unsigned mask, vector_type vec) noexcept
+            -> void
+        {
+            auto indices = avx2_partition_indices(avx2_widen_mask(mask));
+            auto res = _mm256_permutevar8x32_ps(_mm256_castpd_ps(vec), indices);
+            _mm256_storeu_pd(left, _mm256_castps_pd(res));
+            _mm256_storeu_pd(right, _mm256_castps_pd(res));
+        }
+    };
+
+    template<typename Traits, typename T>
+    auto simd_partition_store(typename Traits::vector_type vec, unsigned mask,
+                              T*& write_left, T*& write_right) noexcept
+        -> void
+    {
+        // Both stores write a full vector: the elements going to the
+        // left are at the beginning of the permuted vector and the
+        // ones going to the right at its end, the rest is overwritten
+        // by the next stores
+        auto left_count = simd_popcount(mask);
+        Traits::permute_store(write_left, write_right - Traits::lanes, mask, vec);
+        write_left += left_count;
+        write_right -= Traits::lanes - left_count;
+    }
+
+#endif
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+
+    ////////////////////////////////////////////////////////////
+    // Partitioning algorithm
+
+    // Partitions [first, last) so that the elements x for which
+    // x < pivot (or pivot < x when Descending is true) come first,
+    // returns the partition point
+    template<bool Descending, typename T>
+    auto simd_partition(T* first, T* last, T pivot) noexcept
+        -> T*
+    {
+        using traits = simd_partition_traits<T>;
+        constexpr std::size_t lanes = traits::lanes;
+
+        auto goes_left = [pivot](T value) {
+            return Descending ? pivot < value : value < pivot;
+        };
+        auto pivot_vec = traits::broadcast(pivot);
+
+        // Elements distributed one by one at the end of the algorithm:
+        // the first and last vectors, and the remaining elements
+        T saved[3 * lanes];
+        std::size_t saved_count = 0;
+
+        T* write_left = first;
+        T* write_right = last;
+        if (static_cast<std::size_t>(last - first) >= 2 * lanes) {
+            for (std::size_t idx = 0 ; idx < lanes ; ++idx) {
+                saved[idx] = first[idx];
+                saved[lanes + idx] = (last - lanes)[idx];
+            }
+            saved_count = 2 * lanes;
+            T* read_left = first + lanes;
+            T* read_right = last - lanes;
+
+            while (static_cast<std::size_t>(read_right - read_left) >= lanes) {
+                typename traits::vector_type vec;
+                if (read_left - write_left <= write_right - read_right) {
+                    vec = traits::load(read_left);
+                    read_left += lanes;
+                } else {
+                    read_right -= lanes;
+                    vec = traits::load(read_right);
+                }
+                auto mask = Descending ?
+                    traits::less_mask(pivot_vec, vec) :
+                    traits::less_mask(vec, pivot_vec);
+                simd_partition_store<traits>(vec, mask, write_left, write_right);
+            }
+            first = read_left;
+            last = read_right;
+        }
+        for (; first != last ; ++first) {
+            saved[saved_count] = *first;
+            ++saved_count;
+        }
+
+        // Every position in [write_left, write_right) is free now,
+        // write the element on both sides and only keep one
+        for (std::size_t idx = 0 ; idx < saved_count ; ++idx) {
+            auto value = saved[idx];
+            bool left = goes_left(value);
+            *write_left = value;
+            *(write_right - 1) = value;
+            write_left += left;
+            write_right -= not left;
+        }
+        return write_left;
+    }
+
+    // Same interface as pdqsort's partition_right: partitions the
+    // collection around the pivot *begin, elements equivalent to
+    // the pivot go to the right partition
+    template<typename RandomAccessIterator, typename Compare>
+    auto simd_partition_right(RandomAccessIterator begin, RandomAccessIterator end, Compare)
+        -> std::pair<RandomAccessIterator, bool>
+    {
+        using value_type = value_type_t<RandomAccessIterator>;
+        constexpr bool descending = is_simd_descending_compare<Compare, value_type>::value;
+
+        auto pivot = *begin;
+        auto goes_left = [pivot](value_type value) {
+            return descending ? pivot < value : value < pivot;
+        };
+
+        RandomAccessIterator first = begin;
+        RandomAccessIterator last = end;
+
+        // Find the first element greater than or equal than the pivot (the median of 3 guarantees
+        // this exists), and the first element strictly smaller than the pivot from the right
+        while (goes_left(*++first));
+        if (first - 1 == begin) while (first < last && not goes_left(*--last));
+        else                    while (                not goes_left(*--last));
+
+        // If the first pair of elements that should be swapped to partition are the same element,
+        // the passed in sequence already was correctly partitioned
+        bool already_partitioned = first >= last;
+        if (not already_partitioned) {
+            std::swap(*first, *last);
+            ++first;
+            value_type* ptr = std::addressof(*first);
+            auto middle = simd_partition<descending>(ptr, ptr + (last - first), pivot);
+            first += middle - ptr;
+        }
+
+        // Put the pivot in the right place
+        auto pivot_pos = first - 1;
+        *begin = *pivot_pos;
+        *pivot_pos = pivot;
+
+        return std::make_pair(pivot_pos, already_partitioned);
+    }
+
+#endif
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_PARTITION_H_
@@ -0,0 +1,673 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_SIMD_SORTING_NETWORK_H_
+#define CPPSORT_DETAIL_SIMD_SORTING_NETWORK_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <cpp-sort/utility/functional.h>
+#include "iterator_traits.h"
+#include "simd.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Register-resident bitonic sorting networks
+    //
+    // Small arrays of arithmetic types are loaded into a few
+    // SIMD registers, padded with the biggest value of the type
+    // to a power of 2, and sorted with a bitonic network where
+    // every layer is one min/max operation per register plus a
+    // shuffle and a blend for the layers that compare elements
+    // of a same register.
+    //
+    // The kernels are selected at compile time depending on the
+    // available instruction sets (__AVX512F__ or __AVX2__) and
+    // are only used when the comparison is std::less or
+    // std::greater and the projection is utility::identity.
+
+    // Lane traits, specialized for every supported type below
+    template<typename T>
+    struct simd_network_traits
+    {
+        static constexpr bool is_available = false;
+    };
+
+#if defined(__AVX512F__)
+
+    ////////////////////////////////////////////////////////////
+    // AVX-512 kernels
+
+    template<std::size_t Lanes, std::size_t J>
+    auto avx512_xor_indices() noexcept
+        -> __m512i
+    {
+        // Index of the lane i ^ J for every lane i, 32-bit indices
+        // for 16 lanes and 64-bit indices for 8 lanes
+        return Lanes == 16 ?
+            _mm512_setr_epi32(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J,
+                              8 ^ J, 9 ^ J, 10 ^ J, 11 ^ J, 12 ^ J, 13 ^ J, 14 ^ J, 15 ^ J) :
+            _mm512_setr_epi64(0 ^ J, 1 ^ J, 2 ^ J, 3 ^ J, 4 ^ J, 5 ^ J, 6 ^ J, 7 ^ J);
+    }
+
+    template<>
+    struct simd_network_traits<std::int32_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 16;
+        using vector_type = __m512i;
+
+        static auto load(const std::int32_t* ptr) noexcept -> vector_type { return _mm512_loadu_si512(ptr); }
+        static auto store(std::int32_t* ptr, vector_type vec) noexcept -> void { _mm512_storeu_si512(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm512_permutexvar_epi32(avx512_xor_indices<16, J>(), vec);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_epi32(static_cast<__mmask16>(Mask), a, b);
+        }
+
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_min_epi32(value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_max_epi32(value, other);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<std::uint32_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 16;
+        using vector_type = __m512i;
+
+        static auto load(const std::uint32_t* ptr) noexcept -> vector_type { return _mm512_loadu_si512(ptr); }
+        static auto store(std::uint32_t* ptr, vector_type vec) noexcept -> void { _mm512_storeu_si512(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm512_permutexvar_epi32(avx512_xor_indices<16, J>(), vec);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_epi32(static_cast<__mmask16>(Mask), a, b);
+        }
+
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_min_epu32(value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_max_epu32(value, other);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<std::int64_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m512i;
+
+        static auto load(const std::int64_t* ptr) noexcept -> vector_type { return _mm512_loadu_si512(ptr); }
+        static auto store(std::int64_t* ptr, vector_type vec) noexcept -> void { _mm512_storeu_si512(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm512_permutexvar_epi64(avx512_xor_indices<8, J>(), vec);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_epi64(static_cast<__mmask8>(Mask), a, b);
+        }
+
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_min_epi64(value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_max_epi64(value, other);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<float>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 16;
+        using vector_type = __m512;
+
+        static auto load(const float* ptr) noexcept -> vector_type { return _mm512_loadu_ps(ptr); }
+        static auto store(float* ptr, vector_type vec) noexcept -> void { _mm512_storeu_ps(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm512_permutexvar_ps(avx512_xor_indices<16, J>(), vec);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_ps(static_cast<__mmask16>(Mask), a, b);
+        }
+
+        // min/max instructions don't preserve the sign of zeros: the
+        // functions below keep the first value unless the other one
+        // compares strictly lower (resp. greater), which ensures that
+        // the compare-exchanges produce a permutation of the elements
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(other, value, _CMP_LT_OQ), value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(value, other, _CMP_LT_OQ), value, other);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<double>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m512d;
+
+        static auto load(const double* ptr) noexcept -> vector_type { return _mm512_loadu_pd(ptr); }
+        static auto store(double* ptr, vector_type vec) noexcept -> void { _mm512_storeu_pd(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm512_permutexvar_pd(avx512_xor_indices<8, J>(), vec);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_pd(static_cast<__mmask8>(Mask), a, b);
+        }
+
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(other, value, _CMP_LT_OQ), value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(value, other, _CMP_LT_OQ), value, other);
+        }
+    };
+
+#elif defined(__AVX2__)
+
+    ////////////////////////////////////////////////////////////
+    // AVX2 kernels
+
+    // Shuffle control swapping the lanes i and i ^ J of a 128-bit
+    // lane of 32-bit elements, or of a 256-bit vector of 64-bit ones
+    template<std::size_t J>
+    constexpr int avx2_xor_control = J == 1 ? _MM_SHUFFLE(2, 3, 0, 1) : _MM_SHUFFLE(1, 0, 3, 2);
+
+    // Expand a mask of 4 64-bit lanes to a mask of 8 32-bit lanes
+    constexpr auto avx2_expand_mask(unsigned mask) noexcept
+        -> int
+    {
+        int res = 0;
+        for (int i = 0 ; i < 4 ; ++i) {
+            if (mask & (1u << i)) {
+                res |= 3 << (2 * i);
+            }
+        }
+        return res;
+    }
+
+    template<typename Integer>
+    struct avx2_epi32_traits
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m256i;
+
+        static auto load(const Integer* ptr) noexcept
+            -> vector_type
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+
+        static auto store(Integer* ptr, vector_type vec) noexcept
+            -> void
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), vec);
+        }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return swap_lanes_impl(vec, std::integral_constant<std::size_t, J>{});
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm256_blend_epi32(a, b, static_cast<int>(Mask));
+        }
+
+        template<std::size_t J>
+        static auto swap_lanes_impl(vector_type vec, std::integral_constant<std::size_t, J>) noexcept
+            -> vector_type
+        {
+            return _mm256_shuffle_epi32(vec, avx2_xor_control<J>);
+        }
+
+        static auto swap_lanes_impl(vector_type vec, std::integral_constant<std::size_t, 4>) noexcept
+            -> vector_type
+        {
+            return _mm256_permute2x128_si256(vec, vec, 1);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<std::int32_t>:
+        avx2_epi32_traits<std::int32_t>
+    {
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_min_epi32(value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_max_epi32(value, other);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<std::uint32_t>:
+        avx2_epi32_traits<std::uint32_t>
+    {
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_min_epu32(value, other);
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_max_epu32(value, other);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<std::int64_t>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 4;
+        using vector_type = __m256i;
+
+        static auto load(const std::int64_t* ptr) noexcept
+            -> vector_type
+        {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+
+        static auto store(std::int64_t* ptr, vector_type vec) noexcept
+            -> void
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), vec);
+        }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm256_permute4x64_epi64(vec, avx2_xor_control<J>);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm256_blend_epi32(a, b, avx2_expand_mask(Mask));
+        }
+
+        // There is no 64-bit integer min/max in AVX2
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_blendv_epi8(value, other, _mm256_cmpgt_epi64(value, other));
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_blendv_epi8(value, other, _mm256_cmpgt_epi64(other, value));
+        }
+    };
+
+    template<>
+    struct simd_network_traits<float>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 8;
+        using vector_type = __m256;
+
+        static auto load(const float* ptr) noexcept -> vector_type { return _mm256_loadu_ps(ptr); }
+        static auto store(float* ptr, vector_type vec) noexcept -> void { _mm256_storeu_ps(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return swap_lanes_impl(vec, std::integral_constant<std::size_t, J>{});
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm256_blend_ps(a, b, static_cast<int>(Mask));
+        }
+
+        // min/max instructions don't preserve the sign of zeros: the
+        // functions below keep the first value unless the other one
+        // compares strictly lower (resp. greater), which ensures that
+        // the compare-exchanges produce a permutation of the elements
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_blendv_ps(value, other, _mm256_cmp_ps(other, value, _CMP_LT_OQ));
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_blendv_ps(value, other, _mm256_cmp_ps(value, other, _CMP_LT_OQ));
+        }
+
+        template<std::size_t J>
+        static auto swap_lanes_impl(vector_type vec, std::integral_constant<std::size_t, J>) noexcept
+            -> vector_type
+        {
+            return _mm256_permute_ps(vec, avx2_xor_control<J>);
+        }
+
+        static auto swap_lanes_impl(vector_type vec, std::integral_constant<std::size_t, 4>) noexcept
+            -> vector_type
+        {
+            return _mm256_permute2f128_ps(vec, vec, 1);
+        }
+    };
+
+    template<>
+    struct simd_network_traits<double>
+    {
+        static constexpr bool is_available = true;
+        static constexpr std::size_t lanes = 4;
+        using vector_type = __m256d;
+
+        static auto load(const double* ptr) noexcept -> vector_type { return _mm256_loadu_pd(ptr); }
+        static auto store(double* ptr, vector_type vec) noexcept -> void { _mm256_storeu_pd(ptr, vec); }
+
+        template<std::size_t J>
+        static auto swap_lanes(vector_type vec) noexcept
+            -> vector_type
+        {
+            return _mm256_permute4x64_pd(vec, avx2_xor_control<J>);
+        }
+
+        template<unsigned Mask>
+        static auto blend(vector_type a, vector_type b) noexcept
+            -> vector_type
+        {
+            return _mm256_blend_pd(a, b, static_cast<int>(Mask));
+        }
+
+        static auto select_min(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_blendv_pd(value, other, _mm256_cmp_pd(other, value, _CMP_LT_OQ));
+        }
+
+        static auto select_max(vector_type value, vector_type other) noexcept
+            -> vector_type
+        {
+            return _mm256_blendv_pd(value, other, _mm256_cmp_pd(value, other, _CMP_LT_OQ));
+        }
+    };
+
+#endif
+
+    ////////////////////////////////////////////////////////////
+    // Bitonic network over Registers * Lanes elements
+
+    // Lanes taking the maximum of a compare-exchange between lanes
+    // i and i ^ J in a block of size K, for an ascending sort
+    constexpr auto bitonic_max_mask(std::size_t lanes, std::size_t j, std::size_t k) noexcept
+        -> unsigned
+    {
+        unsigned mask = 0;
+        for (std::size_t i = 0 ; i < lanes ; ++i) {
+            bool upper = (i & j) != 0;
+            bool descending = k < lanes && (i & k) != 0;
+            if (upper != descending) {
+                mask |= 1u << i;
+            }
+        }
+        return mask;
+    }
+
+    template<typename Traits, std::size_t Registers, std::size_t K, std::size_t J>
+    auto bitonic_exchange(typename Traits::vector_type* vec, std::true_type /* across registers */) noexcept
+        -> void
+    {
+        constexpr std::size_t distance = J / Traits::lanes;
+        for (std::size_t reg = 0 ; reg < Registers ; ++reg) {
+            std::size_t partner = reg ^ distance;
+            if (partner < reg) continue;
+            bool descending = ((reg * Traits::lanes) & K) != 0;
+            auto lo = vec[reg];
+            auto hi = vec[partner];
+            if (descending) {
+                vec[reg] = Traits::select_max(lo, hi);
+                vec[partner] = Traits::select_min(hi, lo);
+            } else {
+                vec[reg] = Traits::select_min(lo, hi);
+                vec[partner] = Traits::select_max(hi, lo);
+            }
+        }
+    }
+
+    template<typename Traits, std::size_t Registers, std::size_t K, std::size_t J>
+    auto bitonic_exchange(typename Traits::vector_type* vec, std::false_type /* within registers */) noexcept
+        -> void
+    {
+        constexpr unsigned full_mask = (1u << Traits::lanes) - 1u;
+        constexpr unsigned max_mask = bitonic_max_mask(Traits::lanes, J, K);
+        for (std::size_t reg = 0 ; reg < Registers ; ++reg) {
+            auto other = Traits::template swap_lanes<J>(vec[reg]);
+            auto lo = Traits::select_min(vec[reg], other);
+            auto hi = Traits::select_max(vec[reg], other);
+            bool descending = K >= Traits::lanes && ((reg * Traits::lanes) & K) != 0;
+            if (descending) {
+                vec[reg] = Traits::template blend<~max_mask & full_mask>(lo, hi);
+            } else {
+                vec[reg] = Traits::template blend<max_mask>(lo, hi);
+            }
+        }
+    }
+
+    template<typename Traits, std::size_t Registers, std::size_t K, std::size_t J,
+             bool Done = (K > Registers * Traits::lanes)>
+    struct bitonic_network
+    {
+        static auto apply(typename Traits::vector_type* vec) noexcept
+            -> void
+        {
+            bitonic_exchange<Traits, Registers, K, J>(
+                vec, std::integral_constant<bool, (J >= Traits::lanes)>{}
+            );
+            bitonic_network<Traits, Registers, (J == 1 ? K * 2 : K), (J == 1 ? K : J / 2)>::apply(vec);
+        }
+    };
+
+    template<typename Traits, std::size_t Registers, std::size_t K, std::size_t J>
+    struct bitonic_network<Traits, Registers, K, J, true>
+    {
+        static auto apply(typename Traits::vector_type*) noexcept
+            -> void
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Entry point
+
+    template<typename T>
+    constexpr bool has_simd_network_traits_v = simd_network_traits<simd_key_t<T>>::is_available;
+
+    // Whether sorting N elements of the given iterator with the given
+    // comparison and projection can use a SIMD sorting network
+    template<std::size_t N, typename RandomAccessIterator, typename Compare, typename Projection,
+             typename T = value_type_t<RandomAccessIterator>>
+    constexpr bool can_simd_sorting_network_v =
+        N >= 8 && N <= 32 &&
+        std::is_same<reference_t<RandomAccessIterator>, T&>::value &&
+        std::is_same<Projection, utility::identity>::value &&
+        is_simd_compare<Compare, T>::value &&
+        has_simd_network_traits_v<T>;
+
+    // Number of registers needed to sort N elements
+    constexpr auto simd_network_registers(std::size_t size, std::size_t lanes) noexcept
+        -> std::size_t
+    {
+        std::size_t registers = 1;
+        while (registers * lanes < size) {
+            registers *= 2;
+        }
+        return registers;
+    }
+
+    // NaN doesn't compare consistently with the padding: the vector
+    // min/max operations can replace it by an infinity, so collections
+    // containing NaN are left to the regular networks
+    template<typename T>
+    auto is_simd_nan(T value, std::true_type) noexcept
+        -> bool
+    {
+        return std::isnan(value);
+    }
+
+    template<typename T>
+    auto is_simd_nan(T, std::false_type) noexcept
+        -> bool
+    {
+        return false;
+    }
+
+    // Returns false without modifying the collection when it can't
+    // be sorted with a SIMD network
+    template<std::size_t N, typename RandomAccessIterator, typename Compare>
+    auto simd_sorting_network(RandomAccessIterator first, Compare)
+        -> bool
+    {
+        using value_type = value_type_t<RandomAccessIterator>;
+        using key_type = simd_key_t<value_type>;
+        using traits = simd_network_traits<key_type>;
+        constexpr std::size_t registers = simd_network_registers(N, traits::lanes);
+        constexpr std::size_t size = registers * traits::lanes;
+
+        // Pad the elements with the biggest value of the type: it
+        // ends up at the end of the sorted array and can be ignored
+        key_type buffer[size];
+        auto it = first;
+        for (std::size_t idx = 0 ; idx < N ; ++idx, ++it) {
+            buffer[idx] = static_cast<key_type>(*it);
+            if (is_simd_nan(buffer[idx], std::is_floating_point<key_type>{})) {
+                return false;
+            }
+        }
+        for (std::size_t idx = N ; idx < size ; ++idx) {
+            buffer[idx] = std::numeric_limits<key_type>::has_infinity ?
+                std::numeric_limits<key_type>::infinity() :
+                (std::numeric_limits<key_type>::max)();
+        }
+
+        typename traits::vector_type vec[registers];
+        for (std::size_t reg = 0 ; reg < registers ; ++reg) {
+            vec[reg] = traits::load(buffer + reg * traits::lanes);
+        }
+        bitonic_network<traits, registers, 2, 1>::apply(vec);
+        for (std::size_t reg = 0 ; reg < registers ; ++reg) {
+            traits::store(buffer + reg * traits::lanes, vec[reg]);
+        }
+
+        it = first;
+        if (is_simd_descending_compare<Compare, value_type>::value) {
+            for (std::size_t idx = N ; idx > 0 ; --idx, ++it) {
+                *it = static_cast<value_type>(buffer[idx - 1]);
+            }
+        } else {
+            for (std::size_t idx = 0 ; idx < N ; ++idx, ++it) {
+                *it = static_cast<value_type>(buffer[idx]);
+            }
+        }
+        return true;
+    }
+}}
+
+#endif // CPPSORT_DETAIL_SIMD_SORTING_NETWORK_H_
@@ -10,7 +10,6 @@
 ////////////////////////////////////////////////////////////
 #include <iterator>
 #include <utility>
-#include <vector>
 #include <cpp-sort/comparators/flip.h>
 #include <cpp-sort/adapters/stable_adapter.h>
 #include <cpp-sort/utility/as_function.h>
@@ -142,7 +141,7 @@ namespace detail
         }
 
         // Encroaching lists
-        std::vector<fixed_size_list<node_type>> lists;
+        scratch_vector<fixed_size_list<node_type>> lists;
         lists.emplace_back(node_pool, destroy_node_contents<BidirectionalIterator, node_type, &node_type::it>);
         lists.back().push_back([&first](node_type* node) {
             ::new (&node->it) BidirectionalIterator(first);
@@ -24,8 +24,8 @@ Phil Endecott and Frank Gennari
 // Headers
 ////////////////////////////////////////////////////////////
 #include <cstddef>
-#include <vector>
 #include "constants.h"
+#include "../../memory.h"
 #include "../../type_traits.h"
 
 namespace cppsort
@@ -114,7 +114,7 @@ namespace detail
     // This generates the memory overhead to use in radix sorting.
     template<typename RandomAccessIterator>
     auto size_bins(std::size_t *bin_sizes,
-                   std::vector<RandomAccessIterator> &bin_cache,
+                   cppsort::detail::scratch_vector<RandomAccessIterator> &bin_cache,
                    unsigned cache_offset, unsigned &cache_end,
                    unsigned bin_count)
         -> RandomAccessIterator*
@@ -28,7 +28,6 @@ Phil Endecott and Frank Gennari
 #include <limits>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
 #include "common.h"
@@ -131,7 +130,7 @@ namespace detail
     template<typename RandomAccessIter, typename Div_type,
              typename Size_type, typename Projection>
     auto positive_float_sort_rec(RandomAccessIter first, RandomAccessIter last,
-                                 std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
+                                 cppsort::detail::scratch_vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
                                  std::size_t *bin_sizes, Projection projection)
         -> void
     {
@@ -196,7 +195,7 @@ namespace detail
     template<typename RandomAccessIter, typename Div_type,
              typename Size_type, typename Projection>
     auto negative_float_sort_rec(RandomAccessIter first, RandomAccessIter last,
-                                 std::vector<RandomAccessIter> &bin_cache,
+                                 cppsort::detail::scratch_vector<RandomAccessIter> &bin_cache,
                                  unsigned cache_offset, std::size_t *bin_sizes,
                                  Projection projection)
         -> void
@@ -262,7 +261,7 @@ namespace detail
     template<typename RandomAccessIter, typename Div_type,
              typename Size_type, typename Projection>
     auto float_sort_rec(RandomAccessIter first, RandomAccessIter last,
-                        std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
+                        cppsort::detail::scratch_vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
                         std::size_t *bin_sizes, Projection projection)
         -> void
     {
@@ -371,7 +370,7 @@ namespace detail
         >
     {
       std::size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      cppsort::detail::scratch_vector<RandomAccessIter> bin_cache;
       float_sort_rec<RandomAccessIter, std::int32_t, std::uint32_t>
         (first, last, bin_cache, 0, bin_sizes, projection);
     }
@@ -386,7 +385,7 @@ namespace detail
         >
     {
       std::size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      cppsort::detail::scratch_vector<RandomAccessIter> bin_cache;
       float_sort_rec<RandomAccessIter, std::int64_t, std::uint64_t>
         (first, last, bin_cache, 0, bin_sizes, projection);
     }
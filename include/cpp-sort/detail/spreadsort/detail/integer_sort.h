@@ -27,7 +27,6 @@ Phil Endecott and Frank Gennari
 #include <functional>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
 #include "common.h"
@@ -97,7 +96,7 @@ namespace spreadsort
     template<typename RandomAccessIter, typename Div_type,
              typename Size_type, typename Projection>
     auto spreadsort_rec(RandomAccessIter first, RandomAccessIter last,
-                        std::vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
+                        cppsort::detail::scratch_vector<RandomAccessIter> &bin_cache, unsigned cache_offset,
                         std::size_t *bin_sizes, Projection projection)
         -> void
     {
@@ -209,7 +208,7 @@ namespace spreadsort
         >
     {
       std::size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      cppsort::detail::scratch_vector<RandomAccessIter> bin_cache;
       spreadsort_rec<RandomAccessIter, Div_type, std::size_t, Projection>(
           first, last, bin_cache, 0, bin_sizes, projection);
     }
@@ -226,7 +225,7 @@ namespace spreadsort
         >
     {
       std::size_t bin_sizes[1 << max_finishing_splits];
-      std::vector<RandomAccessIter> bin_cache;
+      cppsort::detail::scratch_vector<RandomAccessIter> bin_cache;
       spreadsort_rec<RandomAccessIter, Div_type, std::uintmax_t, Projection>(
           first, last, bin_cache, 0, bin_sizes, projection);
     }
@@ -29,7 +29,6 @@ Phil Endecott and Frank Gennari
 #include <memory>
 #include <tuple>
 #include <type_traits>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include <cpp-sort/utility/iter_move.h>
@@ -157,7 +156,7 @@ namespace spreadsort
     template<typename Unsigned_char_type, typename RandomAccessIter, typename Projection>
     auto string_sort_rec(RandomAccessIter first, RandomAccessIter last,
                          std::size_t char_offset,
-                         std::vector<RandomAccessIter> &bin_cache,
+                         cppsort::detail::scratch_vector<RandomAccessIter> &bin_cache,
                          unsigned cache_offset, std::size_t *bin_sizes,
                          Projection projection)
         -> void
@@ -269,7 +268,7 @@ namespace spreadsort
     template<typename Unsigned_char_type, typename RandomAccessIter, typename Projection>
     auto reverse_string_sort_rec(RandomAccessIter first, RandomAccessIter last,
                                  std::size_t char_offset,
-                                 std::vector<RandomAccessIter> &bin_cache,
+                                 cppsort::detail::scratch_vector<RandomAccessIter> &bin_cache,
                                  unsigned cache_offset, std::size_t *bin_sizes,
                                  Projection projection)
         -> void
@@ -389,7 +388,7 @@ namespace spreadsort
         -> cppsort::detail::enable_if_t<sizeof(Unsigned_char_type) <= 2, void>
     {
       std::size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      cppsort::detail::scratch_vector<RandomAccessIter> bin_cache;
       string_sort_rec<Unsigned_char_type>(first, last, 0, bin_cache, 0,
                                           bin_sizes, projection);
     }
@@ -402,7 +401,7 @@ namespace spreadsort
         -> cppsort::detail::enable_if_t<sizeof(Unsigned_char_type) <= 2, void>
     {
       std::size_t bin_sizes[(1 << (8 * sizeof(Unsigned_char_type))) + 1];
-      std::vector<RandomAccessIter> bin_cache;
+      cppsort::detail::scratch_vector<RandomAccessIter> bin_cache;
       reverse_string_sort_rec<Unsigned_char_type>(first, last, 0, bin_cache, 0,
                                                   bin_sizes, projection);
     }
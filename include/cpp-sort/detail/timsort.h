@@ -40,9 +40,9 @@
 #include <new>
 #include <type_traits>
 #include <utility>
-#include <vector>
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/iter_move.h>
+#include "algorithm_events.h"
 #include "config.h"
 #include "iterator_traits.h"
 #include "lower_bound.h"
@@ -95,7 +95,7 @@ namespace detail
         // Silence GCC -Winline warning
         ~TimSortBase() noexcept {}
 
-        std::vector<run<iterator>> pending_;
+        scratch_vector<run<iterator>> pending_;
 
         static auto sort(iterator const lo, iterator const hi, Compare compare, Projection projection)
             -> void
@@ -114,6 +114,7 @@ namespace detail
             }
 
             ChildClass ts{};
+            ts.prepare(lo, nRemaining);
             difference_type const minRun = minRunLength(nRemaining);
             iterator cur = lo;
             do {
@@ -202,9 +203,17 @@ namespace detail
             return n + r;
         }
 
+        auto prepare(iterator const, difference_type const)
+            -> void
+        {
+            // Hook for merge policies that need to know the
+            // collection to sort, does nothing by default
+        }
+
         auto pushRun(iterator const runBase, difference_type const runLen)
             -> void
         {
+            CPPSORT_ALGORITHM_EVENT(runs);
             pending_.emplace_back(runBase, runLen);
         }
 
@@ -420,10 +429,7 @@ namespace detail
                 // easily avoidable out-of-memory errors and make sized
                 // deallocation work properly
                 buffer.reset(nullptr);
-                buffer.get_deleter() = operator_deleter(new_size * sizeof(rvalue_type));
-                buffer.reset(static_cast<rvalue_type*>(
-                    ::operator new(new_size * sizeof(rvalue_type))
-                ));
+                buffer = make_scratch_buffer<rvalue_type>(new_size);
                 buffer_size = new_size;
             }
         }
@@ -502,6 +508,7 @@ namespace detail
                     break;
                 }
 
+                CPPSORT_ALGORITHM_EVENT(gallop_enters);
                 do {
                     CPPSORT_ASSERT(len1 > 1);
                     CPPSORT_ASSERT(len2 > 0);
@@ -550,6 +557,7 @@ namespace detail
                 if (break_outer) {
                     break;
                 }
+                CPPSORT_ALGORITHM_EVENT(gallop_exits);
 
                 if (minGallop < 0) {
                     minGallop = 0;
@@ -653,6 +661,7 @@ namespace detail
                     ++cursor1; // See comment before the loop
                 }
 
+                CPPSORT_ALGORITHM_EVENT(gallop_enters);
                 do {
                     CPPSORT_ASSERT(len1 > 0);
                     CPPSORT_ASSERT(len2 > 1);
@@ -700,6 +709,7 @@ namespace detail
                 if (break_outer) {
                     break;
                 }
+                CPPSORT_ALGORITHM_EVENT(gallop_exits);
 
                 if (minGallop < 0) {
                     minGallop = 0;
@@ -766,6 +776,113 @@ namespace detail
         }
     };
 
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    struct PowerSort:
+        TimSortBase<
+            PowerSort<RandomAccessIterator, Compare, Projection>,
+            RandomAccessIterator,
+            Compare,
+            Projection
+        >
+    {
+        // Merge policy described by J. Ian Munro and Sebastian Wild
+        // in Nearly-Optimal Mergesorts: Fast, Practical Sorting Methods
+        // That Optimally Adapt to Existing Runs: the boundary between
+        // two consecutive runs is given the depth of the node of a
+        // nearly-optimal merge tree, called power, computed from the
+        // position of the runs in the collection, and runs are merged
+        // when the boundary below them has a greater power than the
+        // boundary that was just found
+
+        using base = TimSortBase<
+            PowerSort<RandomAccessIterator, Compare, Projection>,
+            RandomAccessIterator,
+            Compare,
+            Projection
+        >;
+        using iterator = typename base::iterator;
+        using difference_type = typename base::difference_type;
+
+        iterator first_;
+        std::size_t size_ = 0;
+        // powers_[i] is the power of the boundary between the
+        // pending runs i - 1 and i, powers_[0] is meaningless
+        scratch_vector<int> powers_;
+
+        PowerSort() = default;
+
+        auto prepare(iterator const lo, difference_type const size)
+            -> void
+        {
+            first_ = lo;
+            size_ = static_cast<std::size_t>(size);
+        }
+
+        auto pushRun(iterator const runBase, difference_type const runLen)
+            -> void
+        {
+            if (this->pending_.empty()) {
+                powers_.push_back(0);
+            } else {
+                const auto& last_run = this->pending_.back();
+                powers_.push_back(power(
+                    static_cast<std::size_t>(last_run.base - first_),
+                    static_cast<std::size_t>(last_run.len),
+                    static_cast<std::size_t>(runLen)
+                ));
+            }
+            base::pushRun(runBase, runLen);
+        }
+
+        auto mergeCollapse(Compare compare, Projection projection)
+            -> void
+        {
+            // The powers of the boundaries in the stack are increasing
+            // except maybe for the last one, which was just pushed
+            auto n = this->pending_.size();
+            while (n > 2 && powers_[n - 2] > powers_[n - 1]) {
+                base::mergeAt(static_cast<difference_type>(n - 3), compare, projection);
+                powers_.erase(powers_.begin() + static_cast<std::ptrdiff_t>(n - 2));
+                --n;
+            }
+        }
+
+        auto mergeForceCollapse(Compare compare, Projection projection)
+            -> void
+        {
+            while (this->pending_.size() > 1) {
+                auto n = this->pending_.size();
+                base::mergeAt(static_cast<difference_type>(n - 2), compare, projection);
+                powers_.pop_back();
+            }
+        }
+
+        // Power of the boundary between the run [begin1, begin1 + len1)
+        // and the run that follows it, which is the length of the common
+        // prefix of the binary expansions of the relative positions of
+        // the midpoints of both runs, plus one
+        auto power(std::size_t begin1, std::size_t len1, std::size_t len2) const
+            -> int
+        {
+            // Midpoints scaled by 2 to keep computations in integers
+            std::size_t a = 2 * begin1 + len1;
+            std::size_t b = a + len1 + len2;
+            int result = 0;
+            while (true) {
+                ++result;
+                if (a >= size_) {
+                    a -= size_;
+                    b -= size_;
+                } else if (b >= size_) {
+                    break;
+                }
+                a <<= 1;
+                b <<= 1;
+            }
+            return result;
+        }
+    };
+
     template<typename RandomAccessIterator, typename Compare, typename Projection>
     auto timsort(RandomAccessIterator first, RandomAccessIterator last,
                  Compare compare, Projection projection)
@@ -785,6 +902,16 @@ namespace detail
             std::move(first), std::move(last),
             std::move(compare), std::move(projection));
     }
+
+    template<typename RandomAccessIterator, typename Compare, typename Projection>
+    auto powersort(RandomAccessIterator first, RandomAccessIterator last,
+                   Compare compare, Projection projection)
+        -> void
+    {
+        PowerSort<RandomAccessIterator, Compare, Projection>::sort(
+            std::move(first), std::move(last),
+            std::move(compare), std::move(projection));
+    }
 }}
 
 #endif // CPPSORT_DETAIL_TIMSORT_H_
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_DETAIL_WORK_STEALING_POOL_H_
+#define CPPSORT_DETAIL_WORK_STEALING_POOL_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "config.h"
+
+namespace cppsort
+{
+namespace detail
+{
+    ////////////////////////////////////////////////////////////
+    // Number of threads to use for a parallel algorithm
+
+    // Returns the number of workers that it makes sense to
+    // use to process a collection of the given size, when no
+    // worker should handle fewer than grain_size elements;
+    // max_workers == 0 means as many workers as there are
+    // hardware threads
+    inline auto parallel_workers_count(std::size_t size, std::size_t grain_size,
+                                       std::size_t max_workers)
+        -> std::size_t
+    {
+        if (max_workers == 0) {
+            max_workers = std::thread::hardware_concurrency();
+            if (max_workers == 0) {
+                // hardware_concurrency() is allowed to return 0
+                // when the information is not available
+                max_workers = 1;
+            }
+        }
+        std::size_t useful_workers = size / grain_size;
+        if (useful_workers == 0) {
+            useful_workers = 1;
+        }
+        return useful_workers < max_workers ? useful_workers : max_workers;
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Fork-join work-stealing pool
+    //
+    // Minimal pool of workers meant to be created for the
+    // duration of a single parallel algorithm: the calling
+    // thread acts as worker 0 and the other workers are only
+    // spawned during run(). Every worker owns a queue of tasks:
+    // it pushes and pops tasks at the back of its own queue,
+    // and steals tasks at the front of the other queues when
+    // its own queue is empty, which means that idle workers
+    // steal the biggest pieces of work first in divide and
+    // conquer algorithms.
+    //
+    // The first exception thrown by a task is stored, the
+    // tasks that were not started yet are discarded, and the
+    // exception is rethrown by run() once every worker is done.
+
+    class work_stealing_pool
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Member types
+
+            // Tasks are given the index of the worker running them,
+            // which is the index they should push subtasks to
+            using task_type = std::function<void(std::size_t)>;
+
+            ////////////////////////////////////////////////////////////
+            // Construction
+
+            explicit work_stealing_pool(std::size_t workers_count):
+                queues_count(workers_count > 0 ? workers_count : 1),
+                queues(new worker_queue[queues_count])
+            {}
+
+            work_stealing_pool(const work_stealing_pool&) = delete;
+            work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+            ////////////////////////////////////////////////////////////
+            // Accessors
+
+            auto size() const noexcept
+                -> std::size_t
+            {
+                return queues_count;
+            }
+
+            // Whether a task threw an exception: algorithms waiting
+            // on subtasks should check this to avoid working on
+            // a collection left in an unspecified state
+            auto cancelled() const noexcept
+                -> bool
+            {
+                return is_cancelled.load(std::memory_order_acquire);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Task scheduling
+
+            // Schedule a task on the queue of the given worker
+            template<typename Task>
+            auto push(std::size_t worker, Task&& task)
+                -> void
+            {
+                schedule(worker, task_type(std::forward<Task>(task)), nullptr);
+            }
+
+            // Schedule a task and increment the given latch, the
+            // latch is decremented once the task is done, even if
+            // it threw an exception or was discarded
+            template<typename Task>
+            auto push(std::size_t worker, Task&& task, std::atomic<std::size_t>& latch)
+                -> void
+            {
+                schedule(worker, task_type(std::forward<Task>(task)), &latch);
+            }
+
+            // Execute pending tasks until the latch reaches zero,
+            // this is how a task should wait for its subtasks
+            auto wait(std::size_t worker, const std::atomic<std::size_t>& latch)
+                -> void
+            {
+                while (latch.load(std::memory_order_acquire) > 0) {
+                    if (not execute_one(worker)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            // Run the given task on the calling thread and have the
+            // other workers help with the tasks it spawns, returns
+            // once every scheduled task is done
+            template<typename Task>
+            auto run(Task&& root)
+                -> void
+            {
+                push(0, std::forward<Task>(root));
+
+                std::vector<std::thread> threads;
+                threads.reserve(queues_count - 1);
+                for (std::size_t worker = 1 ; worker < queues_count ; ++worker) {
+                    try {
+                        threads.emplace_back([this, worker] { work(worker); });
+                    } catch (const std::system_error&) {
+                        // Not being able to spawn a thread is not an error,
+                        // the workers that did start will do the work
+                        break;
+                    }
+                }
+                work(0);
+                for (auto& thread: threads) {
+                    thread.join();
+                }
+
+                if (exception) {
+                    std::rethrow_exception(exception);
+                }
+            }
+
+        private:
+
+            struct scheduled_task
+            {
+                task_type function;
+                std::atomic<std::size_t>* latch = nullptr;
+            };
+
+            struct worker_queue
+            {
+                std::mutex mutex;
+                std::deque<scheduled_task> tasks;
+            };
+
+            auto schedule(std::size_t worker, task_type&& function,
+                          std::atomic<std::size_t>* latch)
+                -> void
+            {
+                auto& queue = queues[worker];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                // Counters are incremented before the task is visible
+                // to the other workers, otherwise they could see the
+                // count of pending tasks reach zero too early
+                pending.fetch_add(1, std::memory_order_relaxed);
+                if (latch) {
+                    latch->fetch_add(1, std::memory_order_relaxed);
+                }
+                try {
+                    queue.tasks.push_back({std::move(function), latch});
+                } catch (...) {
+                    if (latch) {
+                        latch->fetch_sub(1, std::memory_order_relaxed);
+                    }
+                    pending.fetch_sub(1, std::memory_order_relaxed);
+                    throw;
+                }
+            }
+
+            auto work(std::size_t worker)
+                -> void
+            {
+                while (pending.load(std::memory_order_acquire) > 0) {
+                    if (not execute_one(worker)) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+
+            auto try_pop(std::size_t worker, scheduled_task& task)
+                -> bool
+            {
+                auto& queue = queues[worker];
+                std::lock_guard<std::mutex> lock(queue.mutex);
+                if (queue.tasks.empty()) {
+                    return false;
+                }
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                return true;
+            }
+
+            auto try_steal(std::size_t worker, scheduled_task& task)
+                -> bool
+            {
+                for (std::size_t offset = 1 ; offset < queues_count ; ++offset) {
+                    auto& queue = queues[(worker + offset) % queues_count];
+                    std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+                    if (not lock.owns_lock() || queue.tasks.empty()) {
+                        continue;
+                    }
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                    return true;
+                }
+                return false;
+            }
+
+            auto execute_one(std::size_t worker)
+                -> bool
+            {
+                scheduled_task task;
+                if (not try_pop(worker, task) && not try_steal(worker, task)) {
+                    return false;
+                }
+
+                // Tasks are discarded once the pool is cancelled
+                if (not cancelled()) {
+                    try {
+                        task.function(worker);
+                    } catch (...) {
+                        std::lock_guard<std::mutex> lock(exception_mutex);
+                        if (not exception) {
+                            exception = std::current_exception();
+                        }
+                        is_cancelled.store(true, std::memory_order_release);
+                    }
+                }
+                // Destroy the task before marking it as done so that its
+                // captured state does not outlive the algorithm
+                task.function = nullptr;
+                if (task.latch) {
+                    task.latch->fetch_sub(1, std::memory_order_acq_rel);
+                }
+                pending.fetch_sub(1, std::memory_order_acq_rel);
+                return true;
+            }
+
+            std::size_t queues_count;
+            std::unique_ptr<worker_queue[]> queues;
+            std::atomic<std::size_t> pending{0};
+            std::atomic<bool> is_cancelled{false};
+            std::mutex exception_mutex;
+            std::exception_ptr exception;
+    };
+}}
+
+#endif // CPPSORT_DETAIL_WORK_STEALING_POOL_H_
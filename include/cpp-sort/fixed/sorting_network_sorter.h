@@ -14,7 +14,10 @@
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
 #include "../detail/empty_sorter.h"
+#include "../detail/simd_sorting_network.h"
+#include "../detail/type_traits.h"
 
 namespace cppsort
 {
@@ -41,11 +44,66 @@ namespace cppsort
         struct sorting_network_sorter_impl<1>:
             cppsort::detail::empty_network_sorter_impl
         {};
+
+        // Sorts arithmetic types compared with std::less or std::greater
+        // with a vectorized bitonic network when the instruction set
+        // allows it, and with the regular network otherwise
+        template<std::size_t N>
+        struct simd_sorting_network_sorter_impl:
+            sorting_network_sorter_impl<N>
+        {
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<is_projection_iterator_v<
+                    Projection, RandomAccessIterator, Compare
+                >>
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                using can_simd = std::integral_constant<bool,
+                    can_simd_sorting_network_v<N, RandomAccessIterator, Compare, Projection>
+                >;
+                sort(can_simd{}, std::move(first), std::move(last),
+                     std::move(compare), std::move(projection));
+            }
+
+        private:
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort(std::true_type, RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection) const
+                -> void
+            {
+                if (not simd_sorting_network<N>(first, compare)) {
+                    sort(std::false_type{}, std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+                }
+            }
+
+            template<typename RandomAccessIterator, typename Compare, typename Projection>
+            auto sort(std::false_type, RandomAccessIterator first, RandomAccessIterator last,
+                      Compare compare, Projection projection) const
+                -> void
+            {
+                sorting_network_sorter_impl<N>::operator()(
+                    std::move(first), std::move(last),
+                    std::move(compare), std::move(projection)
+                );
+            }
+        };
     }
 
     template<std::size_t N>
     struct sorting_network_sorter:
-        sorter_facade<detail::sorting_network_sorter_impl<N>>
+        sorter_facade<detail::conditional_t<
+            (N >= 8 && N <= 32),
+            detail::simd_sorting_network_sorter_impl<N>,
+            detail::sorting_network_sorter_impl<N>
+        >>
     {};
 
     ////////////////////////////////////////////////////////////
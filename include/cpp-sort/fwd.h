@@ -14,15 +14,16 @@
 namespace cppsort
 {
     // This header contains forward declarations for every
-    // sorter and sorter adapter in the library, which helps
-    // to specialize some of the adapters or to provide
-    // information about some sorters without actually having
-    // to include the whole thing
+    // sorter, selector and sorter adapter in the library,
+    // which helps to specialize some of the adapters or to
+    // provide information about some sorters without actually
+    // having to include the whole thing
 
     ////////////////////////////////////////////////////////////
     // Sorters
 
     struct adaptive_shivers_sorter;
+    struct adaptive_sorter;
     template<typename BufferProvider>
     struct block_sorter;
     struct cartesian_tree_sorter;
@@ -37,11 +38,18 @@ namespace cppsort
     struct heap_sorter;
     struct insertion_sorter;
     struct integer_spread_sorter;
+    struct ips4o_sorter;
+    struct lsd_radix_sorter;
     struct mel_sorter;
     struct merge_insertion_sorter;
     struct merge_sorter;
+    struct multiway_merge_sorter;
+    struct parallel_merge_sorter;
+    struct parallel_pdq_sorter;
+    struct parallel_ska_sorter;
     struct pdq_sorter;
     struct poplar_sorter;
+    struct power_sorter;
     struct quick_merge_sorter;
     struct quick_sorter;
     struct selection_sorter;
@@ -73,6 +81,13 @@ namespace cppsort
     template<std::size_t N>
     struct sorting_network_sorter;
 
+    ////////////////////////////////////////////////////////////
+    // Selectors
+
+    struct nth_element_selector;
+    struct partial_sort_selector;
+    struct top_k_selector;
+
     ////////////////////////////////////////////////////////////
     // Sorter adapters
 
@@ -87,8 +102,12 @@ namespace cppsort
     template<typename Sorter>
     struct indirect_adapter;
     template<typename Sorter>
+    struct memory_resource_adapter;
+    template<typename Sorter>
     struct out_of_place_adapter;
     template<typename Sorter>
+    struct packed_schwartz_adapter;
+    template<typename Sorter>
     struct schwartz_adapter;
     template<typename Sorter>
     struct self_sort_adapter;
@@ -106,8 +125,20 @@ namespace cppsort
 
     namespace metrics
     {
+        template<typename Sorter>
+        struct algorithm_events;
+        template<typename Sorter>
+        struct allocations;
+        template<typename Sorter, typename... Tags>
+        struct combine;
         template<typename Sorter, typename CountType=std::size_t>
         struct comparisons;
+        template<typename Sorter, std::size_t Repetitions=1>
+        struct cpu_cycles;
+        template<typename Sorter>
+        struct hardware_counters;
+        template<typename Sorter>
+        struct latency_histogram;
         template<typename Sorter, typename CountType=std::size_t>
         struct moves;
         template<typename Sorter, typename CountType=std::size_t>
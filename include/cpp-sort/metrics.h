@@ -7,7 +7,13 @@
 
 #include <cpp-sort/utility/metrics_tools.h>
 
+#include <cpp-sort/metrics/algorithm_events.h>
+#include <cpp-sort/metrics/allocations.h>
+#include <cpp-sort/metrics/combine.h>
 #include <cpp-sort/metrics/comparisons.h>
+#include <cpp-sort/metrics/cpu_cycles.h>
+#include <cpp-sort/metrics/hardware_counters.h>
+#include <cpp-sort/metrics/latency_histogram.h>
 #include <cpp-sort/metrics/moves.h>
 #include <cpp-sort/metrics/running_time.h>
 #include <cpp-sort/metrics/projections.h>
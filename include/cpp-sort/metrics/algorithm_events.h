@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_ALGORITHM_EVENTS_H_
+#define CPPSORT_METRICS_ALGORITHM_EVENTS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include "../detail/algorithm_events.h"
+#include "../detail/checkers.h"
+
+namespace cppsort
+{
+namespace metrics
+{
+    ////////////////////////////////////////////////////////////
+    // Tag
+
+    struct algorithm_events_tag {};
+
+    ////////////////////////////////////////////////////////////
+    // Decisions made by the algorithms used by the sorter
+
+    struct algorithm_events_values
+    {
+        // Whether the library was compiled with the events,
+        // all the other values are 0 otherwise
+#if defined(CPPSORT_ENABLE_ALGORITHM_EVENTS)
+        bool enabled = true;
+#else
+        bool enabled = false;
+#endif
+
+        // Partitions performed by pdqsort, those considered
+        // highly unbalanced, and switches to heapsort after too
+        // many unbalanced partitions
+        std::uint64_t partitions = 0;
+        std::uint64_t unbalanced_partitions = 0;
+        std::uint64_t heapsort_fallbacks = 0;
+
+        // Runs found by timsort, and the number of times its
+        // merge procedures entered and left galloping mode
+        std::uint64_t runs = 0;
+        std::uint64_t gallop_enters = 0;
+        std::uint64_t gallop_exits = 0;
+
+        // Attempts to grow a temporary buffer that got all the
+        // requested memory, only part of it, or none at all
+        std::uint64_t buffer_growths = 0;
+        std::uint64_t buffer_partial_growths = 0;
+        std::uint64_t buffer_growth_failures = 0;
+
+        friend auto operator<<(std::ostream& stream, const algorithm_events_values& values)
+            -> std::ostream&
+        {
+            if (not values.enabled) {
+                stream << "algorithm events are disabled";
+                return stream;
+            }
+            stream << "partitions: " << values.partitions
+                   << ", unbalanced partitions: " << values.unbalanced_partitions
+                   << ", heapsort fallbacks: " << values.heapsort_fallbacks
+                   << ", runs: " << values.runs
+                   << ", gallop enters: " << values.gallop_enters
+                   << ", gallop exits: " << values.gallop_exits
+                   << ", buffer growths: " << values.buffer_growths
+                   << ", buffer partial growths: " << values.buffer_partial_growths
+                   << ", buffer growth failures: " << values.buffer_growth_failures;
+            return stream;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Metric
+
+    template<typename Sorter>
+    struct algorithm_events:
+        utility::adapter_storage<Sorter>,
+        cppsort::detail::check_iterator_category<Sorter>,
+        cppsort::detail::check_is_always_stable<Sorter>
+    {
+        using tag_t = algorithm_events_tag;
+        using metric_t = utility::metric<algorithm_events_values, tag_t>;
+
+        algorithm_events() = default;
+
+        constexpr explicit algorithm_events(Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter))
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(
+                this->get()(std::forward<Args>(args)...),
+                metric_t(std::declval<algorithm_events_values>())
+            )
+        {
+            cppsort::detail::algorithm_events events;
+            {
+                cppsort::detail::scoped_algorithm_events scope(events);
+                this->get()(std::forward<Args>(args)...);
+            }
+
+            algorithm_events_values res;
+            res.partitions = events.partitions;
+            res.unbalanced_partitions = events.unbalanced_partitions;
+            res.heapsort_fallbacks = events.heapsort_fallbacks;
+            res.runs = events.runs;
+            res.gallop_enters = events.gallop_enters;
+            res.gallop_exits = events.gallop_exits;
+            res.buffer_growths = events.buffer_growths;
+            res.buffer_partial_growths = events.buffer_partial_growths;
+            res.buffer_growth_failures = events.buffer_growth_failures;
+            return metric_t(res);
+        }
+    };
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<metrics::algorithm_events<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_ALGORITHM_EVENTS_H_
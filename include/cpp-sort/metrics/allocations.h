@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_ALLOCATIONS_H_
+#define CPPSORT_METRICS_ALLOCATIONS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <ostream>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include "../detail/checkers.h"
+#include "../detail/memory.h"
+
+namespace cppsort
+{
+namespace metrics
+{
+    ////////////////////////////////////////////////////////////
+    // Tag
+
+    struct allocations_tag {};
+
+    ////////////////////////////////////////////////////////////
+    // Scratch memory allocated by the sorter
+
+    struct allocations_values
+    {
+        // Number of allocations
+        std::size_t count = 0;
+        // Sum of the sizes of all allocations
+        std::size_t bytes = 0;
+        // Greatest amount of memory allocated at once
+        std::size_t peak_bytes = 0;
+
+        friend auto operator<<(std::ostream& stream, const allocations_values& values)
+            -> std::ostream&
+        {
+            stream << "allocations: " << values.count
+                   << ", bytes: " << values.bytes
+                   << ", peak bytes: " << values.peak_bytes;
+            return stream;
+        }
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Metric
+
+    template<typename Sorter>
+    struct allocations:
+        utility::adapter_storage<Sorter>,
+        cppsort::detail::check_iterator_category<Sorter>,
+        cppsort::detail::check_is_always_stable<Sorter>
+    {
+        using tag_t = allocations_tag;
+        using metric_t = utility::metric<allocations_values, tag_t>;
+
+        allocations() = default;
+
+        constexpr explicit allocations(Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter))
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(
+                this->get()(std::forward<Args>(args)...),
+                metric_t(std::declval<allocations_values>())
+            )
+        {
+            cppsort::detail::scratch_statistics statistics;
+            {
+                cppsort::detail::scoped_scratch_statistics scope(statistics);
+                this->get()(std::forward<Args>(args)...);
+            }
+
+            allocations_values res;
+            res.count = statistics.allocations;
+            res.bytes = statistics.bytes;
+            res.peak_bytes = statistics.peak_bytes;
+            return metric_t(res);
+        }
+    };
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<metrics::allocations<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_ALLOCATIONS_H_
@@ -0,0 +1,657 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_COMBINE_H_
+#define CPPSORT_METRICS_COMBINE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/metrics/algorithm_events.h>
+#include <cpp-sort/metrics/allocations.h>
+#include <cpp-sort/metrics/comparisons.h>
+#include <cpp-sort/metrics/cpu_cycles.h>
+#include <cpp-sort/metrics/hardware_counters.h>
+#include <cpp-sort/metrics/moves.h>
+#include <cpp-sort/metrics/projections.h>
+#include <cpp-sort/metrics/running_time.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/algorithm_events.h"
+#include "../detail/checkers.h"
+#include "../detail/comparison_counter.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace metrics
+{
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Metrics that can be combined: the value type and name
+        // associated to their tags
+
+        template<typename Tag>
+        struct combined_metric;
+
+        template<>
+        struct combined_metric<algorithm_events_tag>
+        {
+            using value_type = algorithm_events_values;
+            static constexpr auto name() noexcept -> const char* { return "algorithm_events"; }
+        };
+
+        template<>
+        struct combined_metric<allocations_tag>
+        {
+            using value_type = allocations_values;
+            static constexpr auto name() noexcept -> const char* { return "allocations"; }
+        };
+
+        template<>
+        struct combined_metric<comparisons_tag>
+        {
+            using value_type = std::size_t;
+            static constexpr auto name() noexcept -> const char* { return "comparisons"; }
+        };
+
+        template<>
+        struct combined_metric<cpu_cycles_tag>
+        {
+            using value_type = std::uint64_t;
+            static constexpr auto name() noexcept -> const char* { return "cpu_cycles"; }
+        };
+
+        template<>
+        struct combined_metric<hardware_counters_tag>
+        {
+            using value_type = hardware_counters_values;
+            static constexpr auto name() noexcept -> const char* { return "hardware_counters"; }
+        };
+
+        template<>
+        struct combined_metric<moves_tag>
+        {
+            using value_type = std::size_t;
+            static constexpr auto name() noexcept -> const char* { return "moves"; }
+        };
+
+        template<>
+        struct combined_metric<projections_tag>
+        {
+            using value_type = std::size_t;
+            static constexpr auto name() noexcept -> const char* { return "projections"; }
+        };
+
+        template<>
+        struct combined_metric<running_time_tag>
+        {
+            using value_type = std::chrono::steady_clock::duration;
+            static constexpr auto name() noexcept -> const char* { return "running_time"; }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Values computed by a combined call
+
+        struct combined_values
+        {
+            algorithm_events_values algorithm_events;
+            allocations_values allocations;
+            std::size_t comparisons = 0;
+            std::uint64_t cpu_cycles = 0;
+            hardware_counters_values hardware_counters;
+            std::size_t moves = 0;
+            std::size_t projections = 0;
+            std::chrono::steady_clock::duration running_time{};
+        };
+
+        inline auto combined_value(const combined_values& values, algorithm_events_tag)
+            -> algorithm_events_values
+        {
+            return values.algorithm_events;
+        }
+
+        inline auto combined_value(const combined_values& values, allocations_tag)
+            -> allocations_values
+        {
+            return values.allocations;
+        }
+
+        inline auto combined_value(const combined_values& values, comparisons_tag)
+            -> std::size_t
+        {
+            return values.comparisons;
+        }
+
+        inline auto combined_value(const combined_values& values, cpu_cycles_tag)
+            -> std::uint64_t
+        {
+            return values.cpu_cycles;
+        }
+
+        inline auto combined_value(const combined_values& values, hardware_counters_tag)
+            -> hardware_counters_values
+        {
+            return values.hardware_counters;
+        }
+
+        inline auto combined_value(const combined_values& values, moves_tag)
+            -> std::size_t
+        {
+            return values.moves;
+        }
+
+        inline auto combined_value(const combined_values& values, projections_tag)
+            -> std::size_t
+        {
+            return values.projections;
+        }
+
+        inline auto combined_value(const combined_values& values, running_time_tag)
+            -> std::chrono::steady_clock::duration
+        {
+            return values.running_time;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Counting pass: the comparison, projection and moves
+        // counters are all installed around a single sorter call
+
+        template<typename Compare>
+        auto counting_compare(Compare compare, std::size_t& count, std::true_type)
+            -> cppsort::detail::comparison_counter<Compare, std::size_t>
+        {
+            return { std::move(compare), count };
+        }
+
+        template<typename Compare>
+        auto counting_compare(Compare compare, std::size_t&, std::false_type)
+            -> Compare
+        {
+            return compare;
+        }
+
+        template<typename Projection>
+        auto counting_projection(Projection projection, std::size_t& count, std::true_type)
+            -> projection_counter<Projection, std::size_t>
+        {
+            return { std::move(projection), count };
+        }
+
+        template<typename Projection>
+        auto counting_projection(Projection projection, std::size_t&, std::false_type)
+            -> Projection
+        {
+            return projection;
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection,
+                 typename Sorter, typename Call>
+        auto counting_call(std::true_type /* moves */,
+                           ForwardIterator first, ForwardIterator last,
+                           cppsort::detail::difference_type_t<ForwardIterator> size,
+                           Compare compare, Projection projection,
+                           const Sorter& sorter, Call&&, combined_values& values)
+            -> void
+        {
+            values.moves = count_moves<std::size_t>(
+                first, last, size,
+                std::move(compare), std::move(projection),
+                sorter
+            );
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection,
+                 typename Sorter, typename Call>
+        auto counting_call(std::false_type /* moves */,
+                           ForwardIterator, ForwardIterator,
+                           cppsort::detail::difference_type_t<ForwardIterator>,
+                           Compare compare, Projection projection,
+                           const Sorter&, Call&& call, combined_values&)
+            -> void
+        {
+            std::forward<Call>(call)(std::move(compare), std::move(projection));
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Observing pass: the hardware counters are only opened
+        // when requested since it requires system calls
+
+        template<bool Enabled>
+        struct optional_hardware_counters
+        {
+            auto start() const noexcept
+                -> void
+            {}
+
+            auto stop() const noexcept
+                -> hardware_counters_values
+            {
+                return {};
+            }
+        };
+
+        template<>
+        struct optional_hardware_counters<true>
+        {
+            hardware_counters_group counters;
+
+            auto start() const noexcept
+                -> void
+            {
+                counters.start();
+            }
+
+            auto stop() const noexcept
+                -> hardware_counters_values
+            {
+                return counters.stop();
+            }
+        };
+
+        ////////////////////////////////////////////////////////////
+        // Serialize values to JSON
+
+        template<
+            typename Integer,
+            typename = cppsort::detail::enable_if_t<std::is_integral<Integer>::value>
+        >
+        auto write_json(std::ostream& stream, Integer value)
+            -> void
+        {
+            stream << value;
+        }
+
+        inline auto write_json(std::ostream& stream, bool value)
+            -> void
+        {
+            stream << (value ? "true" : "false");
+        }
+
+        // Durations are written as a number of nanoseconds
+        template<typename Rep, typename Period>
+        auto write_json(std::ostream& stream, std::chrono::duration<Rep, Period> value)
+            -> void
+        {
+            stream << std::chrono::duration_cast<std::chrono::nanoseconds>(value).count();
+        }
+
+        inline auto write_json(std::ostream& stream, const hardware_counter& value)
+            -> void
+        {
+            if (value.available) {
+                stream << value.value;
+            } else {
+                stream << "null";
+            }
+        }
+
+        // Write the members of an object, separated with commas
+        inline auto write_json_members(std::ostream&)
+            -> void
+        {}
+
+        template<typename T, typename... Args>
+        auto write_json_members(std::ostream& stream, const char* name, const T& value,
+                                const Args&... args)
+            -> void
+        {
+            stream << '"' << name << "\": ";
+            write_json(stream, value);
+            if (sizeof...(Args) > 0) {
+                stream << ", ";
+            }
+            write_json_members(stream, args...);
+        }
+
+        inline auto write_json(std::ostream& stream, const algorithm_events_values& value)
+            -> void
+        {
+            stream << '{';
+            write_json_members(stream,
+                "enabled", value.enabled,
+                "partitions", value.partitions,
+                "unbalanced_partitions", value.unbalanced_partitions,
+                "heapsort_fallbacks", value.heapsort_fallbacks,
+                "runs", value.runs,
+                "gallop_enters", value.gallop_enters,
+                "gallop_exits", value.gallop_exits,
+                "buffer_growths", value.buffer_growths,
+                "buffer_partial_growths", value.buffer_partial_growths,
+                "buffer_growth_failures", value.buffer_growth_failures
+            );
+            stream << '}';
+        }
+
+        inline auto write_json(std::ostream& stream, const allocations_values& value)
+            -> void
+        {
+            stream << '{';
+            write_json_members(stream,
+                "count", value.count,
+                "bytes", value.bytes,
+                "peak_bytes", value.peak_bytes
+            );
+            stream << '}';
+        }
+
+        inline auto write_json(std::ostream& stream, const hardware_counters_values& value)
+            -> void
+        {
+            stream << '{';
+            write_json_members(stream,
+                "cycles", value.cycles,
+                "instructions", value.instructions,
+                "l1d_misses", value.l1d_misses,
+                "llc_misses", value.llc_misses,
+                "branch_misses", value.branch_misses
+            );
+            stream << '}';
+        }
+
+        template<typename Tag, typename T>
+        auto write_json_metric(std::ostream& stream, const utility::metric<T, Tag>& metric,
+                               bool& first)
+            -> void
+        {
+            if (not first) {
+                stream << ", ";
+            }
+            first = false;
+            stream << '"' << combined_metric<Tag>::name() << "\": ";
+            write_json(stream, metric.value());
+        }
+
+        template<typename... TT, typename... Tags, std::size_t... Indices>
+        auto write_json_metrics(std::ostream& stream,
+                                const utility::metrics<utility::metric<TT, Tags>...>& mm,
+                                std::index_sequence<Indices...>)
+            -> void
+        {
+            using std::get;
+            bool first = true;
+            stream << '{';
+            int dummy[] = { 0, (write_json_metric(stream, get<Indices>(mm), first), 0)... };
+            (void) dummy;
+            stream << '}';
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Metric implementation
+
+        template<typename Sorter, typename... Tags>
+        struct combine_impl:
+            utility::adapter_storage<Sorter>,
+            cppsort::detail::check_iterator_category<Sorter>,
+            cppsort::detail::check_is_always_stable<Sorter>
+        {
+            template<typename Tag>
+            using has_tag = cppsort::detail::disjunction<std::is_same<Tag, Tags>...>;
+
+            // Metrics that need to wrap the compare function, projection
+            // or elements, and those that only observe the sorter
+            using needs_comparisons = has_tag<comparisons_tag>;
+            using needs_projections = has_tag<projections_tag>;
+            using needs_moves = has_tag<moves_tag>;
+            static constexpr bool needs_counting =
+                needs_comparisons::value || needs_projections::value || needs_moves::value;
+            static constexpr bool needs_observing = sizeof...(Tags) > (
+                std::size_t(needs_comparisons::value) +
+                std::size_t(needs_projections::value) +
+                std::size_t(needs_moves::value)
+            );
+
+            using metrics_t = utility::metrics<
+                utility::metric<typename combined_metric<Tags>::value_type, Tags>...
+            >;
+
+            combine_impl() = default;
+
+            constexpr explicit combine_impl(Sorter&& sorter):
+                utility::adapter_storage<Sorter>(std::move(sorter))
+            {}
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<is_projection_iterator_v<
+                    Projection, ForwardIterator, Compare
+                >>
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> metrics_t
+            {
+                return combine_algo(
+                    first, last, std::distance(first, last),
+                    std::move(compare), std::move(projection),
+                    [first] { return first; },
+                    [&](auto&& comp, auto&& proj) {
+                        this->get()(first, last,
+                                    std::forward<decltype(comp)>(comp),
+                                    std::forward<decltype(proj)>(proj));
+                    }
+                );
+            }
+
+            template<
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> metrics_t
+            {
+                return combine_algo(
+                    std::begin(iterable), std::end(iterable), utility::size(iterable),
+                    std::move(compare), std::move(projection),
+                    [&iterable] { return std::begin(iterable); },
+                    [&](auto&& comp, auto&& proj) {
+                        this->get()(iterable,
+                                    std::forward<decltype(comp)>(comp),
+                                    std::forward<decltype(proj)>(proj));
+                    }
+                );
+            }
+
+            private:
+
+                // begin() returns the current beginning of the collection,
+                // which is not first anymore after a container-aware sorter
+                // relinked the nodes of a list
+                template<typename ForwardIterator, typename Compare, typename Projection,
+                         typename Begin, typename Call>
+                auto combine_algo(ForwardIterator first, ForwardIterator last,
+                                  cppsort::detail::difference_type_t<ForwardIterator> size,
+                                  Compare compare, Projection projection,
+                                  Begin begin, Call call) const
+                    -> metrics_t
+                {
+                    combined_values values;
+                    run_passes(std::integral_constant<bool, needs_counting>{},
+                               std::integral_constant<bool, needs_observing>{},
+                               first, last, size, std::move(compare), std::move(projection),
+                               begin, call, values);
+
+                    return metrics_t(utility::metric<
+                        typename combined_metric<Tags>::value_type,
+                        Tags
+                    >(combined_value(values, Tags{}))...);
+                }
+
+                template<typename ForwardIterator, typename Compare, typename Projection,
+                         typename Begin, typename Call>
+                auto run_passes(std::true_type /* counting */, std::true_type /* observing */,
+                                ForwardIterator first, ForwardIterator last,
+                                cppsort::detail::difference_type_t<ForwardIterator> size,
+                                Compare compare, Projection projection,
+                                Begin& begin, Call& call, combined_values& values) const
+                    -> void
+                {
+                    // Count on the original values, then restore them so
+                    // that the observing pass sorts the same collection
+                    // without paying for the counting wrappers
+                    using value_type = cppsort::detail::value_type_t<ForwardIterator>;
+                    std::vector<value_type> original(first, last);
+                    counting_pass(first, last, size, compare, projection, call, values);
+                    std::copy(original.begin(), original.end(), begin());
+                    observing_pass(std::move(compare), std::move(projection), call, values);
+                }
+
+                template<typename ForwardIterator, typename Compare, typename Projection,
+                         typename Begin, typename Call>
+                auto run_passes(std::true_type /* counting */, std::false_type /* observing */,
+                                ForwardIterator first, ForwardIterator last,
+                                cppsort::detail::difference_type_t<ForwardIterator> size,
+                                Compare compare, Projection projection,
+                                Begin&, Call& call, combined_values& values) const
+                    -> void
+                {
+                    counting_pass(first, last, size, std::move(compare), std::move(projection),
+                                  call, values);
+                }
+
+                template<typename ForwardIterator, typename Compare, typename Projection,
+                         typename Begin, typename Call, bool Observing>
+                auto run_passes(std::false_type /* counting */,
+                                std::integral_constant<bool, Observing> /* observing */,
+                                ForwardIterator, ForwardIterator,
+                                cppsort::detail::difference_type_t<ForwardIterator>,
+                                Compare compare, Projection projection,
+                                Begin&, Call& call, combined_values& values) const
+                    -> void
+                {
+                    observing_pass(std::move(compare), std::move(projection), call, values);
+                }
+
+                template<typename ForwardIterator, typename Compare, typename Projection, typename Call>
+                auto counting_pass(ForwardIterator first, ForwardIterator last,
+                                   cppsort::detail::difference_type_t<ForwardIterator> size,
+                                   Compare compare, Projection projection,
+                                   Call& call, combined_values& values) const
+                    -> void
+                {
+                    counting_call(
+                        needs_moves{},
+                        first, last, size,
+                        counting_compare(std::move(compare), values.comparisons, needs_comparisons{}),
+                        counting_projection(std::move(projection), values.projections, needs_projections{}),
+                        this->get(), call, values
+                    );
+                }
+
+                template<typename Compare, typename Projection, typename Call>
+                auto observing_pass(Compare compare, Projection projection,
+                                    Call& call, combined_values& values) const
+                    -> void
+                {
+                    constexpr bool needs_cycles = has_tag<cpu_cycles_tag>::value;
+                    constexpr bool needs_time = has_tag<running_time_tag>::value;
+
+                    cppsort::detail::scratch_statistics statistics;
+                    cppsort::detail::algorithm_events events;
+                    std::uint64_t cycles_overhead = needs_cycles ? detail::cycles_overhead() : 0;
+                    optional_hardware_counters<has_tag<hardware_counters_tag>::value> counters;
+                    {
+                        cppsort::detail::scoped_scratch_statistics statistics_scope(statistics);
+                        cppsort::detail::scoped_algorithm_events events_scope(events);
+
+                        // The innermost measures are the most precise ones
+                        counters.start();
+                        std::uint64_t cycles_start = needs_cycles ? detail::cycles_start() : 0;
+                        auto time_start = needs_time ? std::chrono::steady_clock::now()
+                                                     : std::chrono::steady_clock::time_point{};
+                        call(std::move(compare), std::move(projection));
+                        if (needs_time) {
+                            values.running_time = std::chrono::steady_clock::now() - time_start;
+                        }
+                        if (needs_cycles) {
+                            auto cycles = detail::cycles_stop() - cycles_start;
+                            values.cpu_cycles = cycles > cycles_overhead ? cycles - cycles_overhead : 0;
+                        }
+                        values.hardware_counters = counters.stop();
+                    }
+
+                    values.allocations.count = statistics.allocations;
+                    values.allocations.bytes = statistics.bytes;
+                    values.allocations.peak_bytes = statistics.peak_bytes;
+
+                    values.algorithm_events.partitions = events.partitions;
+                    values.algorithm_events.unbalanced_partitions = events.unbalanced_partitions;
+                    values.algorithm_events.heapsort_fallbacks = events.heapsort_fallbacks;
+                    values.algorithm_events.runs = events.runs;
+                    values.algorithm_events.gallop_enters = events.gallop_enters;
+                    values.algorithm_events.gallop_exits = events.gallop_exits;
+                    values.algorithm_events.buffer_growths = events.buffer_growths;
+                    values.algorithm_events.buffer_partial_growths = events.buffer_partial_growths;
+                    values.algorithm_events.buffer_growth_failures = events.buffer_growth_failures;
+                }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Several metrics computed at once
+
+    template<typename Sorter, typename... Tags>
+    struct combine:
+        sorter_facade<detail::combine_impl<Sorter, Tags...>>
+    {
+        combine() = default;
+
+        constexpr explicit combine(Sorter sorter):
+            sorter_facade<detail::combine_impl<Sorter, Tags...>>(std::move(sorter))
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // JSON serialization of combined metrics
+
+    template<typename... TT, typename... Tags>
+    auto to_json(const utility::metrics<utility::metric<TT, Tags>...>& mm)
+        -> std::string
+    {
+        std::ostringstream stream;
+        detail::write_json_metrics(stream, mm, std::index_sequence_for<Tags...>{});
+        return stream.str();
+    }
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Tags, typename... Args>
+    struct is_stable<metrics::combine<Sorter, Tags...>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_COMBINE_H_
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2023-2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_CPU_CYCLES_H_
+#define CPPSORT_METRICS_CPU_CYCLES_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include "../detail/arguments_range.h"
+#include "../detail/checkers.h"
+#include "../detail/config.h"
+#include "../detail/iterator_traits.h"
+
+#if CPPSORT_TIME_STAMP_COUNTER_AVAILABLE
+#   if defined(_MSC_VER)
+#       include <intrin.h>
+#   else
+#       include <x86intrin.h>
+#   endif
+#endif
+
+namespace cppsort
+{
+namespace metrics
+{
+    ////////////////////////////////////////////////////////////
+    // Tag
+
+    struct cpu_cycles_tag {};
+
+    ////////////////////////////////////////////////////////////
+    // Result of repeated measures
+
+    struct cycles_statistics
+    {
+        std::uint64_t min = 0;
+        std::uint64_t median = 0;
+        std::uint64_t max = 0;
+
+        friend auto operator<<(std::ostream& stream, const cycles_statistics& stats)
+            -> std::ostream&
+        {
+            stream << "min: " << stats.min
+                   << ", median: " << stats.median
+                   << ", max: " << stats.max;
+            return stream;
+        }
+    };
+
+    namespace detail
+    {
+        ////////////////////////////////////////////////////////////
+        // Read the time-stamp counter
+
+#if CPPSORT_TIME_STAMP_COUNTER_AVAILABLE
+        inline auto cycles_start() noexcept
+            -> std::uint64_t
+        {
+            // Wait for the previous instructions to complete before
+            // reading the counter, and don't let the next ones start
+            // before it has been read
+            _mm_lfence();
+            std::uint64_t res = __rdtsc();
+            _mm_lfence();
+            return res;
+        }
+
+        inline auto cycles_stop() noexcept
+            -> std::uint64_t
+        {
+            // rdtscp already waits for the previous instructions
+            unsigned int aux;
+            std::uint64_t res = __rdtscp(&aux);
+            _mm_lfence();
+            return res;
+        }
+#else
+        // Fall back to the finest clock available elsewhere
+
+        inline auto cycles_start() noexcept
+            -> std::uint64_t
+        {
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            return static_cast<std::uint64_t>(now.count());
+        }
+
+        inline auto cycles_stop() noexcept
+            -> std::uint64_t
+        {
+            return cycles_start();
+        }
+#endif
+
+        // Smallest number of cycles measured when there is nothing
+        // to measure, computed once and subtracted from the results
+        inline auto cycles_overhead() noexcept
+            -> std::uint64_t
+        {
+            static const std::uint64_t overhead = [] {
+                auto res = (std::numeric_limits<std::uint64_t>::max)();
+                for (int i = 0 ; i < 64 ; ++i) {
+                    auto start = cycles_start();
+                    auto stop = cycles_stop();
+                    res = (std::min)(res, stop - start);
+                }
+                return res;
+            }();
+            return overhead;
+        }
+
+        template<typename Function>
+        auto measure_cycles(Function&& function)
+            -> std::uint64_t
+        {
+            auto overhead = cycles_overhead();
+            auto start = cycles_start();
+            std::forward<Function>(function)();
+            auto stop = cycles_stop();
+            auto res = stop - start;
+            return res > overhead ? res - overhead : 0;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Metric
+
+    template<typename Sorter, std::size_t Repetitions>
+    struct cpu_cycles:
+        utility::adapter_storage<Sorter>,
+        cppsort::detail::check_iterator_category<Sorter>,
+        cppsort::detail::check_is_always_stable<Sorter>
+    {
+        static_assert(Repetitions > 0, "cpu_cycles needs to sort at least once");
+
+        using tag_t = cpu_cycles_tag;
+        using value_t = std::conditional_t<
+            Repetitions == 1,
+            std::uint64_t,
+            cycles_statistics
+        >;
+        using metric_t = utility::metric<value_t, tag_t>;
+
+        cpu_cycles() = default;
+
+        constexpr explicit cpu_cycles(Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter))
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(
+                this->get()(std::forward<Args>(args)...),
+                metric_t(std::declval<value_t>())
+            )
+        {
+            return measure(std::integral_constant<bool, Repetitions == 1>{},
+                           std::forward<Args>(args)...);
+        }
+
+        private:
+
+            template<typename... Args>
+            auto measure(std::true_type /* once */, Args&&... args) const
+                -> metric_t
+            {
+                return metric_t(detail::measure_cycles([&] {
+                    this->get()(std::forward<Args>(args)...);
+                }));
+            }
+
+            template<typename... Args>
+            auto measure(std::false_type /* once */, Args&&... args) const
+                -> metric_t
+            {
+                // Every repetition sorts a copy of the original collection
+                auto range = cppsort::detail::arguments_range(args...);
+                using value_type = cppsort::detail::value_type_t<decltype(range.first)>;
+                std::vector<value_type> original(range.first, range.second);
+
+                std::array<std::uint64_t, Repetitions> cycles;
+                for (auto& value: cycles) {
+                    // A container-aware sorter might have relinked the nodes
+                    // of a list, the beginning has to be computed again
+                    std::copy(original.begin(), original.end(),
+                              cppsort::detail::arguments_range(args...).first);
+                    value = detail::measure_cycles([&] {
+                        this->get()(args...);
+                    });
+                }
+
+                std::sort(cycles.begin(), cycles.end());
+                cycles_statistics res;
+                res.min = cycles.front();
+                res.median = cycles[Repetitions / 2];
+                res.max = cycles.back();
+                return metric_t(res);
+            }
+    };
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, std::size_t Repetitions, typename... Args>
+    struct is_stable<metrics::cpu_cycles<Sorter, Repetitions>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_CPU_CYCLES_H_
@@ -0,0 +1,336 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_HARDWARE_COUNTERS_H_
+#define CPPSORT_METRICS_HARDWARE_COUNTERS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include "../detail/checkers.h"
+#include "../detail/config.h"
+
+#if CPPSORT_HARDWARE_COUNTERS_AVAILABLE
+#   include <cstring>
+#   include <linux/perf_event.h>
+#   include <sys/ioctl.h>
+#   include <sys/syscall.h>
+#   include <unistd.h>
+#endif
+
+namespace cppsort
+{
+namespace metrics
+{
+    ////////////////////////////////////////////////////////////
+    // Tag
+
+    struct hardware_counters_tag {};
+
+    ////////////////////////////////////////////////////////////
+    // Values of the counters
+
+    struct hardware_counter
+    {
+        // Whether the counter could be read, it might not be
+        // the case on some platforms, in virtual machines and
+        // containers, or because of the system's permissions
+        bool available = false;
+        std::uint64_t value = 0;
+    };
+
+    struct hardware_counters_values
+    {
+        hardware_counter cycles;
+        hardware_counter instructions;
+        hardware_counter l1d_misses;
+        hardware_counter llc_misses;
+        hardware_counter branch_misses;
+
+        friend auto operator<<(std::ostream& stream, const hardware_counters_values& values)
+            -> std::ostream&
+        {
+            auto print = [&stream](const char* name, const hardware_counter& counter) {
+                stream << name << ": ";
+                if (counter.available) {
+                    stream << counter.value;
+                } else {
+                    stream << "n/a";
+                }
+            };
+            print("cycles", values.cycles);
+            stream << ", ";
+            print("instructions", values.instructions);
+            stream << ", ";
+            print("L1d misses", values.l1d_misses);
+            stream << ", ";
+            print("LLC misses", values.llc_misses);
+            stream << ", ";
+            print("branch misses", values.branch_misses);
+            return stream;
+        }
+    };
+
+    namespace detail
+    {
+#if CPPSORT_HARDWARE_COUNTERS_AVAILABLE
+        ////////////////////////////////////////////////////////////
+        // RAII wrapper around a group of perf_event file descriptors
+        //
+        // The first event that could be opened leads the group: the
+        // kernel schedules all the events of a group together, so
+        // they are started, stopped and multiplexed at the same time,
+        // and their values are read at once from the leader
+
+        class perf_event_group
+        {
+            public:
+
+                static constexpr std::size_t max_events = 5;
+
+                perf_event_group() = default;
+                perf_event_group(const perf_event_group&) = delete;
+                perf_event_group& operator=(const perf_event_group&) = delete;
+
+                ~perf_event_group()
+                {
+                    // Close the leader last
+                    while (size_ > 0) {
+                        ::close(fds_[--size_]);
+                    }
+                }
+
+                // Opens an event in the group and returns its position
+                // in the values read, or -1 if it could not be opened
+                auto add(std::uint32_t type, std::uint64_t config) noexcept
+                    -> int
+                {
+                    if (size_ == max_events) {
+                        return -1;
+                    }
+
+                    perf_event_attr attr;
+                    std::memset(&attr, 0, sizeof(attr));
+                    attr.size = sizeof(attr);
+                    attr.type = type;
+                    attr.config = config;
+                    // The leader enables and disables the whole group
+                    attr.disabled = size_ == 0 ? 1 : 0;
+                    // Only count what the sorter does, which also makes
+                    // the counters available with a stricter value of
+                    // perf_event_paranoid
+                    attr.exclude_kernel = 1;
+                    attr.exclude_hv = 1;
+                    // Needed to scale the results when the kernel has to
+                    // multiplex more events than there are counters
+                    attr.read_format = PERF_FORMAT_GROUP
+                                     | PERF_FORMAT_TOTAL_TIME_ENABLED
+                                     | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+                    int group_fd = size_ == 0 ? -1 : fds_[0];
+                    auto fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+                    if (fd == -1) {
+                        // Not supported, not allowed, or can't be scheduled
+                        // alongside the events already in the group
+                        return -1;
+                    }
+                    fds_[size_] = fd;
+                    return static_cast<int>(size_++);
+                }
+
+                auto start() const noexcept
+                    -> void
+                {
+                    if (size_ > 0) {
+                        ::ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+                        ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+                    }
+                }
+
+                auto stop() const noexcept
+                    -> void
+                {
+                    if (size_ > 0) {
+                        ::ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+                    }
+                }
+
+                // Reads the values of the events in the order they were
+                // added, returns false if they are not available
+                auto read(std::uint64_t (&values)[max_events]) const noexcept
+                    -> bool
+                {
+                    if (size_ == 0) {
+                        return false;
+                    }
+
+                    // number of events, time enabled, time running, values
+                    std::uint64_t data[3 + max_events] = {};
+                    auto expected = static_cast<ssize_t>((3 + size_) * sizeof(std::uint64_t));
+                    if (::read(fds_[0], data, sizeof(data)) != expected || data[0] != size_) {
+                        return false;
+                    }
+                    if (data[2] == 0) {
+                        // The group was never scheduled on the hardware
+                        return false;
+                    }
+
+                    for (std::size_t idx = 0 ; idx < size_ ; ++idx) {
+                        values[idx] = data[3 + idx];
+                        if (data[2] < data[1]) {
+                            values[idx] = static_cast<std::uint64_t>(
+                                static_cast<double>(data[3 + idx])
+                                * static_cast<double>(data[1]) / static_cast<double>(data[2])
+                            );
+                        }
+                    }
+                    return true;
+                }
+
+            private:
+
+                int fds_[max_events] = {};
+                std::size_t size_ = 0;
+        };
+
+        constexpr auto cache_miss_config(std::uint64_t cache) noexcept
+            -> std::uint64_t
+        {
+            return cache
+                | (std::uint64_t(PERF_COUNT_HW_CACHE_OP_READ) << 8)
+                | (std::uint64_t(PERF_COUNT_HW_CACHE_RESULT_MISS) << 16);
+        }
+
+        class hardware_counters_group
+        {
+            public:
+
+                hardware_counters_group() noexcept:
+                    cycles_(events_.add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES)),
+                    instructions_(events_.add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS)),
+                    l1d_misses_(events_.add(PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_L1D))),
+                    llc_misses_(events_.add(PERF_TYPE_HW_CACHE, cache_miss_config(PERF_COUNT_HW_CACHE_LL))),
+                    branch_misses_(events_.add(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES))
+                {}
+
+                auto start() const noexcept
+                    -> void
+                {
+                    events_.start();
+                }
+
+                auto stop() const noexcept
+                    -> hardware_counters_values
+                {
+                    events_.stop();
+
+                    hardware_counters_values res;
+                    std::uint64_t values[perf_event_group::max_events] = {};
+                    if (not events_.read(values)) {
+                        return res;
+                    }
+
+                    auto get = [&values](int position) {
+                        hardware_counter counter;
+                        if (position != -1) {
+                            counter.available = true;
+                            counter.value = values[static_cast<std::size_t>(position)];
+                        }
+                        return counter;
+                    };
+                    res.cycles = get(cycles_);
+                    res.instructions = get(instructions_);
+                    res.l1d_misses = get(l1d_misses_);
+                    res.llc_misses = get(llc_misses_);
+                    res.branch_misses = get(branch_misses_);
+                    return res;
+                }
+
+            private:
+
+                perf_event_group events_;
+                // Positions of the counters in the group, -1 when they
+                // could not be opened
+                int cycles_;
+                int instructions_;
+                int l1d_misses_;
+                int llc_misses_;
+                int branch_misses_;
+        };
+#else
+        ////////////////////////////////////////////////////////////
+        // No hardware counters available
+
+        class hardware_counters_group
+        {
+            public:
+
+                auto start() const noexcept
+                    -> void
+                {}
+
+                auto stop() const noexcept
+                    -> hardware_counters_values
+                {
+                    return {};
+                }
+        };
+#endif
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Metric
+
+    template<typename Sorter>
+    struct hardware_counters:
+        utility::adapter_storage<Sorter>,
+        cppsort::detail::check_iterator_category<Sorter>,
+        cppsort::detail::check_is_always_stable<Sorter>
+    {
+        using tag_t = hardware_counters_tag;
+        using metric_t = utility::metric<hardware_counters_values, tag_t>;
+
+        hardware_counters() = default;
+
+        constexpr explicit hardware_counters(Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter))
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(
+                this->get()(std::forward<Args>(args)...),
+                metric_t(std::declval<hardware_counters_values>())
+            )
+        {
+            // The counters are opened before starting to count so
+            // that the cost of the system calls is not measured
+            detail::hardware_counters_group counters;
+            counters.start();
+            this->get()(std::forward<Args>(args)...);
+            return metric_t(counters.stop());
+        }
+    };
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<metrics::hardware_counters<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_HARDWARE_COUNTERS_H_
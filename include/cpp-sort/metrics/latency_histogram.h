@@ -0,0 +1,353 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_METRICS_LATENCY_HISTOGRAM_H_
+#define CPPSORT_METRICS_LATENCY_HISTOGRAM_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <utility>
+#include <vector>
+#include <cpp-sort/fwd.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/metrics_tools.h>
+#include "../detail/arguments_range.h"
+#include "../detail/bitops.h"
+#include "../detail/checkers.h"
+
+namespace cppsort
+{
+namespace metrics
+{
+    ////////////////////////////////////////////////////////////
+    // Tag
+
+    struct latency_histogram_tag {};
+
+    ////////////////////////////////////////////////////////////
+    // Layout of the histogram
+
+    namespace detail
+    {
+        // Collections of size 0 go in the size class 0, then
+        // the size class N holds the collections whose size is
+        // in [2^(N-1), 2^N), the last one holding the bigger ones
+        constexpr std::size_t latency_size_classes = 32;
+
+        // Log-linear buckets: values under 2^sub_bits have their own
+        // bucket, then every power of 2 up to 2^max_exponent is split
+        // into 2^sub_bits buckets, which bounds the relative error of
+        // the recorded values to 1/2^sub_bits; the last bucket is the
+        // last sub-bucket of 2^max_exponent, so it holds durations of
+        // 2^max_exponent + 15 * 2^(max_exponent - sub_bits) ns or more
+        // (about 35 minutes)
+        constexpr unsigned latency_sub_bits = 4;
+        constexpr std::uint64_t latency_sub_buckets = 1u << latency_sub_bits;
+        constexpr unsigned latency_max_exponent = 40;
+        constexpr std::size_t latency_buckets =
+            (latency_max_exponent - latency_sub_bits + 2) * latency_sub_buckets;
+
+        template<typename Integer>
+        constexpr auto latency_size_class(Integer size) noexcept
+            -> std::size_t
+        {
+            if (size == 0) {
+                return 0;
+            }
+            std::size_t res = cppsort::detail::log2(static_cast<std::uint64_t>(size)) + 1;
+            return res < latency_size_classes ? res : latency_size_classes - 1;
+        }
+
+        constexpr auto latency_bucket(std::uint64_t nanoseconds) noexcept
+            -> std::size_t
+        {
+            if (nanoseconds < latency_sub_buckets) {
+                return nanoseconds;
+            }
+            auto exponent = static_cast<unsigned>(cppsort::detail::log2(nanoseconds));
+            if (exponent > latency_max_exponent) {
+                return latency_buckets - 1;
+            }
+            auto sub_bucket = (nanoseconds >> (exponent - latency_sub_bits)) & (latency_sub_buckets - 1);
+            return (exponent - latency_sub_bits + 1) * latency_sub_buckets + sub_bucket;
+        }
+
+        // Highest duration that falls into a given bucket
+        constexpr auto latency_bucket_max(std::size_t bucket) noexcept
+            -> std::uint64_t
+        {
+            if (bucket < latency_sub_buckets) {
+                return bucket;
+            }
+            auto exponent = static_cast<unsigned>(bucket / latency_sub_buckets) + latency_sub_bits - 1;
+            std::uint64_t sub_bucket = bucket % latency_sub_buckets;
+            auto width = std::uint64_t(1) << (exponent - latency_sub_bits);
+            return (latency_sub_buckets + sub_bucket) * width + width - 1;
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Counters shared by all the copies of a metric, allocated
+        // once so that recording a call never allocates
+
+        struct latency_counters
+        {
+            std::array<
+                std::array<std::atomic<std::uint64_t>, latency_buckets>,
+                latency_size_classes
+            > counts;
+
+            latency_counters() noexcept
+            {
+                reset();
+            }
+
+            auto record(std::size_t size_class, std::uint64_t nanoseconds) noexcept
+                -> void
+            {
+                counts[size_class][latency_bucket(nanoseconds)]
+                    .fetch_add(1, std::memory_order_relaxed);
+            }
+
+            auto reset() noexcept
+                -> void
+            {
+                for (auto& size_class: counts) {
+                    for (auto& count: size_class) {
+                        count.store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Copy of the histogram at a given point in time
+
+    class latency_histogram_snapshot
+    {
+        public:
+
+            static constexpr std::size_t size_classes = detail::latency_size_classes;
+
+            latency_histogram_snapshot():
+                counts_(detail::latency_size_classes * detail::latency_buckets, 0)
+            {}
+
+            explicit latency_histogram_snapshot(const detail::latency_counters& counters):
+                counts_()
+            {
+                counts_.reserve(detail::latency_size_classes * detail::latency_buckets);
+                for (auto& size_class: counters.counts) {
+                    for (auto& count: size_class) {
+                        counts_.push_back(count.load(std::memory_order_relaxed));
+                    }
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Size classes
+
+            template<typename Integer>
+            static constexpr auto size_class_of(Integer size) noexcept
+                -> std::size_t
+            {
+                return detail::latency_size_class(size);
+            }
+
+            // Smallest collection size in a size class
+            static constexpr auto size_class_min(std::size_t size_class) noexcept
+                -> std::uint64_t
+            {
+                return size_class == 0 ? 0 : std::uint64_t(1) << (size_class - 1);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Number of recorded calls
+
+            auto count() const noexcept
+                -> std::uint64_t
+            {
+                std::uint64_t res = 0;
+                for (auto value: counts_) {
+                    res += value;
+                }
+                return res;
+            }
+
+            auto count(std::size_t size_class) const noexcept
+                -> std::uint64_t
+            {
+                std::uint64_t res = 0;
+                for (std::size_t bucket = 0 ; bucket < detail::latency_buckets ; ++bucket) {
+                    res += at(size_class, bucket);
+                }
+                return res;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Percentiles, p in [0, 1]: the returned duration is at
+            // least as big as the p-quantile of the recorded calls, and
+            // at most 1/16th bigger, or zero when nothing was recorded
+
+            auto percentile(double p) const noexcept
+                -> std::chrono::nanoseconds
+            {
+                return percentile_in(p, 0, detail::latency_size_classes);
+            }
+
+            auto percentile(double p, std::size_t size_class) const noexcept
+                -> std::chrono::nanoseconds
+            {
+                return percentile_in(p, size_class, size_class + 1);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Print the non-empty size classes
+
+            friend auto operator<<(std::ostream& stream, const latency_histogram_snapshot& snapshot)
+                -> std::ostream&
+            {
+                for (std::size_t size_class = 0 ; size_class < detail::latency_size_classes ; ++size_class) {
+                    auto count = snapshot.count(size_class);
+                    if (count == 0) {
+                        continue;
+                    }
+                    stream << "size >= " << size_class_min(size_class)
+                           << ": count: " << count
+                           << ", p50: " << snapshot.percentile(0.5, size_class).count() << "ns"
+                           << ", p99: " << snapshot.percentile(0.99, size_class).count() << "ns"
+                           << ", p999: " << snapshot.percentile(0.999, size_class).count() << "ns"
+                           << '\n';
+                }
+                return stream;
+            }
+
+        private:
+
+            auto at(std::size_t size_class, std::size_t bucket) const noexcept
+                -> std::uint64_t
+            {
+                return counts_[size_class * detail::latency_buckets + bucket];
+            }
+
+            auto percentile_in(double p, std::size_t first_class, std::size_t last_class) const noexcept
+                -> std::chrono::nanoseconds
+            {
+                std::uint64_t total = 0;
+                for (auto size_class = first_class ; size_class < last_class ; ++size_class) {
+                    total += count(size_class);
+                }
+                if (total == 0) {
+                    return std::chrono::nanoseconds(0);
+                }
+
+                // Nearest rank of the value to find, in [1, total]: rounding
+                // up never picks a value below the p-quantile, the tiny
+                // correction avoids skipping a rank when p * total is an
+                // integer that floating point arithmetic made a bit bigger
+                p = p < 0.0 ? 0.0 : (p > 1.0 ? 1.0 : p);
+                auto rank = static_cast<std::uint64_t>(
+                    std::ceil(p * static_cast<double>(total) * (1.0 - 1e-12))
+                );
+                rank = rank == 0 ? 1 : (rank > total ? total : rank);
+
+                std::uint64_t seen = 0;
+                for (std::size_t bucket = 0 ; bucket < detail::latency_buckets ; ++bucket) {
+                    for (auto size_class = first_class ; size_class < last_class ; ++size_class) {
+                        seen += at(size_class, bucket);
+                    }
+                    if (seen >= rank) {
+                        auto value = detail::latency_bucket_max(bucket);
+                        return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(value));
+                    }
+                }
+                auto value = detail::latency_bucket_max(detail::latency_buckets - 1);
+                return std::chrono::nanoseconds(static_cast<std::chrono::nanoseconds::rep>(value));
+            }
+
+            std::vector<std::uint64_t> counts_;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Metric
+
+    template<typename Sorter>
+    struct latency_histogram:
+        utility::adapter_storage<Sorter>,
+        cppsort::detail::check_iterator_category<Sorter>,
+        cppsort::detail::check_is_always_stable<Sorter>
+    {
+        using tag_t = latency_histogram_tag;
+        using metric_t = utility::metric<std::chrono::nanoseconds, tag_t>;
+
+        latency_histogram():
+            utility::adapter_storage<Sorter>(),
+            counters_(std::make_shared<detail::latency_counters>())
+        {}
+
+        explicit latency_histogram(Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter)),
+            counters_(std::make_shared<detail::latency_counters>())
+        {}
+
+        template<typename... Args>
+        auto operator()(Args&&... args) const
+            -> decltype(
+                this->get()(std::forward<Args>(args)...),
+                metric_t(std::declval<std::chrono::nanoseconds>())
+            )
+        {
+            auto size_class = detail::latency_size_class(cppsort::detail::arguments_size(args...));
+            auto start = std::chrono::steady_clock::now();
+            this->get()(std::forward<Args>(args)...);
+            auto stop = std::chrono::steady_clock::now();
+
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
+            counters_->record(size_class, static_cast<std::uint64_t>(duration.count()));
+            return metric_t(duration);
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Access the histogram shared by all the copies
+
+        auto snapshot() const
+            -> latency_histogram_snapshot
+        {
+            return latency_histogram_snapshot(*counters_);
+        }
+
+        auto reset() const noexcept
+            -> void
+        {
+            counters_->reset();
+        }
+
+        private:
+
+            std::shared_ptr<detail::latency_counters> counters_;
+    };
+}}
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // is_stable specialization
+
+    template<typename Sorter, typename... Args>
+    struct is_stable<metrics::latency_histogram<Sorter>(Args...)>:
+        is_stable<Sorter(Args...)>
+    {};
+}
+
+#endif // CPPSORT_METRICS_LATENCY_HISTOGRAM_H_
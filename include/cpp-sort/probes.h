@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2016-2021 Morwenn
+ * Copyright (c) 2016-2024 Morwenn
  * SPDX-License-Identifier: MIT
  */
 #ifndef CPPSORT_PROBES_H_
@@ -18,8 +18,12 @@
 #include <cpp-sort/probes/mono.h>
 #include <cpp-sort/probes/osc.h>
 #include <cpp-sort/probes/par.h>
+#include <cpp-sort/probes/profile.h>
 #include <cpp-sort/probes/rem.h>
 #include <cpp-sort/probes/runs.h>
+#include <cpp-sort/probes/sampled_inv.h>
+#include <cpp-sort/probes/sampled_osc.h>
+#include <cpp-sort/probes/sampled_rem.h>
 #include <cpp-sort/probes/sus.h>
 
 #endif // CPPSORT_PROBES_H_
@@ -28,16 +28,49 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto block_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        template<
+            typename ForwardIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto block_from_sorted(ForwardIterator last,
+                               RandomAccessIterator sorted_first, RandomAccessIterator sorted_last,
+                               Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
+            ////////////////////////////////////////////////////////////
+            // Count the number of consecutive pairs in the original
+            // collection that can't be found in the sorted one
+
+            difference_type count = 0;
+            auto it_last_1 = std::prev(sorted_last);
+            for (auto it = sorted_first; it != it_last_1; ++it) {
+                auto orig_next = std::next(*it);
+                if (orig_next == last) {
+                    if (comp(proj(**it), proj(**it_last_1)) || comp(proj(**it_last_1), proj(**it))) {
+                        ++count;
+                    }
+                    continue;
+                }
+                auto sorted_next = *std::next(it);
+                if (comp(proj(*orig_next), proj(*sorted_next)) || comp(proj(*sorted_next), proj(*orig_next))) {
+                    ++count;
+                }
+            }
+            return count;
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto block_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
             if (size < 2) {
                 return 0;
             }
@@ -57,26 +90,8 @@ namespace probe
                 compare, utility::indirect{} | projection
             );
 
-            ////////////////////////////////////////////////////////////
-            // Count the number of consecutive pairs in the original
-            // collection that can't be found in the sorted one
-
-            difference_type count = 0;
-            auto it_last_1 = std::prev(iterators.end());
-            for (auto it = iterators.begin(); it != it_last_1; ++it) {
-                auto orig_next = std::next(*it);
-                if (orig_next == last) {
-                    if (comp(proj(**it), proj(**it_last_1)) || comp(proj(**it_last_1), proj(**it))) {
-                        ++count;
-                    }
-                    continue;
-                }
-                auto sorted_next = *std::next(it);
-                if (comp(proj(*orig_next), proj(*sorted_next)) || comp(proj(*sorted_next), proj(*orig_next))) {
-                    ++count;
-                }
-            }
-            return count;
+            return block_from_sorted(last, iterators.begin(), iterators.end(),
+                                     std::move(compare), std::move(projection));
         }
 
         struct block_impl
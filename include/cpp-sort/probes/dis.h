@@ -56,34 +56,25 @@ namespace probe
             return res;
         }
 
-        template<typename BidirectionalIterator, typename Compare, typename Projection>
-        auto allocating_dis_probe_algo(BidirectionalIterator first, BidirectionalIterator last,
-                                       cppsort::detail::difference_type_t<BidirectionalIterator> size,
-                                       Compare compare, Projection projection)
+        template<
+            typename BidirectionalIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto dis_from_cummax(BidirectionalIterator last,
+                             cppsort::detail::difference_type_t<BidirectionalIterator> size,
+                             RandomAccessIterator lr_cummax,
+                             Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<BidirectionalIterator>
         {
+            // Takes the result of algorithm LR: iterators to the cumulative
+            // max of the collection from left to right
+
             using difference_type = ::cppsort::detail::difference_type_t<BidirectionalIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
-            // Space-optimized version of the algorithm described in *Roughly Sorting:
-            // Sequential and Parallel Approach* by T. Altman and Y. Igarashi
-
-            if (size < 2) {
-                return 0;
-            }
-
-            // Algorithm LR: cumulative max from left to right
-            cppsort::detail::immovable_vector<BidirectionalIterator> lr_cummax(size);
-            lr_cummax.emplace_back(first);
-            for (auto it = std::next(first); it != last; ++it) {
-                if (comp(proj(*lr_cummax.back()), proj(*it))) {
-                    lr_cummax.emplace_back(it);
-                } else {
-                    lr_cummax.emplace_back(lr_cummax.back());
-                }
-            }
-
             // Merged algorithms without extra storage:
             // - RL: cumulative min from right to left
             // - DM: max distance of an inversion
@@ -110,6 +101,37 @@ namespace probe
             return res;
         }
 
+        template<typename BidirectionalIterator, typename Compare, typename Projection>
+        auto allocating_dis_probe_algo(BidirectionalIterator first, BidirectionalIterator last,
+                                       cppsort::detail::difference_type_t<BidirectionalIterator> size,
+                                       Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<BidirectionalIterator>
+        {
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            // Space-optimized version of the algorithm described in *Roughly Sorting:
+            // Sequential and Parallel Approach* by T. Altman and Y. Igarashi
+
+            if (size < 2) {
+                return 0;
+            }
+
+            // Algorithm LR: cumulative max from left to right
+            cppsort::detail::immovable_vector<BidirectionalIterator> lr_cummax(size);
+            lr_cummax.emplace_back(first);
+            for (auto it = std::next(first); it != last; ++it) {
+                if (comp(proj(*lr_cummax.back()), proj(*it))) {
+                    lr_cummax.emplace_back(it);
+                } else {
+                    lr_cummax.emplace_back(lr_cummax.back());
+                }
+            }
+
+            return dis_from_cummax(last, size, lr_cummax.begin(),
+                                   std::move(compare), std::move(projection));
+        }
+
         template<typename BidirectionalIterator, typename Compare, typename Projection>
         auto dis_probe_algo(BidirectionalIterator first, BidirectionalIterator last,
                             cppsort::detail::difference_type_t<BidirectionalIterator> size,
@@ -11,7 +11,6 @@
 #include <functional>
 #include <iterator>
 #include <utility>
-#include <vector>
 #include <cpp-sort/comparators/flip.h>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
@@ -21,6 +20,7 @@
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/iterator_traits.h"
 #include "../detail/lower_bound.h"
+#include "../detail/memory.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -30,10 +30,10 @@ namespace probe
     namespace detail
     {
         template<typename ForwardIterator, typename T, typename Compare, typename Projection>
-        auto enc_lower_bound(std::vector<std::pair<ForwardIterator, ForwardIterator>>& lists,
+        auto enc_lower_bound(cppsort::detail::scratch_vector<std::pair<ForwardIterator, ForwardIterator>>& lists,
                              T& value, Compare compare, Projection projection,
                              ForwardIterator std::pair<ForwardIterator, ForwardIterator>::* accessor)
-            -> typename std::vector<std::pair<ForwardIterator, ForwardIterator>>::iterator
+            -> typename cppsort::detail::scratch_vector<std::pair<ForwardIterator, ForwardIterator>>::iterator
         {
             using value_type = cppsort::detail::value_type_t<ForwardIterator>;
             using projected_type = cppsort::detail::projected_t<ForwardIterator, Projection>;
@@ -78,7 +78,7 @@ namespace probe
                 }
 
                 // Heads an tails of encroaching lists
-                std::vector<std::pair<ForwardIterator, ForwardIterator>> lists;
+                cppsort::detail::scratch_vector<std::pair<ForwardIterator, ForwardIterator>> lists;
                 lists.emplace_back(first, first);
                 ++first;
 
@@ -0,0 +1,28 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_ESTIMATE_H_
+#define CPPSORT_PROBES_ESTIMATE_H_
+
+namespace cppsort
+{
+namespace probe
+{
+    ////////////////////////////////////////////////////////////
+    // Result of an approximate measure of presortedness
+    //
+    // The actual value of the measure lies in [lower, upper]
+    // with the probability requested when computing the
+    // estimate, and value is the best guess for it
+
+    template<typename Integer>
+    struct estimate
+    {
+        Integer value;
+        Integer lower;
+        Integer upper;
+    };
+}}
+
+#endif // CPPSORT_PROBES_ESTIMATE_H_
@@ -11,7 +11,6 @@
 #include <functional>
 #include <iterator>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
@@ -20,6 +19,7 @@
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/immovable_vector.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/pdqsort.h"
 #include "../detail/type_traits.h"
 
@@ -29,39 +29,26 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto exc_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        template<
+            typename ForwardIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto exc_from_sorted(ForwardIterator first, ForwardIterator last,
+                             cppsort::detail::difference_type_t<ForwardIterator> size,
+                             RandomAccessIterator sorted_first,
+                             Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
-            if (size < 2) {
-                return 0;
-            }
-
-            ////////////////////////////////////////////////////////////
-            // Indirectly sort the iterators
-
-            // Copy the iterators in a vector
-            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
-            for (auto it = first; it != last; ++it) {
-                iterators.emplace_back(it);
-            }
-
-            // Sort the iterators on pointed values
-            cppsort::detail::pdqsort(
-                iterators.begin(), iterators.end(),
-                compare, utility::indirect{} | projection
-            );
-
             ////////////////////////////////////////////////////////////
             // Count the number of cycles
 
-            std::vector<bool> sorted(size, false);
+            cppsort::detail::scratch_vector<bool> sorted(size, false);
 
             // Element where the current cycle starts
             auto start = first;
@@ -71,7 +58,7 @@ namespace probe
                 // Find the element to put in current's place
                 auto current = start;
                 auto next_pos = std::distance(first, current);
-                auto next = iterators[next_pos];
+                auto next = sorted_first[next_pos];
                 sorted[next_pos] = true;
 
                 // Process the current cycle
@@ -89,7 +76,7 @@ namespace probe
                         // Locate the next element of the cycle
                         current = next;
                         auto next_pos = std::distance(first, next);
-                        next = iterators[next_pos];
+                        next = sorted_first[next_pos];
                         sorted[next_pos] = true;
                     }
                 }
@@ -106,6 +93,35 @@ namespace probe
             return size - cycles;
         }
 
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto exc_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            if (size < 2) {
+                return 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Indirectly sort the iterators
+
+            // Copy the iterators in a vector
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            for (auto it = first; it != last; ++it) {
+                iterators.emplace_back(it);
+            }
+
+            // Sort the iterators on pointed values
+            cppsort::detail::pdqsort(
+                iterators.begin(), iterators.end(),
+                compare, utility::indirect{} | projection
+            );
+
+            return exc_from_sorted(first, last, size, iterators.begin(),
+                                   std::move(compare), std::move(projection));
+        }
+
         struct exc_impl
         {
             template<
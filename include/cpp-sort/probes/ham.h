@@ -28,16 +28,41 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto ham_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        template<
+            typename ForwardIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto ham_from_sorted(ForwardIterator first,
+                             RandomAccessIterator sorted_first, RandomAccessIterator sorted_last,
+                             Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
+            ////////////////////////////////////////////////////////////
+            // Count the number of values not in place
+
+            difference_type count = 0;
+            for (auto it = sorted_first; it != sorted_last; ++it) {
+                if (comp(proj(*first), proj(**it)) ||
+                    comp(proj(**it), proj(*first))) {
+                    ++count;
+                }
+                ++first;
+            }
+            return count;
+        }
+
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto ham_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
             if (size < 2) {
                 return 0;
             }
@@ -57,18 +82,8 @@ namespace probe
                 compare, utility::indirect{} | projection
             );
 
-            ////////////////////////////////////////////////////////////
-            // Count the number of values not in place
-
-            difference_type count = 0;
-            for (auto&& it: iterators) {
-                if (comp(proj(*first), proj(*it)) ||
-                    comp(proj(*it), proj(*first))) {
-                    ++count;
-                }
-                ++first;
-            }
-            return count;
+            return ham_from_sorted(first, iterators.begin(), iterators.end(),
+                                   std::move(compare), std::move(projection));
         }
 
         struct ham_impl
@@ -10,7 +10,6 @@
 ////////////////////////////////////////////////////////////
 #include <functional>
 #include <iterator>
-#include <memory>
 #include <utility>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
@@ -19,6 +18,7 @@
 #include <cpp-sort/utility/static_const.h>
 #include "../detail/count_inversions.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/type_traits.h"
 
 namespace cppsort
@@ -39,16 +39,16 @@ namespace probe
                 return 0;
             }
 
-            auto iterators = std::make_unique<ForwardIterator[]>(size);
-            auto buffer = std::make_unique<ForwardIterator[]>(size);
+            cppsort::detail::scratch_vector<ForwardIterator> iterators(size);
+            cppsort::detail::scratch_vector<ForwardIterator> buffer(size);
 
-            auto store = iterators.get();
+            auto store = iterators.data();
             for (auto it = first; it != last; ++it) {
                 *store++ = it;
             }
 
             return cppsort::detail::count_inversions<difference_type>(
-                iterators.get(), iterators.get() + size, buffer.get(),
+                iterators.data(), iterators.data() + size, buffer.data(),
                 std::move(compare),
                 utility::indirect{} | std::move(projection)
             );
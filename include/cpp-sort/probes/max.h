@@ -30,34 +30,20 @@ namespace probe
 {
     namespace detail
     {
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto max_probe_algo(ForwardIterator first, ForwardIterator last,
-                            cppsort::detail::difference_type_t<ForwardIterator> size,
-                            Compare compare, Projection projection)
+        template<
+            typename ForwardIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto max_from_sorted(ForwardIterator first, ForwardIterator last,
+                             RandomAccessIterator sorted_first, RandomAccessIterator sorted_last,
+                             Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& proj = utility::as_function(projection);
 
-            if (size < 2) {
-                return 0;
-            }
-
-            ////////////////////////////////////////////////////////////
-            // Indirectly sort the iterators
-
-            // Copy the iterators in a vector
-            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
-            for (auto it = first; it != last; ++it) {
-                iterators.emplace_back(it);
-            }
-
-            // Sort the iterators on pointed values
-            cppsort::detail::pdqsort(
-                iterators.begin(), iterators.end(),
-                compare, utility::indirect{} | projection
-            );
-
             ////////////////////////////////////////////////////////////
             // Maximum distance an element has to travel in order to
             // reach its sorted position
@@ -67,11 +53,11 @@ namespace probe
             for (auto it = first; it != last; ++it) {
                 // Find the range where *first belongs once sorted
                 auto rng = cppsort::detail::equal_range(
-                    iterators.begin(), iterators.end(), proj(*it),
+                    sorted_first, sorted_last, proj(*it),
                     compare, utility::indirect{} | projection
                 );
-                auto pos_min = rng.first - iterators.begin();
-                auto pos_max = rng.second - iterators.begin();
+                auto pos_min = rng.first - sorted_first;
+                auto pos_max = rng.second - sorted_first;
 
                 // If *first isn't into one of its sorted positions, computed the closest
                 if (it_pos < pos_min) {
@@ -85,6 +71,35 @@ namespace probe
             return max_dist;
         }
 
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto max_probe_algo(ForwardIterator first, ForwardIterator last,
+                            cppsort::detail::difference_type_t<ForwardIterator> size,
+                            Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            if (size < 2) {
+                return 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Indirectly sort the iterators
+
+            // Copy the iterators in a vector
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            for (auto it = first; it != last; ++it) {
+                iterators.emplace_back(it);
+            }
+
+            // Sort the iterators on pointed values
+            cppsort::detail::pdqsort(
+                iterators.begin(), iterators.end(),
+                compare, utility::indirect{} | projection
+            );
+
+            return max_from_sorted(first, last, iterators.begin(), iterators.end(),
+                                   std::move(compare), std::move(projection));
+        }
+
         struct max_impl
         {
             template<
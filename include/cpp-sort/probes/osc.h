@@ -14,7 +14,6 @@
 #include <new>
 #include <numeric>
 #include <utility>
-#include <vector>
 #include <cpp-sort/sorter_facade.h>
 #include <cpp-sort/sorter_traits.h>
 #include <cpp-sort/utility/as_function.h>
@@ -24,6 +23,7 @@
 #include "../detail/equal_range.h"
 #include "../detail/immovable_vector.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
 #include "../detail/pdqsort.h"
 #include "../detail/type_traits.h"
 
@@ -68,35 +68,22 @@ namespace probe
             return count;
         }
 
-        template<typename ForwardIterator, typename Compare, typename Projection>
-        auto allocating_osc_algo(ForwardIterator first, ForwardIterator last,
-                                 cppsort::detail::difference_type_t<ForwardIterator> size,
-                                 Compare compare, Projection projection)
+        template<
+            typename ForwardIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto osc_from_sorted(ForwardIterator first, ForwardIterator last,
+                             cppsort::detail::difference_type_t<ForwardIterator> size,
+                             RandomAccessIterator sorted_first, RandomAccessIterator sorted_last,
+                             Compare compare, Projection projection)
             -> ::cppsort::detail::difference_type_t<ForwardIterator>
         {
             using difference_type = ::cppsort::detail::difference_type_t<ForwardIterator>;
             auto&& comp = utility::as_function(compare);
             auto&& proj = utility::as_function(projection);
 
-            if (size < 2) {
-                return 0;
-            }
-
-            ////////////////////////////////////////////////////////////
-            // Indirectly sort the iterators
-
-            // Copy the iterators in a vector
-            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
-            for (auto it = first; it != last; ++it) {
-                iterators.emplace_back(it);
-            }
-
-            // Sort the iterators on pointed values
-            cppsort::detail::pdqsort(
-                iterators.begin(), iterators.end(),
-                compare, utility::indirect{} | projection
-            );
-
             ////////////////////////////////////////////////////////////
             // Compute the oscillation
 
@@ -116,10 +103,10 @@ namespace probe
             //       twice as slow. Comments in the code contain the lines
             //       required to reduce the search space again.
 
-            std::vector<difference_type> cross(size, 0);
+            cppsort::detail::scratch_vector<difference_type> cross(size, 0);
 
             auto prev_bounds = cppsort::detail::equal_range(
-                iterators.begin(), iterators.end(), proj(*first),
+                sorted_first, sorted_last, proj(*first),
                 compare, utility::indirect{} | projection
             );
 
@@ -127,21 +114,21 @@ namespace probe
                 difference_type min_idx, max_idx;
                 if (comp(proj(*prev), proj(*current))) {
                     auto current_bounds = cppsort::detail::equal_range(
-                        //prev_bounds.second, std::prev(iterators.end()), proj(*current),
-                        iterators.begin(), iterators.end(), proj(*current),
+                        //prev_bounds.second, std::prev(sorted_last), proj(*current),
+                        sorted_first, sorted_last, proj(*current),
                         compare, utility::indirect{} | projection
                     );
-                    min_idx = prev_bounds.second - iterators.begin();
-                    max_idx = current_bounds.first - iterators.begin();
+                    min_idx = prev_bounds.second - sorted_first;
+                    max_idx = current_bounds.first - sorted_first;
                     prev_bounds = current_bounds;
                 } else if (comp(proj(*current), proj(*prev))) {
                     auto current_bounds = cppsort::detail::equal_range(
-                        //iterators.begin(), prev_bounds.first, proj(*current),
-                        iterators.begin(), iterators.end(), proj(*current),
+                        //sorted_first, prev_bounds.first, proj(*current),
+                        sorted_first, sorted_last, proj(*current),
                         compare, utility::indirect{} | projection
                     );
-                    min_idx = current_bounds.second - iterators.begin();
-                    max_idx = prev_bounds.first - iterators.begin();
+                    min_idx = current_bounds.second - sorted_first;
+                    max_idx = prev_bounds.first - sorted_first;
                     prev_bounds = current_bounds;
                 } else {
                     // *prev == *current, bounds don't change
@@ -156,6 +143,35 @@ namespace probe
             return std::accumulate(cross.begin(), cross.end(), difference_type(0));
         }
 
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto allocating_osc_algo(ForwardIterator first, ForwardIterator last,
+                                 cppsort::detail::difference_type_t<ForwardIterator> size,
+                                 Compare compare, Projection projection)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            if (size < 2) {
+                return 0;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Indirectly sort the iterators
+
+            // Copy the iterators in a vector
+            cppsort::detail::immovable_vector<ForwardIterator> iterators(size);
+            for (auto it = first; it != last; ++it) {
+                iterators.emplace_back(it);
+            }
+
+            // Sort the iterators on pointed values
+            cppsort::detail::pdqsort(
+                iterators.begin(), iterators.end(),
+                compare, utility::indirect{} | projection
+            );
+
+            return osc_from_sorted(first, last, size, iterators.begin(), iterators.end(),
+                                   std::move(compare), std::move(projection));
+        }
+
         template<typename ForwardIterator, typename Compare, typename Projection>
         auto osc_algo(ForwardIterator first, ForwardIterator last,
                       cppsort::detail::difference_type_t<ForwardIterator> size,
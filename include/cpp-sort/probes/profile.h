@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_PROFILE_H_
+#define CPPSORT_PROBES_PROFILE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/probes/block.h>
+#include <cpp-sort/probes/dis.h>
+#include <cpp-sort/probes/enc.h>
+#include <cpp-sort/probes/exc.h>
+#include <cpp-sort/probes/ham.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/max.h>
+#include <cpp-sort/probes/mono.h>
+#include <cpp-sort/probes/osc.h>
+#include <cpp-sort/probes/rem.h>
+#include <cpp-sort/probes/runs.h>
+#include <cpp-sort/probes/sus.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/immovable_vector.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/longest_non_descending_subsequence.h"
+#include "../detail/pdqsort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    ////////////////////////////////////////////////////////////
+    // Set of measures of presortedness
+
+    enum struct measures: unsigned
+    {
+        none = 0,
+        block = 1u << 0,
+        dis = 1u << 1,
+        enc = 1u << 2,
+        exc = 1u << 3,
+        ham = 1u << 4,
+        inv = 1u << 5,
+        max = 1u << 6,
+        mono = 1u << 7,
+        osc = 1u << 8,
+        rem = 1u << 9,
+        runs = 1u << 10,
+        sus = 1u << 11,
+        all = (1u << 12) - 1
+    };
+
+    constexpr auto operator|(measures lhs, measures rhs) noexcept
+        -> measures
+    {
+        return static_cast<measures>(static_cast<unsigned>(lhs) | static_cast<unsigned>(rhs));
+    }
+
+    constexpr auto operator&(measures lhs, measures rhs) noexcept
+        -> measures
+    {
+        return static_cast<measures>(static_cast<unsigned>(lhs) & static_cast<unsigned>(rhs));
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Values of the measures, those that weren't requested
+    // are left to 0
+
+    template<typename Integer>
+    struct profile_result
+    {
+        Integer block = 0;
+        Integer dis = 0;
+        Integer enc = 0;
+        Integer exc = 0;
+        Integer ham = 0;
+        Integer inv = 0;
+        Integer max = 0;
+        Integer mono = 0;
+        Integer osc = 0;
+        Integer rem = 0;
+        Integer runs = 0;
+        Integer sus = 0;
+    };
+
+    namespace detail
+    {
+        constexpr auto has_measure(measures set, measures value) noexcept
+            -> bool
+        {
+            return (set & value) != measures::none;
+        }
+
+        template<
+            typename BidirectionalIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto profile_dis(BidirectionalIterator, BidirectionalIterator last,
+                         cppsort::detail::difference_type_t<BidirectionalIterator> size,
+                         RandomAccessIterator lr_cummax,
+                         Compare compare, Projection projection,
+                         std::bidirectional_iterator_tag)
+            -> ::cppsort::detail::difference_type_t<BidirectionalIterator>
+        {
+            return dis_from_cummax(last, size, lr_cummax,
+                                   std::move(compare), std::move(projection));
+        }
+
+        template<
+            typename ForwardIterator,
+            typename RandomAccessIterator,
+            typename Compare,
+            typename Projection
+        >
+        auto profile_dis(ForwardIterator first, ForwardIterator last,
+                         cppsort::detail::difference_type_t<ForwardIterator> size,
+                         RandomAccessIterator,
+                         Compare compare, Projection projection,
+                         std::forward_iterator_tag)
+            -> ::cppsort::detail::difference_type_t<ForwardIterator>
+        {
+            return inplace_dis_probe_algo(first, last, size,
+                                          std::move(compare), std::move(projection));
+        }
+
+        struct profile_impl
+        {
+            measures requested = measures::all;
+
+            profile_impl() = default;
+
+            constexpr explicit profile_impl(measures requested) noexcept:
+                requested(requested)
+            {}
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto profile_algo(ForwardIterator first, ForwardIterator last,
+                              cppsort::detail::difference_type_t<ForwardIterator> size,
+                              Compare compare, Projection projection) const
+                -> profile_result<cppsort::detail::difference_type_t<ForwardIterator>>
+            {
+                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
+                using category = cppsort::detail::iterator_category_t<ForwardIterator>;
+                constexpr bool is_bidirectional = std::is_base_of<
+                    std::bidirectional_iterator_tag,
+                    category
+                >::value;
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                profile_result<difference_type> res;
+                if (size < 2) {
+                    return res;
+                }
+
+                bool needs_sorted = has_measure(requested,
+                    measures::block | measures::exc | measures::ham |
+                    measures::max | measures::osc
+                );
+                bool needs_cummax = is_bidirectional && has_measure(requested, measures::dis);
+                bool needs_runs = has_measure(requested, measures::runs);
+                bool needs_mono = has_measure(requested, measures::mono);
+
+                ////////////////////////////////////////////////////////////
+                // Single linear pass: copy the iterators to sort, compute
+                // the cumulative max of Dis' algorithm LR, and count the
+                // runs needed by Runs and Mono
+
+                cppsort::detail::immovable_vector<ForwardIterator> iterators(needs_sorted ? size : 0);
+                cppsort::detail::immovable_vector<ForwardIterator> lr_cummax(needs_cummax ? size : 0);
+
+                if (needs_sorted) {
+                    iterators.emplace_back(first);
+                }
+                if (needs_cummax) {
+                    lr_cummax.emplace_back(first);
+                }
+
+                // State of Mono: 0 between runs, 1 in an ascending
+                // run, -1 in a descending run
+                int mono_direction = 0;
+                for (auto current = first, next = std::next(first); next != last; ++current, (void)++next) {
+                    if (needs_sorted) {
+                        iterators.emplace_back(next);
+                    }
+                    if (needs_cummax) {
+                        if (comp(proj(*lr_cummax.back()), proj(*next))) {
+                            lr_cummax.emplace_back(next);
+                        } else {
+                            lr_cummax.emplace_back(lr_cummax.back());
+                        }
+                    }
+
+                    if (needs_runs || needs_mono) {
+                        bool ascends = comp(proj(*current), proj(*next));
+                        bool descends = not ascends && comp(proj(*next), proj(*current));
+                        if (needs_runs && descends) {
+                            ++res.runs;
+                        }
+                        if (needs_mono) {
+                            // A strict change of direction ends the current
+                            // run and does not belong to the next one
+                            if (mono_direction == 0) {
+                                mono_direction = ascends ? 1 : (descends ? -1 : 0);
+                            } else if ((mono_direction == 1 && descends) ||
+                                       (mono_direction == -1 && ascends)) {
+                                ++res.mono;
+                                mono_direction = 0;
+                            }
+                        }
+                    }
+                }
+
+                if (has_measure(requested, measures::dis)) {
+                    res.dis = profile_dis(first, last, size, lr_cummax.begin(),
+                                          compare, projection, category{});
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Measures sharing the same sorted iterators
+
+                if (needs_sorted) {
+                    cppsort::detail::pdqsort(
+                        iterators.begin(), iterators.end(),
+                        compare, utility::indirect{} | projection
+                    );
+
+                    if (has_measure(requested, measures::block)) {
+                        res.block = block_from_sorted(last, iterators.begin(), iterators.end(),
+                                                      compare, projection);
+                    }
+                    if (has_measure(requested, measures::exc)) {
+                        res.exc = exc_from_sorted(first, last, size, iterators.begin(),
+                                                  compare, projection);
+                    }
+                    if (has_measure(requested, measures::ham)) {
+                        res.ham = ham_from_sorted(first, iterators.begin(), iterators.end(),
+                                                  compare, projection);
+                    }
+                    if (has_measure(requested, measures::max)) {
+                        res.max = max_from_sorted(first, last, iterators.begin(), iterators.end(),
+                                                  compare, projection);
+                    }
+                    if (has_measure(requested, measures::osc)) {
+                        res.osc = osc_from_sorted(first, last, size,
+                                                  iterators.begin(), iterators.end(),
+                                                  compare, projection);
+                    }
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Measures with nothing to share
+
+                if (has_measure(requested, measures::enc)) {
+                    res.enc = enc_impl{}(first, last, compare, projection);
+                }
+                if (has_measure(requested, measures::inv)) {
+                    res.inv = inv_probe_algo(first, last, size, compare, projection);
+                }
+                if (has_measure(requested, measures::rem)) {
+                    auto lnds = cppsort::detail::longest_non_descending_subsequence<false>(
+                        first, last, size, compare, projection
+                    );
+                    res.rem = lnds.second - lnds.first;
+                }
+                if (has_measure(requested, measures::sus)) {
+                    res.sus = sus_impl{}(first, last, compare, projection);
+                }
+                return res;
+            }
+
+            template<
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return profile_algo(std::begin(iterable), std::end(iterable),
+                                    utility::size(iterable),
+                                    std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return profile_algo(first, last, std::distance(first, last),
+                                    std::move(compare), std::move(projection));
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Several measures of presortedness at once
+
+    struct profile:
+        sorter_facade<detail::profile_impl>
+    {
+        profile() = default;
+
+        constexpr explicit profile(measures requested) noexcept:
+            sorter_facade<detail::profile_impl>(requested)
+        {}
+    };
+}}
+
+#endif // CPPSORT_PROBES_PROFILE_H_
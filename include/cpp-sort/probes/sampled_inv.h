@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_SAMPLED_INV_H_
+#define CPPSORT_PROBES_SAMPLED_INV_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <cpp-sort/probes/estimate.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/count_inversions.h"
+#include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
+#include "../detail/sampling.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    namespace detail
+    {
+        struct sampled_inv_impl
+        {
+            std::size_t sample_size = 4096;
+            double confidence = 0.95;
+            std::uint_fast64_t seed = std::mt19937_64::default_seed;
+
+            sampled_inv_impl() = default;
+
+            constexpr explicit sampled_inv_impl(std::size_t sample_size,
+                                                double confidence = 0.95,
+                                                std::uint_fast64_t seed = std::mt19937_64::default_seed) noexcept:
+                sample_size(sample_size),
+                confidence(confidence),
+                seed(seed)
+            {}
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto estimate_inv(ForwardIterator first,
+                              cppsort::detail::difference_type_t<ForwardIterator> size,
+                              Compare compare, Projection projection) const
+                -> estimate<cppsort::detail::difference_type_t<ForwardIterator>>
+            {
+                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
+
+                if (size < 2) {
+                    return { 0, 0, 0 };
+                }
+
+                std::mt19937_64 engine(seed);
+                auto sample = cppsort::detail::sample_iterators(first, size, sample_size, engine);
+                cppsort::detail::scratch_vector<ForwardIterator> buffer(sample.size());
+                auto inversions = cppsort::detail::count_inversions<difference_type>(
+                    sample.data(), sample.data() + sample.size(), buffer.data(),
+                    std::move(compare),
+                    utility::indirect{} | std::move(projection)
+                );
+
+                if (sample.size() == static_cast<std::size_t>(size)) {
+                    // Every element was sampled, the result is exact
+                    return { inversions, inversions, inversions };
+                }
+
+                // Every pair of sampled elements is used, so the ratio is a
+                // U-statistic, for which Hoeffding's bound holds with half
+                // as many independent samples
+                auto k = static_cast<double>(sample.size());
+                auto ratio = static_cast<double>(inversions) / (k * (k - 1.0) / 2.0);
+                auto deviation = cppsort::detail::hoeffding_deviation(
+                    std::floor(k / 2.0), (1.0 - confidence) / 2.0
+                );
+                return cppsort::detail::make_estimate(
+                    ratio, ratio - deviation, ratio + deviation,
+                    max_for_size(size)
+                );
+            }
+
+            template<
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return estimate_inv(std::begin(iterable), utility::size(iterable),
+                                    std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return estimate_inv(first, std::distance(first, last),
+                                    std::move(compare), std::move(projection));
+            }
+
+            // Sample size needed for the bounds to be within epsilon *
+            // max_for_size(n) of the estimate with the given confidence
+            static auto sample_size_for(double epsilon, double confidence = 0.95)
+                -> std::size_t
+            {
+                return 2 * cppsort::detail::hoeffding_samples(epsilon, (1.0 - confidence) / 2.0) + 1;
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return inv_impl::max_for_size(n);
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Approximate Inv
+
+    struct sampled_inv:
+        sorter_facade<detail::sampled_inv_impl>
+    {
+        sampled_inv() = default;
+
+        constexpr explicit sampled_inv(std::size_t sample_size,
+                                       double confidence = 0.95,
+                                       std::uint_fast64_t seed = std::mt19937_64::default_seed) noexcept:
+            sorter_facade<detail::sampled_inv_impl>(sample_size, confidence, seed)
+        {}
+    };
+}}
+
+#endif // CPPSORT_PROBES_SAMPLED_INV_H_
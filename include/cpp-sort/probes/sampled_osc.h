@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_SAMPLED_OSC_H_
+#define CPPSORT_PROBES_SAMPLED_OSC_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <cpp-sort/probes/estimate.h>
+#include <cpp-sort/probes/osc.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/lower_bound.h"
+#include "../detail/pdqsort.h"
+#include "../detail/sampling.h"
+#include "../detail/type_traits.h"
+#include "../detail/upper_bound.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    namespace detail
+    {
+        struct sampled_osc_impl
+        {
+            std::size_t sample_size = 4096;
+            double confidence = 0.95;
+            std::uint_fast64_t seed = std::mt19937_64::default_seed;
+
+            sampled_osc_impl() = default;
+
+            constexpr explicit sampled_osc_impl(std::size_t sample_size,
+                                                double confidence = 0.95,
+                                                std::uint_fast64_t seed = std::mt19937_64::default_seed) noexcept:
+                sample_size(sample_size),
+                confidence(confidence),
+                seed(seed)
+            {}
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto estimate_osc(ForwardIterator first,
+                              cppsort::detail::difference_type_t<ForwardIterator> size,
+                              Compare compare, Projection projection) const
+                -> estimate<cppsort::detail::difference_type_t<ForwardIterator>>
+            {
+                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                if (size < 3) {
+                    return { 0, 0, 0 };
+                }
+
+                // Osc counts the pairs made of an element and of a pair of
+                // adjacent elements such that the former lies strictly
+                // between the latter: sample both kinds independently
+                std::mt19937_64 engine(seed);
+                auto values = cppsort::detail::sample_iterators(first, size, sample_size, engine);
+                auto edges = cppsort::detail::sample_iterators(first, size - 1, sample_size, engine);
+
+                cppsort::detail::pdqsort(
+                    values.begin(), values.end(),
+                    compare, utility::indirect{} | projection
+                );
+
+                difference_type count = 0;
+                for (auto it: edges) {
+                    auto next = std::next(it);
+                    auto low = it;
+                    auto high = next;
+                    if (comp(proj(*next), proj(*it))) {
+                        std::swap(low, high);
+                    } else if (not comp(proj(*it), proj(*next))) {
+                        continue;
+                    }
+
+                    auto lower_it = cppsort::detail::upper_bound(
+                        values.begin(), values.end(), proj(*low),
+                        compare, utility::indirect{} | projection
+                    );
+                    auto upper_it = cppsort::detail::lower_bound(
+                        values.begin(), values.end(), proj(*high),
+                        compare, utility::indirect{} | projection
+                    );
+                    if (lower_it < upper_it) {
+                        count += static_cast<difference_type>(upper_it - lower_it);
+                    }
+                }
+
+                if (values.size() == static_cast<std::size_t>(size) &&
+                    edges.size() == static_cast<std::size_t>(size - 1)) {
+                    // Every element and every pair was sampled, the result is exact
+                    return { count, count, count };
+                }
+
+                // Hoeffding's bound for two-sample U-statistics holds with
+                // as many independent samples as the smallest sample
+                auto ratio = static_cast<double>(count)
+                           / (static_cast<double>(values.size()) * static_cast<double>(edges.size()));
+                auto deviation = cppsort::detail::hoeffding_deviation(
+                    static_cast<double>((std::min)(values.size(), edges.size())),
+                    (1.0 - confidence) / 2.0
+                );
+
+                // The ratio is relative to the number of pairs, not to the
+                // greatest value of the measure
+                auto max = max_for_size(size);
+                auto pairs_to_max = static_cast<double>(size) * static_cast<double>(size - 1)
+                                  / static_cast<double>(max);
+                return cppsort::detail::make_estimate(
+                    ratio * pairs_to_max,
+                    (ratio - deviation) * pairs_to_max,
+                    (ratio + deviation) * pairs_to_max,
+                    max
+                );
+            }
+
+            template<
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return estimate_osc(std::begin(iterable), utility::size(iterable),
+                                    std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return estimate_osc(first, std::distance(first, last),
+                                    std::move(compare), std::move(projection));
+            }
+
+            // Sample size needed for the bounds to be within epsilon *
+            // |X| * (|X| - 1) of the estimate with the given confidence
+            static auto sample_size_for(double epsilon, double confidence = 0.95)
+                -> std::size_t
+            {
+                return cppsort::detail::hoeffding_samples(epsilon, (1.0 - confidence) / 2.0);
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return osc_impl::max_for_size(n);
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Approximate Osc
+
+    struct sampled_osc:
+        sorter_facade<detail::sampled_osc_impl>
+    {
+        sampled_osc() = default;
+
+        constexpr explicit sampled_osc(std::size_t sample_size,
+                                       double confidence = 0.95,
+                                       std::uint_fast64_t seed = std::mt19937_64::default_seed) noexcept:
+            sorter_facade<detail::sampled_osc_impl>(sample_size, confidence, seed)
+        {}
+    };
+}}
+
+#endif // CPPSORT_PROBES_SAMPLED_OSC_H_
@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_PROBES_SAMPLED_REM_H_
+#define CPPSORT_PROBES_SAMPLED_REM_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <cpp-sort/probes/estimate.h>
+#include <cpp-sort/probes/rem.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/memory.h"
+#include "../detail/sampling.h"
+#include "../detail/type_traits.h"
+#include "../detail/upper_bound.h"
+
+namespace cppsort
+{
+namespace probe
+{
+    namespace detail
+    {
+        // Longest non-decreasing subsequence of the sample, returns
+        // its elements in the order they appear in the collection
+        template<typename ForwardIterator, typename Compare, typename Projection>
+        auto sample_lnds(const cppsort::detail::scratch_vector<ForwardIterator>& sample,
+                         Compare compare, Projection projection)
+            -> cppsort::detail::scratch_vector<ForwardIterator>
+        {
+            auto&& proj = utility::as_function(projection);
+            constexpr std::size_t none = static_cast<std::size_t>(-1);
+
+            // Patience sorting where every element also remembers the
+            // top of the previous stack when it was added, which is
+            // enough to rebuild the subsequence afterwards
+            cppsort::detail::scratch_vector<std::size_t> stack_tops;
+            cppsort::detail::scratch_vector<std::size_t> previous(sample.size());
+            for (std::size_t idx = 0 ; idx < sample.size() ; ++idx) {
+                auto it = cppsort::detail::upper_bound(
+                    stack_tops.begin(), stack_tops.end(), proj(*sample[idx]), compare,
+                    [&](std::size_t pos) -> decltype(auto) { return proj(*sample[pos]); }
+                );
+                previous[idx] = (it == stack_tops.begin()) ? none : *std::prev(it);
+                if (it == stack_tops.end()) {
+                    stack_tops.push_back(idx);
+                } else {
+                    *it = idx;
+                }
+            }
+
+            cppsort::detail::scratch_vector<ForwardIterator> res(stack_tops.size());
+            auto idx = stack_tops.empty() ? none : stack_tops.back();
+            for (auto out = res.rbegin() ; idx != none ; ++out) {
+                *out = sample[idx];
+                idx = previous[idx];
+            }
+            return res;
+        }
+
+        struct sampled_rem_impl
+        {
+            std::size_t sample_size = 4096;
+            double confidence = 0.95;
+            std::uint_fast64_t seed = std::mt19937_64::default_seed;
+
+            sampled_rem_impl() = default;
+
+            constexpr explicit sampled_rem_impl(std::size_t sample_size,
+                                                double confidence = 0.95,
+                                                std::uint_fast64_t seed = std::mt19937_64::default_seed) noexcept:
+                sample_size(sample_size),
+                confidence(confidence),
+                seed(seed)
+            {}
+
+            template<typename ForwardIterator, typename Compare, typename Projection>
+            auto estimate_rem(ForwardIterator first, ForwardIterator last,
+                              cppsort::detail::difference_type_t<ForwardIterator> size,
+                              Compare compare, Projection projection) const
+                -> estimate<cppsort::detail::difference_type_t<ForwardIterator>>
+            {
+                using difference_type = cppsort::detail::difference_type_t<ForwardIterator>;
+                auto&& comp = utility::as_function(compare);
+                auto&& proj = utility::as_function(projection);
+
+                if (size < 2) {
+                    return { 0, 0, 0 };
+                }
+
+                std::mt19937_64 engine(seed);
+                auto sample = cppsort::detail::sample_iterators(first, size, sample_size, engine);
+                auto pivots = sample_lnds(sample, compare, projection);
+
+                ////////////////////////////////////////////////////////////
+                // Upper bound
+
+                // The subsequence found in the sample is also a non-decreasing
+                // subsequence of the whole collection: greedily extend it with
+                // the elements that fit between two consecutive pivots, which
+                // gives a subsequence that is at least as long as the longest
+                // non-decreasing subsequence minus the actual measure
+                difference_type kept = 0;
+                auto next_pivot = pivots.begin();
+                auto last_kept = last;
+                for (auto it = first ; it != last ; ++it) {
+                    if (next_pivot != pivots.end() && it == *next_pivot) {
+                        ++next_pivot;
+                    } else if ((last_kept != last && comp(proj(*it), proj(*last_kept))) ||
+                               (next_pivot != pivots.end() && comp(proj(**next_pivot), proj(*it)))) {
+                        continue;
+                    }
+                    ++kept;
+                    last_kept = it;
+                }
+                auto upper = size - kept;
+
+                if (sample.size() == static_cast<std::size_t>(size)) {
+                    // Every element was sampled, the result is exact
+                    return { upper, upper, upper };
+                }
+
+                ////////////////////////////////////////////////////////////
+                // Lower bound
+
+                // The elements of the sample that don't belong to its longest
+                // non-decreasing subsequence are fewer than the sampled elements
+                // that don't belong to the longest non-decreasing subsequence of
+                // the collection, so the ratio can't overestimate the measure by
+                // more than Hoeffding's bound, but it might underestimate it
+                auto k = static_cast<double>(sample.size());
+                auto ratio = (k - static_cast<double>(pivots.size())) / k;
+                auto deviation = cppsort::detail::hoeffding_deviation(k, 1.0 - confidence);
+
+                auto max = max_for_size(size);
+                auto size_to_max = static_cast<double>(size) / static_cast<double>(max);
+                auto res = cppsort::detail::make_estimate(
+                    ratio * size_to_max,
+                    (ratio - deviation) * size_to_max,
+                    1.0,
+                    max
+                );
+                res.upper = upper;
+                res.lower = (std::min)(res.lower, upper);
+                res.value = (std::max)(res.lower, (std::min)(res.value, upper));
+                return res;
+            }
+
+            template<
+                typename ForwardIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_v<Projection, ForwardIterable, Compare>
+                >
+            >
+            auto operator()(ForwardIterable&& iterable,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return estimate_rem(std::begin(iterable), std::end(iterable),
+                                    utility::size(iterable),
+                                    std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = cppsort::detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(auto)
+            {
+                return estimate_rem(first, last, std::distance(first, last),
+                                    std::move(compare), std::move(projection));
+            }
+
+            // Sample size needed for the lower bound to be within
+            // epsilon * |X| of the estimate with the given confidence
+            static auto sample_size_for(double epsilon, double confidence = 0.95)
+                -> std::size_t
+            {
+                return cppsort::detail::hoeffding_samples(epsilon, 1.0 - confidence);
+            }
+
+            template<typename Integer>
+            static constexpr auto max_for_size(Integer n)
+                -> Integer
+            {
+                return rem_impl::max_for_size(n);
+            }
+        };
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Approximate Rem
+
+    struct sampled_rem:
+        sorter_facade<detail::sampled_rem_impl>
+    {
+        sampled_rem() = default;
+
+        constexpr explicit sampled_rem(std::size_t sample_size,
+                                       double confidence = 0.95,
+                                       std::uint_fast64_t seed = std::mt19937_64::default_seed) noexcept:
+            sorter_facade<detail::sampled_rem_impl>(sample_size, confidence, seed)
+        {}
+    };
+}}
+
+#endif // CPPSORT_PROBES_SAMPLED_REM_H_
@@ -0,0 +1,16 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SELECTORS_H_
+#define CPPSORT_SELECTORS_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cpp-sort/selectors/nth_element_selector.h>
+#include <cpp-sort/selectors/partial_sort_copy.h>
+#include <cpp-sort/selectors/partial_sort_selector.h>
+#include <cpp-sort/selectors/top_k_selector.h>
+
+#endif // CPPSORT_SELECTORS_H_
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SELECTORS_NTH_ELEMENT_SELECTOR_H_
+#define CPPSORT_SELECTORS_NTH_ELEMENT_SELECTOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/nth_element.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Selector
+
+    namespace detail
+    {
+        struct nth_element_selector_impl
+        {
+            // Position of the element to put in place
+            std::ptrdiff_t nth = 0;
+
+            nth_element_selector_impl() = default;
+
+            constexpr explicit nth_element_selector_impl(std::ptrdiff_t nth) noexcept:
+                nth(nth)
+            {}
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> ForwardIterator
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "nth_element_selector requires at least forward iterators"
+                );
+
+                using difference_type = difference_type_t<ForwardIterator>;
+                auto size = std::distance(first, last);
+                if (nth < 0 || nth >= size) {
+                    return last;
+                }
+                return detail::nth_element(std::move(first), std::move(last),
+                                           static_cast<difference_type>(nth), size,
+                                           std::move(compare), std::move(projection));
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::forward_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct nth_element_selector:
+        sorter_facade<detail::nth_element_selector_impl>
+    {
+        nth_element_selector() = default;
+
+        constexpr explicit nth_element_selector(std::ptrdiff_t nth) noexcept:
+            sorter_facade<detail::nth_element_selector_impl>(nth)
+        {}
+    };
+}
+
+#endif // CPPSORT_SELECTORS_NTH_ELEMENT_SELECTOR_H_
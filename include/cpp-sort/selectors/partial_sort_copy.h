@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SELECTORS_PARTIAL_SORT_COPY_H_
+#define CPPSORT_SELECTORS_PARTIAL_SORT_COPY_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/partial_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Function object
+
+    namespace detail
+    {
+        struct partial_sort_copy_fn
+        {
+            template<
+                typename InputIterator,
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, InputIterator, Compare>
+                >
+            >
+            auto operator()(InputIterator first, InputIterator last,
+                            RandomAccessIterator result_first, RandomAccessIterator result_last,
+                            Compare compare={}, Projection projection={}) const
+                -> RandomAccessIterator
+            {
+                static_assert(
+                    std::is_base_of<
+                        std::random_access_iterator_tag,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "partial_sort_copy requires a random-access output range"
+                );
+
+                return detail::partial_sort_copy(std::move(first), std::move(last),
+                                                 std::move(result_first), std::move(result_last),
+                                                 std::move(compare), std::move(projection));
+            }
+
+            template<
+                typename InputIterable,
+                typename RandomAccessIterable,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_v<Projection, InputIterable, Compare>
+                >
+            >
+            auto operator()(InputIterable&& iterable, RandomAccessIterable&& result,
+                            Compare compare={}, Projection projection={}) const
+                -> decltype(std::begin(result))
+            {
+                return operator()(std::begin(iterable), std::end(iterable),
+                                  std::begin(result), std::end(result),
+                                  std::move(compare), std::move(projection));
+            }
+        };
+    }
+
+    namespace
+    {
+        constexpr auto&& partial_sort_copy
+            = utility::static_const<detail::partial_sort_copy_fn>::value;
+    }
+}
+
+#endif // CPPSORT_SELECTORS_PARTIAL_SORT_COPY_H_
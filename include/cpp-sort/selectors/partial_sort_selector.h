@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SELECTORS_PARTIAL_SORT_SELECTOR_H_
+#define CPPSORT_SELECTORS_PARTIAL_SORT_SELECTOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/partial_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Selector
+
+    namespace detail
+    {
+        struct partial_sort_selector_impl
+        {
+            // Number of elements to select and sort
+            std::ptrdiff_t k = 0;
+
+            partial_sort_selector_impl() = default;
+
+            constexpr explicit partial_sort_selector_impl(std::ptrdiff_t k) noexcept:
+                k(k)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> RandomAccessIterator
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "partial_sort_selector requires at least random-access iterators"
+                );
+
+                using difference_type = difference_type_t<RandomAccessIterator>;
+                auto size = last - first;
+                auto len = k < 0 ? difference_type(0)
+                         : k < size ? static_cast<difference_type>(k)
+                         : size;
+                auto middle = first + len;
+                detail::partial_sort(std::move(first), middle, std::move(last),
+                                     std::move(compare), std::move(projection));
+                return middle;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct partial_sort_selector:
+        sorter_facade<detail::partial_sort_selector_impl>
+    {
+        partial_sort_selector() = default;
+
+        constexpr explicit partial_sort_selector(std::ptrdiff_t k) noexcept:
+            sorter_facade<detail::partial_sort_selector_impl>(k)
+        {}
+    };
+}
+
+#endif // CPPSORT_SELECTORS_PARTIAL_SORT_SELECTOR_H_
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SELECTORS_TOP_K_SELECTOR_H_
+#define CPPSORT_SELECTORS_TOP_K_SELECTOR_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/partial_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Selector
+
+    namespace detail
+    {
+        struct top_k_selector_impl
+        {
+            // Number of elements to select
+            std::size_t k = 0;
+
+            top_k_selector_impl() = default;
+
+            constexpr explicit top_k_selector_impl(std::size_t k) noexcept:
+                k(k)
+            {}
+
+            template<
+                typename ForwardIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, ForwardIterator, Compare>
+                >
+            >
+            auto operator()(ForwardIterator first, ForwardIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> std::vector<value_type_t<ForwardIterator>>
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<ForwardIterator>
+                    >::value,
+                    "top_k_selector requires at least forward iterators"
+                );
+
+                // The collection is only read, the selected elements
+                // are copied to the returned vector
+                std::vector<value_type_t<ForwardIterator>> res;
+                for (; first != last && res.size() < k ; ++first) {
+                    res.push_back(*first);
+                }
+                detail::heap_select_copy(std::move(first), std::move(last),
+                                         res.begin(), res.end(),
+                                         std::move(compare), std::move(projection));
+                return res;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::forward_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct top_k_selector:
+        sorter_facade<detail::top_k_selector_impl>
+    {
+        top_k_selector() = default;
+
+        constexpr explicit top_k_selector(std::size_t k) noexcept:
+            sorter_facade<detail::top_k_selector_impl>(k)
+        {}
+    };
+}
+
+#endif // CPPSORT_SELECTORS_TOP_K_SELECTOR_H_
@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_ADAPTIVE_SORTER_H_
+#define CPPSORT_SORTERS_ADAPTIVE_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/adapters/drop_merge_adapter.h>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/verge_sorter.h>
+#include <cpp-sort/utility/as_function.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/reverse.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Tunable thresholds
+
+    struct adaptive_sorter_thresholds
+    {
+        // Collections smaller than this are sorted with pdq_sorter
+        // without looking for presortedness first
+        std::ptrdiff_t min_size = 128;
+
+        // Greatest fraction of descents (or ascents) for which the
+        // collection is considered almost sorted (or almost sorted
+        // in reverse order)
+        double presorted_ratio = 0.05;
+
+        // Smallest fraction of the descents caused by isolated
+        // elements for which drop_merge_adapter is used instead
+        // of a run-adaptive algorithm
+        double outliers_ratio = 0.5;
+
+        // Collections of arithmetic keys compared with std::less<>
+        // at least this big are sorted with ska_sorter when they
+        // are not almost sorted
+        std::ptrdiff_t radix_min_size = 1024;
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        enum struct adaptive_strategy
+        {
+            sorted,
+            outliers,
+            runs,
+            descending,
+            unsorted
+        };
+
+        // Single pass that looks for presortedness, it stops early
+        // as soon as the collection is known to be unsorted, so it
+        // is only really expensive when the collection is almost
+        // sorted, which is when it pays off the most
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto choose_adaptive_strategy(RandomAccessIterator first, RandomAccessIterator last,
+                                      Compare compare, Projection projection,
+                                      const adaptive_sorter_thresholds& thresholds)
+            -> adaptive_strategy
+        {
+            using difference_type = difference_type_t<RandomAccessIterator>;
+            auto&& comp = utility::as_function(compare);
+            auto&& proj = utility::as_function(projection);
+
+            auto size = last - first;
+            auto max_changes = static_cast<difference_type>(
+                static_cast<double>(size) * thresholds.presorted_ratio
+            );
+
+            difference_type descents = 0;
+            difference_type ascents = 0;
+            difference_type isolated = 0;
+            for (difference_type idx = 1 ; idx < size ; ++idx) {
+                if (comp(proj(first[idx]), proj(first[idx - 1]))) {
+                    ++descents;
+                    // The descent is caused by an isolated element when
+                    // the elements around it are still in order
+                    if ((idx >= 2 && not comp(proj(first[idx]), proj(first[idx - 2]))) ||
+                        (idx + 1 < size && not comp(proj(first[idx + 1]), proj(first[idx - 1])))) {
+                        ++isolated;
+                    }
+                } else if (comp(proj(first[idx - 1]), proj(first[idx]))) {
+                    ++ascents;
+                }
+
+                if (descents > max_changes && ascents > max_changes) {
+                    return adaptive_strategy::unsorted;
+                }
+            }
+
+            if (descents == 0) {
+                return adaptive_strategy::sorted;
+            }
+            if (descents <= max_changes) {
+                auto outliers = static_cast<double>(descents) * thresholds.outliers_ratio;
+                return static_cast<double>(isolated) >= outliers ?
+                    adaptive_strategy::outliers :
+                    adaptive_strategy::runs;
+            }
+            return adaptive_strategy::descending;
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        using can_adaptive_radix_sort = conjunction<
+            std::is_same<Compare, std::less<>>,
+            std::is_arithmetic<remove_cvref_t<projected_t<RandomAccessIterator, Projection>>>,
+            is_ska_sortable<projected_t<RandomAccessIterator, Projection>>
+        >;
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto adaptive_sort_unsorted(RandomAccessIterator first, RandomAccessIterator last,
+                                    Compare compare, Projection projection,
+                                    const adaptive_sorter_thresholds& thresholds,
+                                    std::true_type /* radix sortable */)
+            -> void
+        {
+            if (last - first >= thresholds.radix_min_size) {
+                ska_sorter{}(std::move(first), std::move(last), std::move(projection));
+            } else {
+                pdq_sorter{}(std::move(first), std::move(last),
+                             std::move(compare), std::move(projection));
+            }
+        }
+
+        template<typename RandomAccessIterator, typename Compare, typename Projection>
+        auto adaptive_sort_unsorted(RandomAccessIterator first, RandomAccessIterator last,
+                                    Compare compare, Projection projection,
+                                    const adaptive_sorter_thresholds&,
+                                    std::false_type /* radix sortable */)
+            -> void
+        {
+            pdq_sorter{}(std::move(first), std::move(last),
+                         std::move(compare), std::move(projection));
+        }
+
+        struct adaptive_sorter_impl
+        {
+            adaptive_sorter_thresholds thresholds = {};
+
+            adaptive_sorter_impl() = default;
+
+            constexpr explicit adaptive_sorter_impl(const adaptive_sorter_thresholds& thresholds) noexcept:
+                thresholds(thresholds)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "adaptive_sorter requires at least random-access iterators"
+                );
+
+                if (last - first < thresholds.min_size) {
+                    pdq_sorter{}(std::move(first), std::move(last),
+                                 std::move(compare), std::move(projection));
+                    return;
+                }
+
+                auto strategy = choose_adaptive_strategy(first, last, compare, projection, thresholds);
+                if (strategy == adaptive_strategy::descending) {
+                    // Reversing a collection almost sorted in reverse order
+                    // gives an almost sorted collection, whose kind of
+                    // disorder still has to be analyzed
+                    detail::reverse(first, last);
+                    strategy = choose_adaptive_strategy(first, last, compare, projection, thresholds);
+                }
+
+                switch (strategy) {
+                    case adaptive_strategy::sorted:
+                        return;
+                    case adaptive_strategy::outliers:
+                        drop_merge_adapter<pdq_sorter>{}(std::move(first), std::move(last),
+                                                         std::move(compare), std::move(projection));
+                        return;
+                    case adaptive_strategy::runs:
+                        verge_sorter{}(std::move(first), std::move(last),
+                                       std::move(compare), std::move(projection));
+                        return;
+                    case adaptive_strategy::descending:
+                    case adaptive_strategy::unsorted:
+                        adaptive_sort_unsorted(
+                            std::move(first), std::move(last),
+                            std::move(compare), std::move(projection),
+                            thresholds,
+                            can_adaptive_radix_sort<RandomAccessIterator, Compare, Projection>{}
+                        );
+                        return;
+                }
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::false_type;
+        };
+    }
+
+    struct adaptive_sorter:
+        sorter_facade<detail::adaptive_sorter_impl>
+    {
+        adaptive_sorter() = default;
+
+        constexpr explicit adaptive_sorter(const adaptive_sorter_thresholds& thresholds) noexcept:
+            sorter_facade<detail::adaptive_sorter_impl>(thresholds)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& adaptive_sort
+            = utility::static_const<adaptive_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_ADAPTIVE_SORTER_H_
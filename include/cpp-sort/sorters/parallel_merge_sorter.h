@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_SORTERS_PARALLEL_MERGE_SORTER_H_
+#define CPPSORT_SORTERS_PARALLEL_MERGE_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/sorter_facade.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/utility/functional.h>
+#include <cpp-sort/utility/static_const.h>
+#include "../detail/iterator_traits.h"
+#include "../detail/parallel_merge_sort.h"
+#include "../detail/type_traits.h"
+
+namespace cppsort
+{
+    ////////////////////////////////////////////////////////////
+    // Sorter
+
+    namespace detail
+    {
+        struct parallel_merge_sorter_impl
+        {
+            // Maximum number of threads used to sort a collection,
+            // 0 means one thread per hardware thread
+            std::size_t max_threads = 0;
+
+            parallel_merge_sorter_impl() = default;
+
+            constexpr explicit parallel_merge_sorter_impl(std::size_t max_threads) noexcept:
+                max_threads(max_threads)
+            {}
+
+            template<
+                typename RandomAccessIterator,
+                typename Compare = std::less<>,
+                typename Projection = utility::identity,
+                typename = detail::enable_if_t<
+                    is_projection_iterator_v<Projection, RandomAccessIterator, Compare>
+                >
+            >
+            auto operator()(RandomAccessIterator first, RandomAccessIterator last,
+                            Compare compare={}, Projection projection={}) const
+                -> void
+            {
+                static_assert(
+                    std::is_base_of<
+                        iterator_category,
+                        iterator_category_t<RandomAccessIterator>
+                    >::value,
+                    "parallel_merge_sorter requires at least random-access iterators"
+                );
+
+                parallel_merge_sort(std::move(first), std::move(last),
+                                    std::move(compare), std::move(projection),
+                                    max_threads);
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Sorter traits
+
+            using iterator_category = std::random_access_iterator_tag;
+            using is_always_stable = std::true_type;
+        };
+    }
+
+    struct parallel_merge_sorter:
+        sorter_facade<detail::parallel_merge_sorter_impl>
+    {
+        parallel_merge_sorter() = default;
+
+        constexpr explicit parallel_merge_sorter(std::size_t max_threads) noexcept:
+            sorter_facade<detail::parallel_merge_sorter_impl>(max_threads)
+        {}
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Sort function
+
+    namespace
+    {
+        constexpr auto&& parallel_merge_sort
+            = utility::static_const<parallel_merge_sorter>::value;
+    }
+}
+
+#endif // CPPSORT_SORTERS_PARALLEL_MERGE_SORTER_H_
@@ -8,50 +8,152 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
+#include <initializer_list>
 #include <iterator>
+#include <tuple>
+#include <type_traits>
 #include <utility>
-#include <cpp-sort/utility/iter_move.h>
+#include <cpp-sort/utility/size.h>
+#include "../detail/apply_permutation.h"
 #include "../detail/config.h"
 #include "../detail/iterator_traits.h"
+#include "../detail/type_traits.h"
 
 namespace cppsort
 {
 namespace utility
 {
+    namespace detail
+    {
+        template<typename RandomAccessIterator>
+        auto indices_source(RandomAccessIterator indices_first)
+        {
+            using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+            return [indices_first](std::size_t pos) {
+                return static_cast<std::size_t>(indices_first[static_cast<difference_type>(pos)]);
+            };
+        }
+
+        template<typename T>
+        using is_columns = cppsort::detail::is_specialization_of<
+            cppsort::detail::remove_cvref_t<T>,
+            std::tuple
+        >;
+
+        template<typename... RandomAccessIterables, typename RandomAccessIterator,
+                 std::size_t... Indices>
+        auto apply_permutation_columns(std::tuple<RandomAccessIterables...>& columns,
+                                       RandomAccessIterator indices_first,
+                                       std::size_t size, std::size_t max_threads,
+                                       std::index_sequence<Indices...>)
+            -> void
+        {
+            static_assert(sizeof...(RandomAccessIterables) > 0,
+                          "apply_permutation needs at least one collection to permute");
+            // A tuple of values would only permute copies of the collections
+            static_assert(
+                cppsort::detail::conjunction<std::is_lvalue_reference<RandomAccessIterables>...>::value,
+                "apply_permutation needs a tuple of lvalue references to the collections to permute, "
+                "such as the one returned by std::tie"
+            );
+
+            std::size_t sizes[] = {
+                static_cast<std::size_t>(utility::size(std::get<Indices>(columns)))...
+            };
+            for (auto column_size: sizes) {
+                CPPSORT_ASSERT( column_size == size );
+                (void)column_size;
+            }
+
+            cppsort::detail::parallel_permute_columns(
+                size, indices_source(indices_first), max_threads,
+                std::begin(std::get<Indices>(columns))...
+            );
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Single collection
+
     template<typename RandomAccessIterator1, typename RandomAccessIterator2>
     auto apply_permutation(RandomAccessIterator1 first, RandomAccessIterator1 last,
                            RandomAccessIterator2 indices_first, RandomAccessIterator2 indices_last)
         -> void
     {
-        using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator1>;
-        using utility::iter_move;
         CPPSORT_ASSERT( (last - first) == (indices_last - indices_first) );
         (void)last;
 
-        auto size = indices_last - indices_first;
-        for (difference_type idx = 0; idx < size; ++idx) {
-            if (idx != indices_first[idx]) {
-                auto current_idx = idx;
-                auto tmp = iter_move(first + current_idx);
-                do {
-                    auto next_idx = indices_first[current_idx];
-                    first[current_idx] = iter_move(first + next_idx);
-                    indices_first[current_idx] = current_idx;
-                    current_idx = next_idx;
-                } while (idx != indices_first[current_idx]);
-                indices_first[current_idx] = current_idx;
-                first[current_idx] = std::move(tmp);
-            }
-        }
+        auto size = static_cast<std::size_t>(indices_last - indices_first);
+        cppsort::detail::permute(first, size, detail::indices_source(indices_first));
+    }
+
+    template<typename RandomAccessIterator1, typename RandomAccessIterator2>
+    auto apply_permutation(RandomAccessIterator1 first, RandomAccessIterator1 last,
+                           RandomAccessIterator2 indices_first, RandomAccessIterator2 indices_last,
+                           std::size_t max_threads)
+        -> void
+    {
+        CPPSORT_ASSERT( (last - first) == (indices_last - indices_first) );
+        (void)last;
+
+        auto size = static_cast<std::size_t>(indices_last - indices_first);
+        cppsort::detail::parallel_permute_columns(size, detail::indices_source(indices_first),
+                                                  max_threads, first);
     }
 
-    template<typename RandomAccessIterable1, typename RandomAccessIterable2>
+    template<
+        typename RandomAccessIterable1,
+        typename RandomAccessIterable2,
+        typename = cppsort::detail::enable_if_t<
+            not detail::is_columns<RandomAccessIterable1>::value
+        >
+    >
     auto apply_permutation(RandomAccessIterable1&& iterable, RandomAccessIterable2&& indices)
         -> void
     {
         apply_permutation(std::begin(iterable), std::end(iterable),
                           std::begin(indices), std::end(indices));
     }
+
+    template<
+        typename RandomAccessIterable1,
+        typename RandomAccessIterable2,
+        typename = cppsort::detail::enable_if_t<
+            not detail::is_columns<RandomAccessIterable1>::value
+        >
+    >
+    auto apply_permutation(RandomAccessIterable1&& iterable, RandomAccessIterable2&& indices,
+                           std::size_t max_threads)
+        -> void
+    {
+        apply_permutation(std::begin(iterable), std::end(iterable),
+                          std::begin(indices), std::end(indices),
+                          max_threads);
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Several collections permuted the same way
+
+    template<typename... RandomAccessIterables, typename RandomAccessIterable>
+    auto apply_permutation(std::tuple<RandomAccessIterables...> columns, RandomAccessIterable&& indices)
+        -> void
+    {
+        detail::apply_permutation_columns(columns, std::begin(indices),
+                                          static_cast<std::size_t>(utility::size(indices)), 1,
+                                          std::index_sequence_for<RandomAccessIterables...>{});
+    }
+
+    template<typename... RandomAccessIterables, typename RandomAccessIterable>
+    auto apply_permutation(std::tuple<RandomAccessIterables...> columns, RandomAccessIterable&& indices,
+                           std::size_t max_threads)
+        -> void
+    {
+        detail::apply_permutation_columns(columns, std::begin(indices),
+                                          static_cast<std::size_t>(utility::size(indices)),
+                                          max_threads,
+                                          std::index_sequence_for<RandomAccessIterables...>{});
+    }
 }}
 
 #endif // CPPSORT_UTILITY_APPLY_PERMUTATION_H_
@@ -11,6 +11,8 @@
 #include <array>
 #include <cstddef>
 #include <memory>
+#include <new>
+#include "../detail/memory.h"
 
 namespace cppsort
 {
@@ -173,19 +175,63 @@ namespace utility
         // to reduce template bloat, notably by making sure that it isn't
         // instantiated for every different size policy
 
+        // Destroys the elements of the buffer, then gives its memory
+        // back to where it was allocated from
+
+        template<typename T>
+        struct dynamic_buffer_deleter
+        {
+            cppsort::detail::operator_deleter deallocate;
+            std::size_t count = 0;
+
+            auto operator()(T* pointer) const noexcept
+                -> void
+            {
+                cppsort::detail::destroy_n(pointer, count);
+                deallocate(pointer);
+            }
+        };
+
+        template<typename T>
+        auto make_dynamic_buffer_memory(std::size_t size)
+            -> std::unique_ptr<T, dynamic_buffer_deleter<T>>
+        {
+            // The memory comes from the scratch memory functions
+            // like every other buffer allocated by the algorithms
+            auto memory = cppsort::detail::make_scratch_buffer<T>(size);
+
+            cppsort::detail::destruct_n<T> d(0);
+            std::unique_ptr<T, cppsort::detail::destruct_n<T>&> h2(memory.get(), d);
+            for (std::size_t idx = 0 ; idx < size ; ++idx) {
+                ::new(memory.get() + idx) T();
+                ++d;
+            }
+            h2.release();
+
+            auto deallocate = memory.get_deleter();
+            return std::unique_ptr<T, dynamic_buffer_deleter<T>>(
+                memory.release(),
+                dynamic_buffer_deleter<T>{ deallocate, size }
+            );
+        }
+
+        // This class is used as a base class by dynamic_buffer::buffer
+        // to reduce template bloat, notably by making sure that it isn't
+        // instantiated for every different size policy
+
         template<typename T>
         class dynamic_buffer_impl
         {
             private:
 
                 std::size_t _size;
-                std::unique_ptr<T[]> _memory;
+                std::unique_ptr<T, dynamic_buffer_deleter<T>> _memory;
 
             public:
 
                 explicit dynamic_buffer_impl(std::size_t size):
                     _size(size),
-                    _memory(std::make_unique<T[]>(_size))
+                    _memory(make_dynamic_buffer_memory<T>(_size))
                 {}
 
                 auto size() const
@@ -195,49 +241,49 @@ namespace utility
                 }
 
                 auto operator[](std::size_t pos)
-                    -> decltype(_memory[pos])
+                    -> T&
                 {
-                    return _memory[pos];
+                    return _memory.get()[pos];
                 }
 
                 auto operator[](std::size_t pos) const
-                    -> decltype(_memory[pos])
+                    -> T&
                 {
-                    return _memory[pos];
+                    return _memory.get()[pos];
                 }
 
                 auto begin()
-                    -> decltype(_memory.get())
+                    -> T*
                 {
                     return _memory.get();
                 }
 
                 auto begin() const
-                    -> decltype(_memory.get())
+                    -> T*
                 {
                     return _memory.get();
                 }
 
                 auto cbegin() const
-                    -> decltype(_memory.get())
+                    -> T*
                 {
                     return _memory.get();
                 }
 
                 auto end()
-                    -> decltype(_memory.get() + size())
+                    -> T*
                 {
                     return _memory.get() + size();
                 }
 
                 auto end() const
-                    -> decltype(_memory.get() + size())
+                    -> T*
                 {
                     return _memory.get() + size();
                 }
 
                 auto cend() const
-                    -> decltype(_memory.get() + size())
+                    -> T*
                 {
                     return _memory.get() + size();
                 }
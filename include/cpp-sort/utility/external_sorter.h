@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_EXTERNAL_SORTER_H_
+#define CPPSORT_UTILITY_EXTERNAL_SORTER_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cerrno>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <cpp-sort/utility/adapter_storage.h>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/external_sort.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // External sorter
+    //
+    // Sorts files of fixed-size records that don't fit in memory:
+    // chunks of the input as big as the memory budget are sorted
+    // with the wrapped sorter and written to a temporary file as
+    // sorted runs, which are then merged with a k-way merge that
+    // reads and writes big blocks sequentially
+    //
+
+    template<typename Record, typename Sorter>
+    struct external_sorter:
+        utility::adapter_storage<Sorter>
+    {
+        static_assert(
+            std::is_trivially_copyable<Record>::value,
+            "external_sorter requires trivially copyable records"
+        );
+
+        constexpr explicit external_sorter(std::size_t memory_budget):
+            budget(memory_budget)
+        {}
+
+        constexpr external_sorter(std::size_t memory_budget, Sorter sorter):
+            utility::adapter_storage<Sorter>(std::move(sorter)),
+            budget(memory_budget)
+        {}
+
+        template<
+            typename Compare = std::less<>,
+            typename Projection = utility::identity
+        >
+        auto operator()(std::FILE* input, std::FILE* output,
+                        Compare compare={}, Projection projection={}) const
+            -> void
+        {
+            cppsort::detail::external_sort<Record>(
+                input, output, budget, this->get(),
+                std::move(compare), std::move(projection)
+            );
+        }
+
+        template<
+            typename Compare = std::less<>,
+            typename Projection = utility::identity
+        >
+        auto operator()(const std::string& input_path, const std::string& output_path,
+                        Compare compare={}, Projection projection={}) const
+            -> void
+        {
+            using namespace cppsort::detail::external_sort_detail;
+            auto input = open_file(input_path.c_str(), "rb");
+            if (is_same_file(input.get(), input_path.c_str(), output_path.c_str())) {
+                throw std::system_error(std::make_error_code(std::errc::invalid_argument),
+                                        "cpp-sort: the input and output files must be different");
+            }
+            auto output = open_file(output_path.c_str(), "wb");
+            operator()(input.get(), output.get(), std::move(compare), std::move(projection));
+
+            errno = 0;
+            if (std::fclose(output.release()) != 0) {
+                throw_io_error("cpp-sort: could not write records");
+            }
+        }
+
+        constexpr auto memory_budget() const noexcept
+            -> std::size_t
+        {
+            return budget;
+        }
+
+        private:
+
+            std::size_t budget;
+    };
+}}
+
+#endif // CPPSORT_UTILITY_EXTERNAL_SORTER_H_
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_MULTIWAY_MERGE_H_
+#define CPPSORT_UTILITY_MULTIWAY_MERGE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <cpp-sort/utility/functional.h>
+#include "../detail/loser_tree.h"
+
+namespace cppsort
+{
+namespace utility
+{
+    namespace detail
+    {
+        // Ranges to merge are either iterables or pairs of iterators
+
+        template<typename Range>
+        auto range_begin(Range& range)
+            -> decltype(std::begin(range))
+        {
+            return std::begin(range);
+        }
+
+        template<typename Iterator>
+        auto range_begin(const std::pair<Iterator, Iterator>& range)
+            -> Iterator
+        {
+            return range.first;
+        }
+
+        template<typename Range>
+        auto range_end(Range& range)
+            -> decltype(std::end(range))
+        {
+            return std::end(range);
+        }
+
+        template<typename Iterator>
+        auto range_end(const std::pair<Iterator, Iterator>& range)
+            -> Iterator
+        {
+            return range.second;
+        }
+    }
+
+    template<
+        typename ForwardIterable,
+        typename OutputIterator,
+        typename Compare = std::less<>,
+        typename Projection = utility::identity
+    >
+    auto multiway_merge(ForwardIterable&& ranges, OutputIterator result,
+                        Compare compare={}, Projection projection={})
+        -> OutputIterator
+    {
+        using iterator = decltype(detail::range_begin(*std::begin(ranges)));
+
+        cppsort::detail::loser_tree<iterator, Compare, Projection> tree(
+            std::move(compare), std::move(projection)
+        );
+        for (auto&& range: ranges) {
+            tree.add_source(detail::range_begin(range), detail::range_end(range));
+        }
+
+        return cppsort::detail::multiway_merge(tree, std::move(result),
+            [](iterator it, OutputIterator out) {
+                *out = *it;
+                return ++out;
+            },
+            [](iterator first, iterator last, OutputIterator out) {
+                return std::copy(first, last, out);
+            }
+        );
+    }
+}}
+
+#endif // CPPSORT_UTILITY_MULTIWAY_MERGE_H_
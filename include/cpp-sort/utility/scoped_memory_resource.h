@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_SCOPED_MEMORY_RESOURCE_H_
+#define CPPSORT_UTILITY_SCOPED_MEMORY_RESOURCE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../detail/config.h"
+#include "../detail/memory.h"
+
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#include <memory_resource>
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Redirect the scratch memory of the current thread
+    //
+    // Every buffer allocated by the library's algorithms on the
+    // current thread comes from the given resource for as long
+    // as the object lives, then the previous resource is put
+    // back in place, which allows to nest scopes
+
+    class scoped_memory_resource
+    {
+        public:
+
+            explicit scoped_memory_resource(std::pmr::memory_resource* resource) noexcept:
+                previous_(cppsort::detail::current_scratch_resource())
+            {
+                cppsort::detail::current_scratch_resource() = resource;
+            }
+
+            scoped_memory_resource(const scoped_memory_resource&) = delete;
+            scoped_memory_resource& operator=(const scoped_memory_resource&) = delete;
+
+            ~scoped_memory_resource()
+            {
+                cppsort::detail::current_scratch_resource() = previous_;
+            }
+
+        private:
+
+            std::pmr::memory_resource* previous_;
+    };
+
+    inline auto current_memory_resource() noexcept
+        -> std::pmr::memory_resource*
+    {
+        auto resource = cppsort::detail::current_scratch_resource();
+        return resource != nullptr ? resource : std::pmr::new_delete_resource();
+    }
+}}
+
+#endif // CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#endif // CPPSORT_UTILITY_SCOPED_MEMORY_RESOURCE_H_
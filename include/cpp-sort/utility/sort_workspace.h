@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#ifndef CPPSORT_UTILITY_SORT_WORKSPACE_H_
+#define CPPSORT_UTILITY_SORT_WORKSPACE_H_
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include "../detail/config.h"
+
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+namespace cppsort
+{
+namespace utility
+{
+    ////////////////////////////////////////////////////////////
+    // Scratch memory reused across sorts
+    //
+    // The workspace owns a single block of memory from which the
+    // allocations are carved linearly. Allocations that don't fit
+    // are forwarded to the upstream resource, but the amount of
+    // memory needed at once is recorded: once every allocation
+    // has been given back, the block is grown to that high-water
+    // mark so that the next sorts of similar sizes don't need to
+    // allocate anything from the upstream resource.
+
+    class sort_workspace:
+        public std::pmr::memory_resource
+    {
+        public:
+
+            ////////////////////////////////////////////////////////////
+            // Construction & destruction
+
+            sort_workspace() noexcept:
+                sort_workspace(std::pmr::get_default_resource())
+            {}
+
+            explicit sort_workspace(std::pmr::memory_resource* upstream) noexcept:
+                upstream_(upstream)
+            {}
+
+            explicit sort_workspace(std::size_t initial_capacity,
+                                    std::pmr::memory_resource* upstream = std::pmr::get_default_resource()):
+                upstream_(upstream)
+            {
+                reserve(initial_capacity);
+            }
+
+            sort_workspace(const sort_workspace&) = delete;
+            sort_workspace& operator=(const sort_workspace&) = delete;
+
+            ~sort_workspace() override
+            {
+                release();
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Observers
+
+            // Size of the reusable block
+            auto capacity() const noexcept
+                -> std::size_t
+            {
+                return capacity_;
+            }
+
+            // Greatest amount of memory needed at once so far
+            auto high_water_mark() const noexcept
+                -> std::size_t
+            {
+                return high_water_mark_;
+            }
+
+            auto upstream_resource() const noexcept
+                -> std::pmr::memory_resource*
+            {
+                return upstream_;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Modifiers
+
+            auto reserve(std::size_t new_capacity)
+                -> void
+            {
+                if (new_capacity > capacity_ && live_allocations_ == 0) {
+                    grow(new_capacity);
+                }
+            }
+
+            // Give the block back to the upstream resource, only
+            // valid when no memory is borrowed from the workspace
+            auto release() noexcept
+                -> void
+            {
+                if (block_ != nullptr) {
+                    upstream_->deallocate(block_, capacity_);
+                    block_ = nullptr;
+                    capacity_ = 0;
+                }
+            }
+
+        private:
+
+            ////////////////////////////////////////////////////////////
+            // memory_resource interface
+
+            auto do_allocate(std::size_t bytes, std::size_t alignment)
+                -> void* override
+            {
+                // Memory needed by this allocation in the block, alignment included
+                auto top = reinterpret_cast<std::uintptr_t>(block_) + offset_;
+                auto padding = (alignment - top % alignment) % alignment;
+
+                void* res;
+                if (block_ != nullptr && offset_ + padding + bytes <= capacity_) {
+                    res = block_ + offset_ + padding;
+                    offset_ += padding + bytes;
+                } else {
+                    res = upstream_->allocate(bytes, alignment);
+                    overflow_ += bytes + alignment;
+                }
+                ++live_allocations_;
+                high_water_mark_ = (std::max)(high_water_mark_, offset_ + overflow_);
+                return res;
+            }
+
+            auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+                -> void override
+            {
+                auto bptr = static_cast<std::byte*>(ptr);
+                if (block_ != nullptr && bptr >= block_ && bptr < block_ + capacity_) {
+                    // Memory is released in LIFO order most of the time,
+                    // reclaim it when it is the last allocated block
+                    if (bptr + bytes == block_ + offset_) {
+                        offset_ = static_cast<std::size_t>(bptr - block_);
+                    }
+                } else {
+                    upstream_->deallocate(ptr, bytes, alignment);
+                    overflow_ -= bytes + alignment;
+                }
+
+                if (--live_allocations_ == 0) {
+                    offset_ = 0;
+                    overflow_ = 0;
+                    if (high_water_mark_ > capacity_) {
+                        try {
+                            grow(high_water_mark_);
+                        } catch (...) {
+                            // Keep the current block, it is only an optimization
+                        }
+                    }
+                }
+            }
+
+            auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+                -> bool override
+            {
+                return this == &other;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Helper functions
+
+            auto grow(std::size_t new_capacity)
+                -> void
+            {
+                // Leave some room for the next sorts to be slightly bigger
+                new_capacity += new_capacity / 8;
+                auto new_block = static_cast<std::byte*>(upstream_->allocate(new_capacity));
+                release();
+                block_ = new_block;
+                capacity_ = new_capacity;
+            }
+
+            ////////////////////////////////////////////////////////////
+            // Data members
+
+            std::pmr::memory_resource* upstream_;
+            std::byte* block_ = nullptr;
+            std::size_t capacity_ = 0;
+            // First free byte of the block
+            std::size_t offset_ = 0;
+            // Memory borrowed from the upstream resource
+            std::size_t overflow_ = 0;
+            std::size_t high_water_mark_ = 0;
+            std::size_t live_allocations_ = 0;
+    };
+}}
+
+#endif // CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#endif // CPPSORT_UTILITY_SORT_WORKSPACE_H_
@@ -8,6 +8,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <numeric>
@@ -20,6 +21,7 @@
 #include <cpp-sort/utility/as_function.h>
 #include <cpp-sort/utility/functional.h>
 #include "../detail/checkers.h"
+#include "../detail/config.h"
 #include "../detail/iterator_traits.h"
 #include "../detail/type_traits.h"
 
@@ -29,7 +31,7 @@ namespace utility
 {
     namespace detail
     {
-        template<typename Sorter>
+        template<typename Sorter, typename IndexType>
         struct sorted_indices_impl:
             utility::adapter_storage<Sorter>,
             cppsort::detail::check_is_always_stable<Sorter>
@@ -50,7 +52,11 @@ namespace utility
             >
             auto operator()(RandomAccessIterator first, RandomAccessIterator last,
                             Compare compare={}, Projection projection={}) const
-                -> std::vector<cppsort::detail::difference_type_t<RandomAccessIterator>>
+                -> std::vector<cppsort::detail::conditional_t<
+                    std::is_void<IndexType>::value,
+                    cppsort::detail::difference_type_t<RandomAccessIterator>,
+                    IndexType
+                >>
             {
                 static_assert(
                     std::is_base_of<
@@ -61,16 +67,31 @@ namespace utility
                 );
 
                 using difference_type = cppsort::detail::difference_type_t<RandomAccessIterator>;
+                using index_type = cppsort::detail::conditional_t<
+                    std::is_void<IndexType>::value,
+                    difference_type,
+                    IndexType
+                >;
+                static_assert(
+                    std::is_integral<index_type>::value,
+                    "sorted_indices requires an integral index type"
+                );
                 auto&& proj = utility::as_function(projection);
 
+                // Smaller indices mean less memory to move around during
+                // the sort, but they have to be able to index every element
+                auto size = last - first;
+                CPPSORT_ASSERT( size == 0 ||
+                                static_cast<difference_type>(static_cast<index_type>(size - 1)) == size - 1 );
+
                 // Create a vector of indices
-                std::vector<difference_type> indices(last - first, 0);
-                std::iota(indices.begin(), indices.end(), 0);
+                std::vector<index_type> indices(static_cast<std::size_t>(size), 0);
+                std::iota(indices.begin(), indices.end(), index_type(0));
 
                 // Reorder the vector thanks to the passed sorter
                 this->get()(indices, std::move(compare),
-                            [&first, &proj](difference_type index) -> auto& {
-                                return proj(first[index]);
+                            [&first, &proj](index_type index) -> auto& {
+                                return proj(first[static_cast<difference_type>(index)]);
                             });
 
                 // Return the indices that would sort the array
@@ -84,14 +105,14 @@ namespace utility
         };
     }
 
-    template<typename Sorter>
+    template<typename Sorter, typename IndexType=void>
     struct sorted_indices:
-        sorter_facade<detail::sorted_indices_impl<Sorter>>
+        sorter_facade<detail::sorted_indices_impl<Sorter, IndexType>>
     {
         sorted_indices() = default;
 
         constexpr explicit sorted_indices(Sorter sorter):
-            sorter_facade<detail::sorted_indices_impl<Sorter>>(std::move(sorter))
+            sorter_facade<detail::sorted_indices_impl<Sorter, IndexType>>(std::move(sorter))
         {}
     };
 }}
@@ -101,8 +122,8 @@ namespace cppsort
     ////////////////////////////////////////////////////////////
     // is_stable specialization
 
-    template<typename Sorter, typename... Args>
-    struct is_stable<cppsort::utility::sorted_indices<Sorter>(Args...)>:
+    template<typename Sorter, typename IndexType, typename... Args>
+    struct is_stable<cppsort::utility::sorted_indices<Sorter, IndexType>(Args...)>:
         is_stable<Sorter(Args...)>
     {};
 }
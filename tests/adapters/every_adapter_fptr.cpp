@@ -98,6 +98,17 @@ TEST_CASE( "function pointer test for every adapter",
         CHECK( std::is_sorted(fli.begin(), fli.end(), std::greater<>{}) );
     }
 
+    SECTION( "packed_schwartz_adapter" )
+    {
+        using sorter = cppsort::packed_schwartz_adapter<
+            cppsort::poplar_sorter
+        >;
+        constexpr void(*sort_it)(std::vector<short int>&, std::greater<>) = sorter{};
+
+        sort_it(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
     SECTION( "schwartz_adapter" )
     {
         using sorter = cppsort::schwartz_adapter<
@@ -74,6 +74,16 @@ TEST_CASE( "test most adapters with a pointer to member function comparison",
         CHECK( std::is_sorted(li.begin(), li.end()) );
     }
 
+    SECTION( "packed_schwartz_adapter" )
+    {
+        using sorter = cppsort::packed_schwartz_adapter<
+            cppsort::poplar_sorter
+        >;
+
+        sorter{}(collection, &internal_compare<int>::compare_to, std::negate<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
     SECTION( "schwartz_adapter" )
     {
         using sorter = cppsort::schwartz_adapter<
@@ -87,6 +87,16 @@ TEST_CASE( "test adapters extended compatibility with LWG 3031", "[adapters]" )
         CHECK( std::is_sorted(li.begin(), li.end()) );
     }
 
+    SECTION( "packed_schwartz_adapter" )
+    {
+        using sorter = cppsort::packed_schwartz_adapter<
+            cppsort::detail::poplar_sorter_impl
+        >;
+
+        sorter{}(vec, non_const_compare, fake_identity{});
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
     SECTION( "schwartz_adapter" )
     {
         using sorter = cppsort::schwartz_adapter<
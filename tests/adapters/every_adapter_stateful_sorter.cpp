@@ -145,6 +145,15 @@ TEST_CASE( "test stateful sorters with every adapter",
         CHECK( std::is_sorted(fli.begin(), fli.end(), std::greater<>{}) );
     }
 
+    SECTION( "packed_schwartz_adapter" )
+    {
+        stateful_sorter<> sorter(42);
+        cppsort::packed_schwartz_adapter<stateful_sorter<>> sort_it(sorter);
+
+        sort_it(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
     SECTION( "schwartz_adapter" )
     {
         stateful_sorter<> sorter(42);
@@ -14,6 +14,7 @@
 TEMPLATE_TEST_CASE( "test adapters with an int8_t difference_type", "[adapters]",
                     cppsort::indirect_adapter<cppsort::poplar_sorter>,
                     cppsort::out_of_place_adapter<cppsort::poplar_sorter>,
+                    cppsort::packed_schwartz_adapter<cppsort::poplar_sorter>,
                     cppsort::schwartz_adapter<cppsort::poplar_sorter>,
                     cppsort::stable_adapter<cppsort::poplar_sorter>,
                     cppsort::verge_adapter<cppsort::poplar_sorter>
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: MIT
  */
 #include <algorithm>
+#include <array>
 #include <functional>
 #include <iterator>
 #include <vector>
@@ -12,6 +13,7 @@
 #include <cpp-sort/sorters/spread_sorter.h>
 #include <testing-tools/algorithm.h>
 #include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
 #include <testing-tools/span.h>
 
 TEST_CASE( "basic tests with indirect_adapter",
@@ -104,3 +106,32 @@ TEST_CASE( "indirect_adapter over non-comparison sorter",
     sorter(collection, std::negate<>{});
     CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
 }
+
+TEST_CASE( "indirect_adapter with big collections",
+           "[indirect_adapter]" )
+{
+    // Big collections of small elements are permuted through a
+    // buffer, bigger elements are permuted by following cycles
+
+    auto distribution = dist::shuffled{};
+    cppsort::indirect_adapter<cppsort::quick_sorter> sorter;
+
+    SECTION( "small elements" )
+    {
+        std::vector<int> collection;
+        distribution(std::back_inserter(collection), 100'000, -32);
+        sorter(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "big elements" )
+    {
+        std::vector<std::array<long long int, 16>> collection;
+        for (int idx = 0 ; idx < 100'000 ; ++idx) {
+            collection.push_back({{ idx }});
+        }
+        std::shuffle(collection.begin(), collection.end(), hasard::engine());
+        sorter(collection, [](const auto& arr) { return arr[0]; });
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+}
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/memory_resource_adapter.h>
+
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#include <memory_resource>
+#include <cpp-sort/adapters/indirect_adapter.h>
+#include <cpp-sort/adapters/packed_schwartz_adapter.h>
+#include <cpp-sort/adapters/schwartz_adapter.h>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/probes/enc.h>
+#include <cpp-sort/probes/inv.h>
+#include <cpp-sort/probes/osc.h>
+#include <cpp-sort/sorters/drop_merge_sorter.h>
+#include <cpp-sort/sorters/grail_sorter.h>
+#include <cpp-sort/sorters/ips4o_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/multiway_merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sorters/wiki_sorter.h>
+#include <cpp-sort/utility/buffer.h>
+#include <cpp-sort/utility/scoped_memory_resource.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    struct counting_resource:
+        std::pmr::memory_resource
+    {
+        std::size_t allocations = 0;
+        std::size_t live_allocations = 0;
+
+        auto do_allocate(std::size_t bytes, std::size_t alignment)
+            -> void* override
+        {
+            ++allocations;
+            ++live_allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+            -> void override
+        {
+            --live_allocations;
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override
+        {
+            return this == &other;
+        }
+    };
+
+    template<typename Sorter, typename Collection>
+    auto check_sorter(Collection collection)
+        -> void
+    {
+        counting_resource resource;
+        cppsort::memory_resource_adapter<Sorter> sorter(&resource);
+        CHECK( sorter.memory_resource() == &resource );
+
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( resource.allocations > 0 );
+        CHECK( resource.live_allocations == 0 );
+    }
+}
+
+TEST_CASE( "memory_resource_adapter tests", "[memory_resource_adapter]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000, -2'500);
+
+    SECTION( "buffered sorters" )
+    {
+        check_sorter<cppsort::merge_sorter>(collection);
+        check_sorter<cppsort::tim_sorter>(collection);
+        check_sorter<cppsort::spin_sorter>(collection);
+        check_sorter<cppsort::drop_merge_sorter>(collection);
+    }
+
+    SECTION( "sorters with internal containers" )
+    {
+        using buffer_t = cppsort::utility::dynamic_buffer<cppsort::utility::half>;
+        check_sorter<cppsort::grail_sorter<buffer_t>>(collection);
+        check_sorter<cppsort::wiki_sorter<buffer_t>>(collection);
+        check_sorter<cppsort::ips4o_sorter>(collection);
+        check_sorter<cppsort::multiway_merge_sorter>(collection);
+    }
+
+    SECTION( "allocating adapters" )
+    {
+        check_sorter<cppsort::indirect_adapter<cppsort::pdq_sorter>>(collection);
+        check_sorter<cppsort::stable_adapter<cppsort::pdq_sorter>>(collection);
+
+        counting_resource packed_resource;
+        cppsort::memory_resource_adapter<
+            cppsort::packed_schwartz_adapter<cppsort::pdq_sorter>
+        > packed_sorter(&packed_resource);
+        auto copy = collection;
+        packed_sorter(copy, [](int value) { return -value; });
+        CHECK( std::is_sorted(copy.rbegin(), copy.rend()) );
+        CHECK( packed_resource.allocations > 0 );
+        CHECK( packed_resource.live_allocations == 0 );
+
+        std::vector<std::string> strings;
+        for (int value: collection) {
+            strings.push_back(std::to_string(value));
+        }
+        counting_resource resource;
+        cppsort::memory_resource_adapter<cppsort::schwartz_adapter<cppsort::pdq_sorter>> sorter(&resource);
+        sorter(strings, &std::string::size);
+        CHECK( std::is_sorted(strings.begin(), strings.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.size() < rhs.size();
+        }) );
+        CHECK( resource.allocations > 0 );
+        CHECK( resource.live_allocations == 0 );
+    }
+
+    SECTION( "monotonic arena" )
+    {
+        // Fails if the sorter needs more memory than the arena holds
+        std::vector<std::byte> memory(1 << 20);
+        std::pmr::monotonic_buffer_resource arena(memory.data(), memory.size(),
+                                                  std::pmr::null_memory_resource());
+        cppsort::memory_resource_adapter<cppsort::tim_sorter> sorter(&arena);
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "nested scopes and probes" )
+    {
+        counting_resource outer;
+        counting_resource inner;
+        {
+            cppsort::utility::scoped_memory_resource outer_scope(&outer);
+            CHECK( cppsort::utility::current_memory_resource() == &outer );
+            {
+                cppsort::utility::scoped_memory_resource inner_scope(&inner);
+                CHECK( cppsort::utility::current_memory_resource() == &inner );
+                (void)cppsort::probe::inv(collection);
+                (void)cppsort::probe::enc(collection);
+            }
+            CHECK( cppsort::utility::current_memory_resource() == &outer );
+            (void)cppsort::probe::osc(collection);
+        }
+        CHECK( cppsort::utility::current_memory_resource() == std::pmr::new_delete_resource() );
+
+        CHECK( inner.allocations > 0 );
+        CHECK( inner.live_allocations == 0 );
+        CHECK( outer.allocations > 0 );
+        CHECK( outer.live_allocations == 0 );
+    }
+}
+
+#endif // CPPSORT_MEMORY_RESOURCE_AVAILABLE
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/packed_schwartz_adapter.h>
+#include <cpp-sort/sorter_traits.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    struct record
+    {
+        double key;
+        int id;
+        char payload[200];
+    };
+
+    auto make_records(const std::vector<double>& keys)
+        -> std::vector<record>
+    {
+        std::vector<record> res;
+        for (int idx = 0 ; idx < static_cast<int>(keys.size()) ; ++idx) {
+            res.push_back({ keys[idx], idx, {} });
+            res.back().payload[0] = static_cast<char>(idx);
+        }
+        return res;
+    }
+
+    auto same_records(const std::vector<record>& lhs, const std::vector<record>& rhs)
+        -> bool
+    {
+        return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(),
+                          [](const record& lhs, const record& rhs) {
+                              return lhs.key == rhs.key
+                                  && lhs.id == rhs.id
+                                  && lhs.payload[0] == rhs.payload[0];
+                          });
+    }
+}
+
+TEST_CASE( "packed_schwartz_adapter tests", "[packed_schwartz_adapter]" )
+{
+    std::vector<double> keys;
+    auto distribution = dist::shuffled{};
+    distribution.call<double>(std::back_inserter(keys), 10'000, -2'500);
+
+    SECTION( "big records sorted by a double field" )
+    {
+        auto collection = make_records(keys);
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const record& lhs, const record& rhs) { return lhs.key > rhs.key; });
+
+        cppsort::packed_schwartz_adapter<cppsort::pdq_sorter> sorter;
+        sorter(collection, std::greater<>{}, &record::key);
+        CHECK( same_records(collection, expected) );
+    }
+
+    SECTION( "radix sorter over the keys" )
+    {
+        auto collection = make_records(keys);
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const record& lhs, const record& rhs) { return lhs.key < rhs.key; });
+
+        cppsort::packed_schwartz_adapter<cppsort::ska_sorter> sorter;
+        sorter(collection.begin(), collection.end(), &record::key);
+        CHECK( same_records(collection, expected) );
+    }
+
+    SECTION( "small keys with small indices" )
+    {
+        auto collection = make_records(keys);
+        std::reverse(collection.begin(), collection.end());
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end(),
+                  [](const record& lhs, const record& rhs) { return lhs.id < rhs.id; });
+
+        // An int key is packed with a 32-bit index, a double key isn't
+        static_assert(cppsort::detail::shrinks_with_small_index<int>::value, "");
+        static_assert(not cppsort::detail::shrinks_with_small_index<double>::value, "");
+
+        cppsort::packed_schwartz_adapter<cppsort::pdq_sorter> sorter;
+        sorter(collection, &record::id);
+        CHECK( same_records(collection, expected) );
+    }
+
+    SECTION( "stability" )
+    {
+        std::vector<double> few_keys;
+        auto distribution = dist::shuffled_16_values{};
+        distribution.call<double>(std::back_inserter(few_keys), 10'000);
+
+        auto collection = make_records(few_keys);
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const record& lhs, const record& rhs) { return lhs.key < rhs.key; });
+
+        using sorter = cppsort::packed_schwartz_adapter<cppsort::merge_sorter>;
+        CHECK( cppsort::is_stable<sorter(std::vector<record>&, double record::*)>::value );
+        sorter{}(collection, &record::key);
+        CHECK( same_records(collection, expected) );
+    }
+
+    SECTION( "move-only elements" )
+    {
+        std::vector<std::unique_ptr<double>> collection;
+        for (double key: keys) {
+            collection.push_back(std::make_unique<double>(key));
+        }
+
+        cppsort::packed_schwartz_adapter<cppsort::pdq_sorter> sorter;
+        sorter(collection, [](const std::unique_ptr<double>& ptr) { return *ptr; });
+        CHECK( std::is_sorted(collection.begin(), collection.end(),
+                              [](const auto& lhs, const auto& rhs) { return *lhs < *rhs; }) );
+    }
+}
@@ -25,6 +25,7 @@ using wrapper = generic_wrapper<T>;
 TEMPLATE_TEST_CASE( "every sorter with Schwartzian transform adapter and reverse iterators",
                     "[schwartz_adapter][reverse_iterator]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::adaptive_sorter,
                     cppsort::cartesian_tree_sorter,
                     cppsort::d_ary_heap_sorter<8>,
                     cppsort::default_sorter,
@@ -32,11 +33,16 @@ TEMPLATE_TEST_CASE( "every sorter with Schwartzian transform adapter and reverse
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::ips4o_sorter,
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::multiway_merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::power_sorter,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
                     cppsort::selection_sorter,
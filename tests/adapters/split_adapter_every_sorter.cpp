@@ -14,6 +14,7 @@
 
 TEMPLATE_TEST_CASE( "every random-access sorter with split_adapter", "[split_adapter]",
                     cppsort::adaptive_shivers_sorter,
+                    cppsort::adaptive_sorter,
                     cppsort::cartesian_tree_sorter,
                     cppsort::d_ary_heap_sorter<2>,
                     cppsort::default_sorter,
@@ -21,11 +22,18 @@ TEMPLATE_TEST_CASE( "every random-access sorter with split_adapter", "[split_ada
                     cppsort::grail_sorter<>,
                     cppsort::heap_sorter,
                     cppsort::insertion_sorter,
+                    cppsort::ips4o_sorter,
+                    cppsort::lsd_radix_sorter,
                     cppsort::mel_sorter,
                     cppsort::merge_insertion_sorter,
                     cppsort::merge_sorter,
+                    cppsort::multiway_merge_sorter,
+                    cppsort::parallel_merge_sorter,
+                    cppsort::parallel_pdq_sorter,
+                    cppsort::parallel_ska_sorter,
                     cppsort::pdq_sorter,
                     cppsort::poplar_sorter,
+                    cppsort::power_sorter,
                     cppsort::quick_merge_sorter,
                     cppsort::quick_sorter,
                     cppsort::selection_sorter,
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/metrics/algorithm_events.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "basic metrics::algorithm_events tests", "[metrics]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    SECTION( "pdqsort partitions" )
+    {
+        cppsort::metrics::algorithm_events<cppsort::pdq_sorter> sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().enabled );
+        CHECK( res.value().partitions > 0 );
+        CHECK( res.value().unbalanced_partitions <= res.value().partitions );
+        CHECK( res.value().runs == 0 );
+    }
+
+    SECTION( "timsort runs and galloping" )
+    {
+        // Two runs made of interleaved blocks of values, which
+        // makes the merge switch galloping mode on and off
+        collection.clear();
+        for (int parity = 0 ; parity < 2 ; ++parity) {
+            for (int block = parity ; block < 20 ; block += 2) {
+                for (int idx = 0 ; idx < 100 ; ++idx) {
+                    collection.push_back(block * 100 + idx);
+                }
+            }
+        }
+
+        cppsort::metrics::algorithm_events<cppsort::tim_sorter> sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().runs == 2 );
+        CHECK( res.value().gallop_enters > 0 );
+        CHECK( res.value().gallop_exits <= res.value().gallop_enters );
+        CHECK( res.value().partitions == 0 );
+    }
+
+    SECTION( "merge sort buffer growth" )
+    {
+        std::list<int> li(collection.begin(), collection.end());
+        cppsort::metrics::algorithm_events<cppsort::merge_sorter> sorter;
+        auto res = sorter(li);
+        CHECK( std::is_sorted(li.begin(), li.end()) );
+        CHECK( res.value().buffer_growths > 0 );
+        CHECK( res.value().buffer_growth_failures == 0 );
+    }
+
+    SECTION( "sorter without events" )
+    {
+        cppsort::metrics::algorithm_events<cppsort::heap_sorter> sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().partitions == 0 );
+        CHECK( res.value().runs == 0 );
+        CHECK( res.value().buffer_growths == 0 );
+    }
+
+    SECTION( "nested metrics" )
+    {
+        std::vector<int> copy = collection;
+        auto inner_res = cppsort::metrics::algorithm_events<cppsort::pdq_sorter>{}(copy);
+
+        cppsort::metrics::algorithm_events<
+            cppsort::metrics::algorithm_events<cppsort::pdq_sorter>
+        > sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().partitions == inner_res.value().partitions );
+        CHECK( res.value().unbalanced_partitions == inner_res.value().unbalanced_partitions );
+    }
+
+    SECTION( "print the values" )
+    {
+        cppsort::metrics::algorithm_events<cppsort::pdq_sorter> sorter;
+        auto res = sorter(collection);
+
+        std::ostringstream stream;
+        stream << res;
+        CHECK( stream.str().find("heapsort fallbacks: ") != std::string::npos );
+    }
+}
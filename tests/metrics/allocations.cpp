@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/packed_schwartz_adapter.h>
+#include <cpp-sort/metrics/allocations.h>
+#include <cpp-sort/sorters/grail_sorter.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/sorters/wiki_sorter.h>
+#include <cpp-sort/utility/buffer.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "basic metrics::allocations tests", "[metrics]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    SECTION( "sorter allocating memory" )
+    {
+        cppsort::metrics::allocations<cppsort::merge_sorter> sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().count > 0 );
+        CHECK( res.value().peak_bytes > 0 );
+        CHECK( res.value().peak_bytes <= res.value().bytes );
+    }
+
+    SECTION( "sorters with a dynamic buffer" )
+    {
+        using buffer_t = cppsort::utility::dynamic_buffer<cppsort::utility::half>;
+        std::size_t buffer_bytes = collection.size() / 2 * sizeof(int);
+
+        auto grail_res = cppsort::metrics::allocations<cppsort::grail_sorter<buffer_t>>{}(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( grail_res.value().count > 0 );
+        CHECK( grail_res.value().bytes >= buffer_bytes );
+
+        std::reverse(collection.begin(), collection.end());
+        auto wiki_res = cppsort::metrics::allocations<cppsort::wiki_sorter<buffer_t>>{}(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( wiki_res.value().count > 0 );
+        CHECK( wiki_res.value().bytes >= buffer_bytes );
+    }
+
+    SECTION( "adapter storing keys" )
+    {
+        cppsort::metrics::allocations<
+            cppsort::packed_schwartz_adapter<cppsort::pdq_sorter>
+        > sorter;
+        auto res = sorter(collection, [](int value) { return -value; });
+        CHECK( std::is_sorted(collection.rbegin(), collection.rend()) );
+        CHECK( res.value().count > 0 );
+        // Every key is stored with a 32-bit index
+        CHECK( res.value().bytes >= collection.size() * 2 * sizeof(int) );
+    }
+
+    SECTION( "sorter not allocating memory" )
+    {
+        cppsort::metrics::allocations<cppsort::heap_sorter> sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().count == 0 );
+        CHECK( res.value().bytes == 0 );
+        CHECK( res.value().peak_bytes == 0 );
+    }
+
+    SECTION( "nested metrics" )
+    {
+        cppsort::metrics::allocations<
+            cppsort::metrics::allocations<cppsort::tim_sorter>
+        > sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().count > 0 );
+
+        // Make sure that the results of the inner metric are also
+        // taken into account by the outer one
+        std::reverse(collection.begin(), collection.end());
+        auto inner_res = cppsort::metrics::allocations<cppsort::tim_sorter>{}(collection);
+        std::reverse(collection.begin(), collection.end());
+        auto outer_res = sorter(collection);
+        CHECK( outer_res.value().count == inner_res.value().count );
+        CHECK( outer_res.value().bytes == inner_res.value().bytes );
+        CHECK( outer_res.value().peak_bytes == inner_res.value().peak_bytes );
+    }
+
+    SECTION( "print the values" )
+    {
+        cppsort::metrics::allocations<cppsort::merge_sorter> sorter;
+        auto res = sorter(collection);
+
+        std::ostringstream stream;
+        stream << res;
+        CHECK( stream.str().find("peak bytes: ") != std::string::npos );
+    }
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/container_aware_adapter.h>
+#include <cpp-sort/metrics/combine.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "basic metrics::combine tests", "[metrics]" )
+{
+    using namespace std::chrono_literals;
+    using std::get;
+    namespace metrics = cppsort::metrics;
+
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1'000);
+    const std::vector<int> original = collection;
+
+    SECTION( "same counts as the individual metrics" )
+    {
+        std::vector<int> copy = collection;
+        auto comparisons = metrics::comparisons<cppsort::heap_sorter>{}(copy);
+        copy = original;
+        auto moves = metrics::moves<cppsort::heap_sorter>{}(copy);
+        copy = original;
+        auto projections = metrics::projections<cppsort::heap_sorter>{}(copy);
+
+        metrics::combine<
+            cppsort::heap_sorter,
+            metrics::comparisons_tag,
+            metrics::moves_tag,
+            metrics::projections_tag
+        > sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( get<metrics::comparisons_tag>(res) == comparisons );
+        CHECK( get<metrics::moves_tag>(res) == moves );
+        CHECK( get<metrics::projections_tag>(res) == projections );
+        CHECK( get<0>(res) == comparisons );
+    }
+
+    SECTION( "counting and observing metrics" )
+    {
+        std::list<int> li(collection.begin(), collection.end());
+        std::list<int> copy = li;
+        auto comparisons = metrics::comparisons<cppsort::merge_sorter>{}(copy, std::greater<>{});
+
+        metrics::combine<
+            cppsort::merge_sorter,
+            metrics::running_time_tag,
+            metrics::comparisons_tag,
+            metrics::allocations_tag
+        > sorter;
+        auto res = sorter(li, std::greater<>{});
+        CHECK( std::is_sorted(li.begin(), li.end(), std::greater<>{}) );
+        CHECK( get<metrics::running_time_tag>(res) > 0s );
+        CHECK( get<metrics::comparisons_tag>(res) == comparisons );
+        // Allocations of the counting wrappers are not measured
+        CHECK( get<metrics::allocations_tag>(res).value().count > 0 );
+    }
+
+    SECTION( "container-aware sorter relinking list nodes" )
+    {
+        // The first node of the list is not the first one anymore
+        // once the counting pass is over, the values must still be
+        // restored from the actual beginning of the list
+        std::list<int> li(collection.begin(), collection.begin() + 50);
+        li.sort(std::greater<>{});
+        std::list<int> copy = li;
+        auto comparisons = metrics::comparisons<
+            cppsort::container_aware_adapter<cppsort::insertion_sorter>
+        >{}(copy);
+
+        metrics::combine<
+            cppsort::container_aware_adapter<cppsort::insertion_sorter>,
+            metrics::comparisons_tag,
+            metrics::running_time_tag
+        > sorter;
+        auto res = sorter(li);
+        CHECK( li.size() == 50 );
+        CHECK( li == copy );
+        CHECK( get<metrics::comparisons_tag>(res) == comparisons );
+    }
+
+    SECTION( "move-only elements" )
+    {
+        // Only the mix of counting and observing metrics needs
+        // to copy the collection
+        std::vector<std::unique_ptr<int>> vec;
+        for (int value: collection) {
+            vec.push_back(std::make_unique<int>(value));
+        }
+        auto deref = [](const std::unique_ptr<int>& ptr) { return *ptr; };
+
+        metrics::combine<
+            cppsort::pdq_sorter,
+            metrics::comparisons_tag
+        > counting_sorter;
+        auto res = counting_sorter(vec, deref);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](auto& lhs, auto& rhs) {
+            return *lhs < *rhs;
+        }) );
+        CHECK( get<metrics::comparisons_tag>(res) > 0 );
+
+        std::reverse(vec.begin(), vec.end());
+        metrics::combine<
+            cppsort::pdq_sorter,
+            metrics::running_time_tag
+        > observing_sorter;
+        (void) observing_sorter(vec, deref);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](auto& lhs, auto& rhs) {
+            return *lhs < *rhs;
+        }) );
+    }
+
+    SECTION( "sorter without comparison support" )
+    {
+        metrics::combine<
+            cppsort::ska_sorter,
+            metrics::running_time_tag,
+            metrics::cpu_cycles_tag
+        > sorter;
+        auto res = sorter(collection.begin(), collection.end());
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( get<metrics::running_time_tag>(res) > 0s );
+        CHECK( get<metrics::cpu_cycles_tag>(res) > 0 );
+    }
+
+    SECTION( "projection" )
+    {
+        std::vector<generic_wrapper<int>> vec(collection.begin(), collection.end());
+        metrics::combine<
+            cppsort::heap_sorter,
+            metrics::projections_tag
+        > sorter;
+        auto res = sorter(vec, &generic_wrapper<int>::value);
+        CHECK( std::is_sorted(vec.begin(), vec.end(), [](auto& lhs, auto& rhs) {
+            return lhs.value < rhs.value;
+        }) );
+        CHECK( get<metrics::projections_tag>(res) > 0 );
+    }
+}
+
+TEST_CASE( "metrics::combine JSON serialization", "[metrics]" )
+{
+    namespace metrics = cppsort::metrics;
+
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 100);
+
+    metrics::combine<
+        cppsort::merge_sorter,
+        metrics::comparisons_tag,
+        metrics::allocations_tag,
+        metrics::hardware_counters_tag
+    > sorter;
+    auto res = sorter(collection);
+    auto json = metrics::to_json(res);
+
+    CHECK( json.front() == '{' );
+    CHECK( json.back() == '}' );
+    CHECK( json.find("\"comparisons\": ") != std::string::npos );
+    CHECK( json.find("\"allocations\": {\"count\": ") != std::string::npos );
+    CHECK( json.find("\"hardware_counters\": {\"cycles\": ") != std::string::npos );
+    CHECK( std::count(json.begin(), json.end(), '{') == std::count(json.begin(), json.end(), '}') );
+}
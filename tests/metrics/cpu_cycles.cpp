@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/container_aware_adapter.h>
+#include <cpp-sort/metrics/cpu_cycles.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/splay_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "basic metrics::cpu_cycles tests", "[metrics]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1'000);
+
+    SECTION( "single measure" )
+    {
+        cppsort::metrics::cpu_cycles<cppsort::heap_sorter> sorter;
+        auto res = sorter(collection);
+        CHECK( res > 0 );
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "single measure with iterators" )
+    {
+        std::list<int> li(collection.begin(), collection.end());
+        cppsort::metrics::cpu_cycles<cppsort::splay_sorter> sorter;
+        auto res = sorter(li.begin(), li.end());
+        CHECK( res > 0 );
+        CHECK( std::is_sorted(li.begin(), li.end()) );
+    }
+}
+
+TEST_CASE( "metrics::cpu_cycles with repetitions", "[metrics]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 1'000);
+
+    SECTION( "iterable" )
+    {
+        cppsort::metrics::cpu_cycles<cppsort::heap_sorter, 5> sorter;
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( res.value().min > 0 );
+        CHECK( res.value().min <= res.value().median );
+        CHECK( res.value().median <= res.value().max );
+    }
+
+    SECTION( "iterators and comparison" )
+    {
+        std::list<int> li(collection.begin(), collection.end());
+        cppsort::metrics::cpu_cycles<cppsort::splay_sorter, 4> sorter;
+        auto res = sorter(li.begin(), li.end(), std::greater<>{});
+        CHECK( std::is_sorted(li.begin(), li.end(), std::greater<>{}) );
+        CHECK( res.value().min <= res.value().median );
+        CHECK( res.value().median <= res.value().max );
+    }
+
+    SECTION( "container-aware sorter relinking list nodes" )
+    {
+        // Every repetition but the first one restores the values
+        // of a list whose first node was moved by the sort
+        std::list<int> li(collection.begin(), collection.begin() + 50);
+        li.sort(std::greater<>{});
+        std::list<int> expected = li;
+        expected.sort();
+
+        cppsort::metrics::cpu_cycles<
+            cppsort::container_aware_adapter<cppsort::insertion_sorter>, 3
+        > sorter;
+        (void) sorter(li);
+        CHECK( li.size() == 50 );
+        CHECK( li == expected );
+    }
+
+    SECTION( "print the values" )
+    {
+        cppsort::metrics::cpu_cycles<cppsort::heap_sorter, 3> sorter;
+        auto res = sorter(collection);
+
+        std::ostringstream stream;
+        stream << res;
+        CHECK( stream.str().find("median: ") != std::string::npos );
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/metrics/hardware_counters.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "basic metrics::hardware_counters tests", "[metrics]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'000);
+
+    cppsort::metrics::hardware_counters<cppsort::pdq_sorter> sorter;
+
+    SECTION( "sort and count" )
+    {
+        auto res = sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+
+        // Counters might not be available in the testing environment
+        if (res.value().cycles.available) {
+            CHECK( res.value().cycles.value > 0 );
+        }
+        if (res.value().instructions.available) {
+            CHECK( res.value().instructions.value > 10'000 );
+        }
+    }
+
+    SECTION( "print the counters" )
+    {
+        auto res = sorter(collection.begin(), collection.end(), std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+
+        std::ostringstream stream;
+        stream << res;
+        auto str = stream.str();
+        CHECK( str.find("cycles: ") != std::string::npos );
+        CHECK( str.find("branch misses: ") != std::string::npos );
+    }
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/metrics/latency_histogram.h>
+#include <cpp-sort/sorters/heap_sorter.h>
+#include <cpp-sort/sorters/splay_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEST_CASE( "basic metrics::latency_histogram tests", "[metrics]" )
+{
+    using namespace std::chrono_literals;
+    using snapshot_t = cppsort::metrics::latency_histogram_snapshot;
+
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+
+    SECTION( "record several calls" )
+    {
+        cppsort::metrics::latency_histogram<cppsort::heap_sorter> sorter;
+        for (int i = 0 ; i < 50 ; ++i) {
+            collection.clear();
+            distribution(std::back_inserter(collection), 100);
+            auto res = sorter(collection);
+            CHECK( res > 0s );
+            CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        }
+        collection.clear();
+        distribution(std::back_inserter(collection), 5'000);
+        sorter(collection.begin(), collection.end());
+
+        auto snapshot = sorter.snapshot();
+        CHECK( snapshot.count() == 51 );
+        CHECK( snapshot.count(snapshot_t::size_class_of(100)) == 50 );
+        CHECK( snapshot.count(snapshot_t::size_class_of(5'000)) == 1 );
+        CHECK( snapshot.count(snapshot_t::size_class_of(0)) == 0 );
+
+        auto p50 = snapshot.percentile(0.5, snapshot_t::size_class_of(100));
+        auto p99 = snapshot.percentile(0.99, snapshot_t::size_class_of(100));
+        CHECK( p50 > 0ns );
+        CHECK( p50 <= p99 );
+        CHECK( snapshot.percentile(0.5) <= snapshot.percentile(1.0) );
+        CHECK( snapshot.percentile(0.5, 0) == 0ns );
+    }
+
+    SECTION( "copies share the histogram" )
+    {
+        cppsort::metrics::latency_histogram<cppsort::splay_sorter> sorter;
+        auto copy = sorter;
+
+        std::list<int> li;
+        distribution(std::back_inserter(li), 64);
+        sorter(li);
+        copy(li);
+        CHECK( sorter.snapshot().count() == 2 );
+        CHECK( copy.snapshot().count(snapshot_t::size_class_of(64)) == 2 );
+
+        copy.reset();
+        CHECK( sorter.snapshot().count() == 0 );
+    }
+
+    SECTION( "print the values" )
+    {
+        cppsort::metrics::latency_histogram<cppsort::heap_sorter> sorter;
+        distribution(std::back_inserter(collection), 100);
+        sorter(collection);
+
+        std::ostringstream stream;
+        stream << sorter.snapshot();
+        CHECK( stream.str().find("size >= 64: count: 1, p50: ") != std::string::npos );
+    }
+}
+
+TEST_CASE( "metrics::latency_histogram buckets", "[metrics]" )
+{
+    using namespace cppsort::metrics::detail;
+
+    // Every duration goes into a bucket whose upper bound is not
+    // smaller, and the upper bound of the previous bucket is smaller
+    for (std::uint64_t value: { 0, 1, 15, 16, 17, 31, 32, 33, 1'000, 123'456, 987'654'321 }) {
+        auto bucket = latency_bucket(value);
+        CHECK( latency_bucket_max(bucket) >= value );
+        CHECK( latency_bucket_max(bucket) - value <= value / 16 );
+        if (bucket > 0) {
+            CHECK( latency_bucket_max(bucket - 1) < value );
+        }
+    }
+    CHECK( latency_bucket(std::uint64_t(1) << 50) == latency_buckets - 1 );
+    CHECK( latency_bucket((std::uint64_t(1) << 41) - 1) == latency_buckets - 1 );
+
+    // Only the last sub-bucket of 2^40 is the last bucket
+    std::uint64_t last_bucket_min = (std::uint64_t(1) << 40) + 15 * (std::uint64_t(1) << 36);
+    CHECK( latency_bucket(last_bucket_min) == latency_buckets - 1 );
+    CHECK( latency_bucket(last_bucket_min - 1) == latency_buckets - 2 );
+    CHECK( latency_bucket(std::uint64_t(1) << 40) < latency_buckets - 1 );
+}
+
+TEST_CASE( "metrics::latency_histogram percentiles", "[metrics]" )
+{
+    using namespace std::chrono_literals;
+    using cppsort::metrics::latency_histogram_snapshot;
+
+    // 99 fast calls and a slow one
+    cppsort::metrics::detail::latency_counters counters;
+    for (int i = 0 ; i < 99 ; ++i) {
+        counters.record(1, 10);
+    }
+    counters.record(1, 1'000);
+    latency_histogram_snapshot snapshot(counters);
+
+    // The p-quantile is the value of rank ceil(p * 100)
+    CHECK( snapshot.percentile(0.5) == 10ns );
+    CHECK( snapshot.percentile(0.99) == 10ns );
+    CHECK( snapshot.percentile(0.991) >= 1'000ns );
+    CHECK( snapshot.percentile(1.0) >= 1'000ns );
+}
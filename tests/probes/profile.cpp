@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/probes.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+namespace
+{
+    template<typename Collection, typename Result>
+    auto check_profile(const Collection& collection, const Result& res)
+        -> void
+    {
+        using namespace cppsort;
+        CHECK( res.block == probe::block(collection) );
+        CHECK( res.dis == probe::dis(collection) );
+        CHECK( res.enc == probe::enc(collection) );
+        CHECK( res.exc == probe::exc(collection) );
+        CHECK( res.ham == probe::ham(collection) );
+        CHECK( res.inv == probe::inv(collection) );
+        CHECK( res.max == probe::max(collection) );
+        CHECK( res.mono == probe::mono(collection) );
+        CHECK( res.osc == probe::osc(collection) );
+        CHECK( res.rem == probe::rem(collection) );
+        CHECK( res.runs == probe::runs(collection) );
+        CHECK( res.sus == probe::sus(collection) );
+    }
+}
+
+TEMPLATE_TEST_CASE( "presortedness profile", "[probe][profile]",
+                    std::vector<int>, std::list<int>, std::forward_list<int> )
+{
+    std::vector<int> values;
+
+    SECTION( "simple test" )
+    {
+        values = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+    }
+
+    SECTION( "shuffled with duplicates" )
+    {
+        dist::shuffled_16_values{}(std::back_inserter(values), 1000);
+    }
+
+    SECTION( "ascending sawtooth" )
+    {
+        dist::ascending_sawtooth{}(std::back_inserter(values), 1000);
+    }
+
+    SECTION( "alternating" )
+    {
+        dist::alternating{}(std::back_inserter(values), 1000);
+    }
+
+    SECTION( "pipe organ" )
+    {
+        dist::pipe_organ{}(std::back_inserter(values), 1000);
+    }
+
+    const TestType collection(values.begin(), values.end());
+    check_profile(collection, cppsort::probe::profile{}(collection));
+    check_profile(collection, cppsort::probe::profile{}(collection.begin(), collection.end()));
+}
+
+TEST_CASE( "presortedness profile with a subset of measures", "[probe][profile]" )
+{
+    using cppsort::probe::measures;
+
+    std::vector<int> vec;
+    dist::shuffled{}(std::back_inserter(vec), 1000);
+
+    auto probe = cppsort::probe::profile(measures::inv | measures::max | measures::runs);
+    auto res = probe(vec);
+    CHECK( res.inv == cppsort::probe::inv(vec) );
+    CHECK( res.max == cppsort::probe::max(vec) );
+    CHECK( res.runs == cppsort::probe::runs(vec) );
+    CHECK( res.block == 0 );
+    CHECK( res.dis == 0 );
+    CHECK( res.mono == 0 );
+    CHECK( res.osc == 0 );
+    CHECK( res.rem == 0 );
+
+    SECTION( "custom comparison and projection" )
+    {
+        std::vector<internal_compare<int>> tricky(vec.begin(), vec.end());
+        auto res_tricky = probe(tricky, &internal_compare<int>::compare_to);
+        CHECK( res_tricky.inv == res.inv );
+        CHECK( res_tricky.max == res.max );
+        CHECK( res_tricky.runs == res.runs );
+
+        auto res_greater = cppsort::probe::profile{}(vec, std::greater<>{});
+        CHECK( res_greater.inv == cppsort::probe::inv(vec, std::greater<>{}) );
+        CHECK( res_greater.mono == cppsort::probe::mono(vec, std::greater<>{}) );
+        CHECK( res_greater.dis == cppsort::probe::dis(vec, std::greater<>{}) );
+    }
+}
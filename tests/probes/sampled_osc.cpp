@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <forward_list>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/probes/osc.h>
+#include <cpp-sort/probes/sampled_osc.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/internal_compare.h>
+
+TEST_CASE( "approximate presortedness measure: sampled_osc", "[probe][sampled_osc]" )
+{
+    using cppsort::probe::osc;
+    using cppsort::probe::sampled_osc;
+
+    SECTION( "exact result when the whole collection is sampled" )
+    {
+        const std::forward_list<int> li = { 48, 43, 96, 44, 42, 34, 42, 57, 68, 69 };
+        auto res = sampled_osc{}(li);
+        CHECK( res.value == osc(li) );
+        CHECK( res.lower == res.value );
+        CHECK( res.upper == res.value );
+
+        std::vector<internal_compare<int>> tricky(li.begin(), li.end());
+        auto res_tricky = sampled_osc{}(tricky, &internal_compare<int>::compare_to);
+        CHECK( res_tricky.value == res.value );
+    }
+
+    SECTION( "bounds of the estimate" )
+    {
+        std::vector<int> vec;
+        dist::shuffled_16_values{}(std::back_inserter(vec), 50'000);
+        auto exact = osc(vec);
+
+        auto res = sampled_osc(2'000)(vec);
+        CHECK( res.lower <= res.value );
+        CHECK( res.value <= res.upper );
+        CHECK( res.lower <= exact );
+        CHECK( exact <= res.upper );
+        CHECK( res.upper <= sampled_osc::max_for_size(vec.end() - vec.begin()) );
+
+        auto res_it = sampled_osc(2'000)(vec.begin(), vec.end());
+        CHECK( res_it.value == res.value );
+        CHECK( res_it.lower == res.lower );
+        CHECK( res_it.upper == res.upper );
+    }
+
+    SECTION( "tighter bounds with bigger samples" )
+    {
+        std::vector<int> vec;
+        dist::shuffled{}(std::back_inserter(vec), 50'000);
+
+        auto small = sampled_osc(500)(vec);
+        auto big = sampled_osc(sampled_osc::sample_size_for(0.01))(vec);
+        CHECK( big.upper - big.lower < small.upper - small.lower );
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/metrics/comparisons.h>
+#include <cpp-sort/selectors/nth_element_selector.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "nth_element_selector tests", "[selectors][nth_element_selector]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'007, -500);
+    auto sorted = collection;
+    std::sort(sorted.begin(), sorted.end());
+
+    SECTION( "random-access iterators" )
+    {
+        for (int nth : { 0, 1, 42, 5'003, 10'006 }) {
+            auto copy = collection;
+            auto it = cppsort::nth_element_selector(nth)(copy);
+            REQUIRE( it == copy.begin() + nth );
+            CHECK( *it == sorted[nth] );
+            CHECK( std::all_of(copy.begin(), it, [&](int value) { return value <= *it; }) );
+            CHECK( std::all_of(it, copy.end(), [&](int value) { return value >= *it; }) );
+        }
+    }
+
+    SECTION( "forward iterators with compare and projection" )
+    {
+        std::list<generic_wrapper<int>> li(collection.begin(), collection.end());
+        auto it = cppsort::nth_element_selector(100)(li, std::greater<>{}, &generic_wrapper<int>::value);
+        CHECK( it->value == sorted[sorted.size() - 101] );
+    }
+
+    SECTION( "out of range positions" )
+    {
+        auto copy = collection;
+        CHECK( cppsort::nth_element_selector(10'007)(copy) == copy.end() );
+        CHECK( cppsort::nth_element_selector(-1)(copy) == copy.end() );
+        CHECK( copy == collection );
+    }
+
+    SECTION( "with metrics::comparisons" )
+    {
+        // Selection should take way fewer comparisons than sorting
+        auto copy = collection;
+        auto selector = cppsort::metrics::comparisons<cppsort::nth_element_selector>(
+            cppsort::nth_element_selector(5'003)
+        );
+        auto count = selector(copy);
+        CHECK( count.value() < 10 * collection.size() );
+        CHECK( copy[5'003] == sorted[5'003] );
+    }
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/adapters/counting_adapter.h>
+#include <cpp-sort/selectors/partial_sort_selector.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "partial_sort_selector tests", "[selectors][partial_sort_selector]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 100'003, -500);
+    auto sorted = collection;
+    std::sort(sorted.begin(), sorted.end());
+
+    SECTION( "small and big k" )
+    {
+        // Small values of k use heap select, bigger ones use quickselect
+        for (int k : { 0, 1, 100, 1'562, 1'563, 50'000, 100'002, 100'003, 200'000 }) {
+            auto copy = collection;
+            auto middle = cppsort::partial_sort_selector(k)(copy);
+            auto len = std::min(k, 100'003);
+            REQUIRE( middle == copy.begin() + len );
+            CHECK( std::equal(copy.begin(), middle, sorted.begin()) );
+            CHECK( std::is_permutation(copy.begin(), copy.end(), collection.begin()) );
+        }
+    }
+
+    SECTION( "compare and projection" )
+    {
+        std::deque<generic_wrapper<int>> collection2(collection.begin(), collection.end());
+        cppsort::partial_sort_selector(100)(collection2, std::greater<>{}, &generic_wrapper<int>::value);
+        CHECK( std::equal(collection2.begin(), collection2.begin() + 100, sorted.rbegin(),
+                          [](const auto& lhs, int rhs) { return lhs.value == rhs; }) );
+    }
+
+    SECTION( "with counting_adapter" )
+    {
+        // Top 100 of a big collection with about one comparison
+        // per element instead of n log n comparisons
+        auto copy = collection;
+        cppsort::counting_adapter<cppsort::partial_sort_selector> selector(
+            cppsort::partial_sort_selector(100)
+        );
+        auto count = selector(copy);
+        CHECK( count < 2 * collection.size() );
+        CHECK( std::equal(copy.begin(), copy.begin() + 100, sorted.begin()) );
+    }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <forward_list>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/selectors/partial_sort_copy.h>
+#include <cpp-sort/selectors/top_k_selector.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "top_k_selector tests", "[selectors][top_k_selector]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'007, -500);
+    const auto original = collection;
+    auto sorted = collection;
+    std::sort(sorted.begin(), sorted.end());
+
+    SECTION( "collection left untouched" )
+    {
+        for (std::size_t k : { 0, 1, 100, 10'007, 20'000 }) {
+            auto res = cppsort::top_k_selector(k)(collection);
+            REQUIRE( res.size() == std::min<std::size_t>(k, 10'007) );
+            CHECK( std::equal(res.begin(), res.end(), sorted.begin()) );
+            CHECK( collection == original );
+        }
+    }
+
+    SECTION( "forward iterators with compare and projection" )
+    {
+        std::forward_list<generic_wrapper<int>> li(collection.begin(), collection.end());
+        auto res = cppsort::top_k_selector(50)(li, std::greater<>{}, &generic_wrapper<int>::value);
+        REQUIRE( res.size() == 50 );
+        CHECK( std::equal(res.begin(), res.end(), sorted.rbegin(),
+                          [](const auto& lhs, int rhs) { return lhs.value == rhs; }) );
+    }
+}
+
+TEST_CASE( "partial_sort_copy tests", "[selectors][partial_sort_copy]" )
+{
+    std::vector<int> collection;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(collection), 10'007, -500);
+    auto sorted = collection;
+    std::sort(sorted.begin(), sorted.end());
+
+    SECTION( "iterators" )
+    {
+        std::vector<int> res(64);
+        auto it = cppsort::partial_sort_copy(collection.begin(), collection.end(),
+                                             res.begin(), res.end());
+        CHECK( it == res.end() );
+        CHECK( std::equal(res.begin(), res.end(), sorted.begin()) );
+    }
+
+    SECTION( "iterables with compare" )
+    {
+        std::vector<int> res(64);
+        auto it = cppsort::partial_sort_copy(collection, res, std::greater<>{});
+        CHECK( it == res.end() );
+        CHECK( std::equal(res.begin(), res.end(), sorted.rbegin()) );
+    }
+
+    SECTION( "output bigger than the input" )
+    {
+        std::vector<int> input = { 5, 3, 8, 1 };
+        std::vector<int> res(10, 0);
+        auto it = cppsort::partial_sort_copy(input, res);
+        CHECK( it == res.begin() + 4 );
+        CHECK( std::is_sorted(res.begin(), it) );
+        CHECK( res[0] == 1 );
+        CHECK( res[3] == 8 );
+    }
+}
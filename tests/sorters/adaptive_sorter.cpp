@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/adaptive_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "adaptive_sorter with different kinds of disorder", "[adaptive_sorter]" )
+{
+    std::vector<int> vec;
+    vec.reserve(10'000);
+
+    SECTION( "sorted collection" )
+    {
+        dist::ascending{}(std::back_inserter(vec), 10'000);
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "collection sorted in reverse order" )
+    {
+        dist::descending{}(std::back_inserter(vec), 10'000);
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "almost sorted collection with outliers" )
+    {
+        dist::ascending{}(std::back_inserter(vec), 10'000);
+        for (int idx = 0 ; idx < 10'000 ; idx += 250) {
+            vec[idx] = 20'000 - idx;
+        }
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "collection made of a few runs" )
+    {
+        dist::ascending_sawtooth{}(std::back_inserter(vec), 10'000);
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "collection almost sorted in reverse order" )
+    {
+        dist::descending{}(std::back_inserter(vec), 10'000);
+        for (int idx = 0 ; idx < 10'000 ; idx += 500) {
+            vec[idx] = idx;
+        }
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "shuffled collection" )
+    {
+        dist::shuffled{}(std::back_inserter(vec), 10'000, -5'000);
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "shuffled collection with a custom comparison" )
+    {
+        dist::shuffled{}(std::back_inserter(vec), 10'000);
+        cppsort::adaptive_sort(vec, std::greater<>{});
+        CHECK( std::is_sorted(vec.begin(), vec.end(), std::greater<>{}) );
+    }
+}
+
+TEST_CASE( "adaptive_sorter with other types", "[adaptive_sorter]" )
+{
+    SECTION( "double" )
+    {
+        std::vector<double> vec;
+        dist::shuffled{}(std::back_inserter(vec), 10'000, -5'000);
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "std::string" )
+    {
+        std::vector<std::string> vec;
+        auto distribution = dist::shuffled{};
+        std::vector<int> ints;
+        distribution(std::back_inserter(ints), 5'000);
+        for (int value: ints) {
+            vec.push_back(std::to_string(value));
+        }
+        cppsort::adaptive_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "projection" )
+    {
+        std::vector<generic_wrapper<int>> vec(10'000);
+        helpers::iota(vec.begin(), vec.end(), 0, &generic_wrapper<int>::value);
+        std::reverse(vec.begin(), vec.end());
+        cppsort::adaptive_sort(vec, &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(), std::less<>{}, &generic_wrapper<int>::value) );
+    }
+}
+
+TEST_CASE( "adaptive_sorter with custom thresholds", "[adaptive_sorter]" )
+{
+    cppsort::adaptive_sorter_thresholds thresholds;
+    thresholds.min_size = 16;
+    thresholds.presorted_ratio = 0.2;
+    thresholds.radix_min_size = 64;
+    auto sorter = cppsort::adaptive_sorter(thresholds);
+
+    std::vector<int> vec;
+    dist::ascending_sawtooth{}(std::back_inserter(vec), 1'000);
+    sorter(vec);
+    CHECK( std::is_sorted(vec.begin(), vec.end()) );
+
+    vec.clear();
+    dist::shuffled{}(std::back_inserter(vec), 1'000);
+    sorter(vec);
+    CHECK( std::is_sorted(vec.begin(), vec.end()) );
+}
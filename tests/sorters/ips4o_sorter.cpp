@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/ips4o_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+namespace
+{
+    struct record
+    {
+        int key;
+        std::string name;
+    };
+
+    struct record_compare
+    {
+        auto operator()(const record& lhs, const record& rhs) const
+            -> bool
+        {
+            return std::tie(lhs.key, lhs.name) < std::tie(rhs.key, rhs.name);
+        }
+    };
+}
+
+TEST_CASE( "ips4o_sorter tests", "[ips4o_sorter]" )
+{
+    // The generic sorter tests use collections that are too small
+    // for ips4o_sorter to distribute them, so we use collections
+    // big enough to need several distribution levels, and sizes
+    // that are not multiples of the block size
+
+    const int size = 300'007;
+    cppsort::ips4o_sorter sequential_sorter;
+    cppsort::ips4o_sorter parallel_sorter(4);
+
+    SECTION( "shuffled distribution" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -50'000);
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end());
+
+        auto copy = collection;
+        sequential_sorter(collection);
+        CHECK( collection == expected );
+        parallel_sorter(copy);
+        CHECK( copy == expected );
+    }
+
+    SECTION( "small sizes" )
+    {
+        // Sizes around the smallest collections that get distributed
+        for (int small_size : { 2'047, 2'048, 2'049, 2'051, 4'099, 9'001 }) {
+            std::vector<int> collection; collection.reserve(small_size);
+            auto distribution = dist::shuffled{};
+            distribution(std::back_inserter(collection), small_size, 0);
+
+            sequential_sorter(collection);
+            CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        }
+    }
+
+    SECTION( "shuffled distribution with std::deque and compare" )
+    {
+        std::deque<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -50'000);
+
+        parallel_sorter(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "few distinct values" )
+    {
+        // Equality buckets are needed to handle those efficiently
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), size);
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end());
+
+        parallel_sorter(collection);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "all equal and ascending sawtooth" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::all_equal{};
+        distribution(std::back_inserter(collection), size);
+        sequential_sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+
+        collection.clear();
+        auto distribution2 = dist::ascending_sawtooth{};
+        distribution2(std::back_inserter(collection), size);
+        sequential_sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "pipe organ with projection" )
+    {
+        std::vector<generic_wrapper<int>> collection; collection.reserve(size);
+        auto distribution = dist::pipe_organ{};
+        distribution(std::back_inserter(collection), size);
+
+        parallel_sorter(collection, &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::less<>{}, &generic_wrapper<int>::value) );
+    }
+
+    SECTION( "structs with a custom comparator" )
+    {
+        std::vector<int> keys; keys.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(keys), size, 0);
+
+        std::vector<record> collection; collection.reserve(size);
+        for (int key : keys) {
+            collection.push_back({ key % 1'000, std::to_string(key) });
+        }
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end(), record_compare{});
+
+        parallel_sorter(collection, record_compare{});
+        CHECK( std::equal(collection.begin(), collection.end(), expected.begin(),
+                          [](const record& lhs, const record& rhs) {
+                              return lhs.key == rhs.key && lhs.name == rhs.name;
+                          }) );
+    }
+
+    SECTION( "move-only types" )
+    {
+        std::vector<int> values; values.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(values), size, 0);
+
+        std::vector<std::unique_ptr<int>> collection; collection.reserve(size);
+        for (int value : values) {
+            collection.push_back(std::make_unique<int>(value));
+        }
+
+        sequential_sorter(collection, [](const std::unique_ptr<int>& ptr) { return *ptr; });
+        CHECK( std::is_sorted(collection.begin(), collection.end(),
+                              [](const auto& lhs, const auto& rhs) { return *lhs < *rhs; }) );
+    }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/lsd_radix_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int index;
+        std::string payload;
+    };
+}
+
+TEST_CASE( "lsd_radix_sorter tests", "[lsd_radix_sorter]" )
+{
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        vec.reserve(100'000);
+        distribution(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with unsigned long long iterators" )
+    {
+        std::vector<unsigned long long> vec;
+        vec.reserve(100'000);
+        distribution(std::back_inserter(vec), 100'000);
+        cppsort::lsd_radix_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with std::deque" )
+    {
+        std::deque<short> collection;
+        distribution(std::back_inserter(collection), 50'000, -25'000);
+        cppsort::lsd_radix_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION( "sort with int128 iterable" )
+    {
+        std::vector<__int128_t> vec;
+        vec.reserve(100'000);
+        distribution(std::back_inserter(vec), 100'000, -10'000);
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+#endif
+
+    SECTION( "sort with float iterable" )
+    {
+        std::vector<float> vec;
+        vec.reserve(100'000);
+        distribution.call<float>(std::back_inserter(vec), 100'000, -50'000);
+        vec.push_back(std::numeric_limits<float>::infinity());
+        vec.push_back(-std::numeric_limits<float>::infinity());
+        cppsort::lsd_radix_sort(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with double iterators" )
+    {
+        std::vector<double> vec;
+        vec.reserve(100'000);
+        distribution.call<double>(std::back_inserter(vec), 100'000, -50'000);
+        cppsort::lsd_radix_sort(vec.begin(), vec.end());
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
+
+    SECTION( "sort with pairs and tuples" )
+    {
+        std::vector<std::pair<int, unsigned char>> pairs;
+        std::vector<std::tuple<bool, long long, int>> tuples;
+        for (int i = 0 ; i < 10'000 ; ++i) {
+            pairs.emplace_back(i % 100 - 50, static_cast<unsigned char>(i % 7));
+            tuples.emplace_back(i % 3 == 0, -(i % 11), i);
+        }
+        std::shuffle(pairs.begin(), pairs.end(), hasard::engine());
+        std::shuffle(tuples.begin(), tuples.end(), hasard::engine());
+
+        cppsort::lsd_radix_sort(pairs);
+        CHECK( std::is_sorted(pairs.begin(), pairs.end()) );
+        cppsort::lsd_radix_sort(tuples);
+        CHECK( std::is_sorted(tuples.begin(), tuples.end()) );
+    }
+
+    SECTION( "stability with projection" )
+    {
+        std::vector<record> vec;
+        vec.reserve(50'000);
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec.push_back({ i % 1'000 - 500, i, std::to_string(i) });
+        }
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        for (int i = 0 ; i < 50'000 ; ++i) {
+            vec[i].index = i;
+        }
+
+        auto expected = vec;
+        std::stable_sort(expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key < rhs.key;
+        });
+        cppsort::lsd_radix_sort(vec, &record::key);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(), std::less<>{}, &record::key) );
+        CHECK( std::equal(vec.begin(), vec.end(), expected.begin(), [](const auto& lhs, const auto& rhs) {
+            return lhs.index == rhs.index && lhs.payload == rhs.payload;
+        }) );
+    }
+}
+
+TEST_CASE( "is_lsd_radix_sortable", "[lsd_radix_sorter]" )
+{
+    STATIC_CHECK( cppsort::detail::is_lsd_radix_sortable_v<int> );
+    STATIC_CHECK( cppsort::detail::is_lsd_radix_sortable_v<const unsigned long&> );
+    STATIC_CHECK( cppsort::detail::is_lsd_radix_sortable_v<double> );
+    STATIC_CHECK( cppsort::detail::is_lsd_radix_sortable_v<int*> );
+    STATIC_CHECK( cppsort::detail::is_lsd_radix_sortable_v<std::pair<int, float>> );
+    STATIC_CHECK( cppsort::detail::is_lsd_radix_sortable_v<std::tuple<bool, char, long long>> );
+    STATIC_CHECK_FALSE( cppsort::detail::is_lsd_radix_sortable_v<long double> );
+    STATIC_CHECK_FALSE( cppsort::detail::is_lsd_radix_sortable_v<std::string> );
+    STATIC_CHECK_FALSE( cppsort::detail::is_lsd_radix_sortable_v<std::pair<int, std::string>> );
+    STATIC_CHECK_FALSE( cppsort::detail::is_lsd_radix_sortable_v<std::tuple<>> );
+}
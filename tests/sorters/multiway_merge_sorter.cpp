@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/multiway_merge_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int index;
+    };
+}
+
+TEST_CASE( "multiway_merge_sorter tests", "[multiway_merge_sorter]" )
+{
+    // Sizes big enough to need several merge passes, and sizes
+    // that don't fill the last groups of runs
+    auto sizes = { 33, 512, 513, 16'385, 100'003 };
+
+    SECTION( "shuffled distribution" )
+    {
+        for (int size : sizes) {
+            std::vector<int> collection; collection.reserve(size);
+            auto distribution = dist::shuffled{};
+            distribution(std::back_inserter(collection), size, -50'000);
+            auto expected = collection;
+            std::sort(expected.begin(), expected.end());
+
+            cppsort::multiway_merge_sort(collection);
+            CHECK( collection == expected );
+        }
+    }
+
+    SECTION( "std::deque of strings" )
+    {
+        std::vector<int> values;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(values), 20'000);
+        std::deque<std::string> collection;
+        for (int value : values) {
+            collection.push_back(std::to_string(value));
+        }
+
+        cppsort::multiway_merge_sort(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "stability" )
+    {
+        const int size = 100'003;
+        std::vector<record> collection; collection.reserve(size);
+        std::vector<int> keys; keys.reserve(size);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(keys), size);
+        for (int idx = 0 ; idx < size ; ++idx) {
+            collection.push_back({ keys[idx], idx });
+        }
+
+        cppsort::multiway_merge_sort(collection, &record::key);
+        CHECK( std::is_sorted(collection.begin(), collection.end(),
+                              [](const record& lhs, const record& rhs) {
+                                  if (lhs.key < rhs.key) return true;
+                                  if (rhs.key < lhs.key) return false;
+                                  return lhs.index < rhs.index;
+                              }) );
+    }
+}
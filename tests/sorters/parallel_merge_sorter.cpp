@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_merge_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int index;
+        std::string payload;
+    };
+}
+
+TEST_CASE( "parallel_merge_sorter tests", "[parallel_merge_sorter]" )
+{
+    // Collections need to be big enough for the parallel
+    // code paths to be taken, several threads are explicitly
+    // requested to make sure that it happens even on machines
+    // with a single hardware thread
+
+    const int size = 200'000;
+
+    SECTION( "shuffled distribution" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -50'000);
+
+        cppsort::parallel_merge_sorter sorter(4);
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "odd number of runs with std::deque and compare" )
+    {
+        std::deque<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -50'000);
+
+        cppsort::parallel_merge_sorter sorter(5);
+        sorter(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "stability with projection" )
+    {
+        std::vector<record> collection;
+        collection.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            collection.push_back({ i % 100, 0, std::to_string(i) });
+        }
+        std::shuffle(collection.begin(), collection.end(), hasard::engine());
+        for (int i = 0 ; i < size ; ++i) {
+            collection[i].index = i;
+        }
+
+        cppsort::parallel_merge_sorter sorter(3);
+        sorter(collection, &record::key);
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::less<>{}, &record::key) );
+        CHECK( std::is_sorted(collection.begin(), collection.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.key < rhs.key || (lhs.key == rhs.key && lhs.index < rhs.index);
+        }) );
+        // The payloads must have followed their keys
+        CHECK( std::all_of(collection.begin(), collection.end(), [](const auto& rec) {
+            return not rec.payload.empty() && std::stoi(rec.payload) % 100 == rec.key;
+        }) );
+    }
+
+    SECTION( "non-trivial elements" )
+    {
+        std::vector<std::string> collection;
+        collection.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            collection.push_back(std::to_string(i) + std::string(20, 'x'));
+        }
+        std::shuffle(collection.begin(), collection.end(), hasard::engine());
+        auto copy = collection;
+
+        cppsort::parallel_merge_sorter sorter(4);
+        sorter(collection);
+        std::sort(copy.begin(), copy.end());
+        CHECK( collection == copy );
+    }
+
+    SECTION( "already sorted runs" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::ascending_sawtooth{};
+        distribution(std::back_inserter(collection), size);
+
+        cppsort::parallel_merge_sorter sorter(8);
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+}
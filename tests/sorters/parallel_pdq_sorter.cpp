@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+namespace
+{
+    struct comparison_error:
+        std::runtime_error
+    {
+        using std::runtime_error::runtime_error;
+    };
+}
+
+TEST_CASE( "parallel_pdq_sorter tests", "[parallel_pdq_sorter]" )
+{
+    // The generic sorter tests use collections that are too small
+    // for parallel_pdq_sorter to spawn threads, so we use bigger
+    // collections and explicitly ask for several threads to make
+    // sure that the parallel code paths are taken even on machines
+    // that only have a single hardware thread
+
+    const int size = 200'000;
+    cppsort::parallel_pdq_sorter sorter(4);
+
+    SECTION( "shuffled distribution" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -50'000);
+
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "shuffled distribution with std::deque and compare" )
+    {
+        std::deque<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, -50'000);
+
+        sorter(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "few distinct values" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(collection), size);
+
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "median-of-3 killer" )
+    {
+        // Tasks must keep pdqsort's guarantees against patterns
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::median_of_3_killer{};
+        distribution(std::back_inserter(collection), size);
+
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "pipe organ with projection" )
+    {
+        std::vector<generic_wrapper<int>> collection; collection.reserve(size);
+        auto distribution = dist::pipe_organ{};
+        distribution(std::back_inserter(collection), size);
+
+        sorter(collection, &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(collection.begin(), collection.end(),
+                                  std::less<>{}, &generic_wrapper<int>::value) );
+    }
+
+    SECTION( "exception thrown by a task" )
+    {
+        std::vector<int> collection; collection.reserve(size);
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), size, 0);
+
+        // Only throw deep in the recursion, once several tasks exist
+        auto throwing_compare = [](int lhs, int rhs) {
+            if (lhs == 125'000 && rhs == 125'001) {
+                throw comparison_error("comparison failed");
+            }
+            return lhs < rhs;
+        };
+        auto copy = collection;
+        bool has_thrown = false;
+        try {
+            sorter(collection, throwing_compare);
+        } catch (const comparison_error&) {
+            has_thrown = true;
+        }
+        if (not has_thrown) {
+            // The specific comparison might not happen
+            CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        }
+
+        // No element should have been lost
+        std::sort(collection.begin(), collection.end());
+        std::sort(copy.begin(), copy.end());
+        CHECK( collection == copy );
+    }
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/parallel_ska_sorter.h>
+#include <testing-tools/algorithm.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+#include <testing-tools/wrapper.h>
+
+namespace
+{
+    // Elements that can't be moved to the scratch buffer,
+    // forcing the in-place distribution
+    struct throwing_move_wrapper
+    {
+        int value = 0;
+
+        throwing_move_wrapper() = default;
+        throwing_move_wrapper(int value): value(value) {}
+        throwing_move_wrapper(const throwing_move_wrapper&) = default;
+        throwing_move_wrapper(throwing_move_wrapper&& other) noexcept(false):
+            value(other.value)
+        {}
+        throwing_move_wrapper& operator=(const throwing_move_wrapper&) = default;
+        throwing_move_wrapper& operator=(throwing_move_wrapper&& other) noexcept(false)
+        {
+            value = other.value;
+            return *this;
+        }
+    };
+}
+
+TEST_CASE( "parallel_ska_sorter tests", "[parallel_ska_sorter]" )
+{
+    // Collections need to be big enough for the parallel
+    // code paths to be taken, several threads are explicitly
+    // requested to make sure that it happens even on machines
+    // with a single hardware thread
+
+    const int size = 300'000;
+    cppsort::parallel_ska_sorter sorter(4);
+    auto distribution = dist::shuffled{};
+
+    SECTION( "sort with int iterable" )
+    {
+        std::vector<int> vec;
+        vec.reserve(size);
+        distribution(std::back_inserter(vec), size, -100'000);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with unsigned long long iterators" )
+    {
+        std::vector<unsigned long long> vec;
+        vec.reserve(size);
+        distribution(std::back_inserter(vec), size);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec.begin(), vec.end());
+        CHECK( vec == expected );
+    }
+
+#ifdef __SIZEOF_INT128__
+    SECTION( "sort with int128 iterable" )
+    {
+        std::vector<__int128_t> vec;
+        vec.reserve(size);
+        distribution(std::back_inserter(vec), size, -10'000);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+#endif
+
+    SECTION( "sort with double iterable" )
+    {
+        std::vector<double> vec;
+        vec.reserve(size);
+        distribution.call<double>(std::back_inserter(vec), size, -50'000);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with few distinct values" )
+    {
+        std::vector<int> vec;
+        vec.reserve(size);
+        auto distribution_16 = dist::shuffled_16_values{};
+        distribution_16(std::back_inserter(vec), size);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with std::string" )
+    {
+        std::vector<std::string> vec;
+        vec.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            vec.push_back(std::to_string(i));
+        }
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with std::pair" )
+    {
+        std::vector<std::pair<int, std::string>> vec;
+        vec.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            vec.emplace_back(i % 1000, std::to_string(i));
+        }
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with std::tuple" )
+    {
+        std::vector<std::tuple<unsigned, int, long long>> vec;
+        vec.reserve(size);
+        for (int i = 0 ; i < size ; ++i) {
+            vec.emplace_back(i % 7, -(i % 1000), i);
+        }
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with pointers" )
+    {
+        std::vector<int> values(size);
+        std::vector<int*> vec;
+        vec.reserve(size);
+        for (auto& value: values) {
+            vec.push_back(&value);
+        }
+
+        std::shuffle(vec.begin(), vec.end(), hasard::engine());
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        sorter(vec);
+        CHECK( vec == expected );
+    }
+
+    SECTION( "sort with in-place distribution" )
+    {
+        std::vector<throwing_move_wrapper> vec;
+        vec.reserve(size);
+        distribution(std::back_inserter(vec), size, -100'000);
+        std::vector<int> expected;
+        for (const auto& elem: vec) {
+            expected.push_back(elem.value);
+        }
+        std::sort(expected.begin(), expected.end());
+        sorter(vec, &throwing_move_wrapper::value);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(),
+                                  std::less<>{}, &throwing_move_wrapper::value) );
+        CHECK( std::equal(vec.begin(), vec.end(), expected.begin(), expected.end(),
+                          [](const auto& elem, int value) { return elem.value == value; }) );
+    }
+
+    SECTION( "sort with projection" )
+    {
+        std::vector<generic_wrapper<int>> vec;
+        vec.reserve(size);
+        distribution(std::back_inserter(vec), size, -100'000);
+        std::vector<int> expected;
+        for (const auto& elem: vec) {
+            expected.push_back(elem.value);
+        }
+        std::sort(expected.begin(), expected.end());
+        sorter(vec, &generic_wrapper<int>::value);
+        CHECK( helpers::is_sorted(vec.begin(), vec.end(),
+                                  std::less<>{}, &generic_wrapper<int>::value) );
+        CHECK( std::equal(vec.begin(), vec.end(), expected.begin(), expected.end(),
+                          [](const auto& elem, int value) { return elem.value == value; }) );
+    }
+}
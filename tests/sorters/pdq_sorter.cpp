@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <testing-tools/distributions.h>
+
+TEMPLATE_TEST_CASE( "pdq_sorter with arithmetic types", "[pdq_sorter]",
+                    std::int32_t, std::uint32_t, std::int64_t, float, double )
+{
+    // Contiguous collections of those types might use a vectorized
+    // partitioning algorithm, which has different code paths depending
+    // on the size of the partitions and on the number of elements
+    // going on either side of the pivot
+
+    std::vector<TestType> collection;
+
+    SECTION( "shuffled with std::less" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 10'000, -5'000);
+        cppsort::pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "shuffled with std::greater" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 10'000, -5'000);
+        cppsort::pdq_sort(collection, std::greater<TestType>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "few unique values" )
+    {
+        auto distribution = dist::shuffled_16_values{};
+        distribution.call<TestType>(std::back_inserter(collection), 10'000);
+        cppsort::pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "patterns" )
+    {
+        auto distribution = dist::median_of_3_killer{};
+        distribution.call<TestType>(std::back_inserter(collection), 10'000);
+        cppsort::pdq_sort(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+    }
+
+    SECTION( "small sizes" )
+    {
+        auto distribution = dist::shuffled{};
+        for (int size = 24 ; size < 100 ; ++size) {
+            collection.clear();
+            distribution.call<TestType>(std::back_inserter(collection), size);
+            auto copy = collection;
+            cppsort::pdq_sort(collection);
+            CHECK( std::is_sorted(collection.begin(), collection.end()) );
+            CHECK( std::is_permutation(collection.begin(), collection.end(), copy.begin()) );
+        }
+    }
+
+    SECTION( "extreme values" )
+    {
+        auto distribution = dist::shuffled{};
+        distribution.call<TestType>(std::back_inserter(collection), 1'000);
+        for (int i = 0 ; i < 100 ; ++i) {
+            collection.push_back(std::numeric_limits<TestType>::lowest());
+            collection.push_back((std::numeric_limits<TestType>::max)());
+        }
+        std::deque<TestType> expected(collection.begin(), collection.end());
+        std::sort(expected.begin(), expected.end());
+        cppsort::pdq_sort(collection);
+        CHECK( std::equal(collection.begin(), collection.end(), expected.begin()) );
+    }
+}
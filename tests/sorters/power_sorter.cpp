@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/power_sorter.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/random.h>
+
+TEST_CASE( "power_sorter tests", "[power_sorter]" )
+{
+    // The generic sorter tests use collections that are too small
+    // to need more than a few merges, so we use bigger collections
+    // made of many runs to exercise the merge policy
+
+    SECTION( "runs of uneven lengths" )
+    {
+        // Concatenation of ascending and descending runs whose
+        // lengths span several orders of magnitude
+        std::uniform_int_distribution<int> log_size_dis(1, 14);
+        std::uniform_int_distribution<int> first_dis(0, 10'000);
+        std::vector<std::pair<int, int>> collection;
+        for (int run = 0 ; collection.size() < 200'000 ; ++run) {
+            std::uniform_int_distribution<int> size_dis(1, 1 << log_size_dis(hasard::engine()));
+            int run_size = size_dis(hasard::engine());
+            int first = first_dis(hasard::engine());
+            for (int idx = 0 ; idx < run_size ; ++idx) {
+                int key = run % 2 ? first + idx : first - idx;
+                collection.emplace_back(key, static_cast<int>(collection.size()));
+            }
+        }
+        auto expected = collection;
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        cppsort::power_sort(collection, &std::pair<int, int>::first);
+        CHECK( collection == expected );
+    }
+
+    SECTION( "shuffled distribution" )
+    {
+        std::vector<int> collection;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(collection), 100'003, -30'000);
+
+        cppsort::power_sort(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+    }
+
+    SECTION( "stability with few distinct values" )
+    {
+        std::vector<int> keys;
+        auto distribution = dist::shuffled_16_values{};
+        distribution(std::back_inserter(keys), 50'000);
+
+        std::vector<std::pair<int, int>> collection;
+        for (int idx = 0 ; idx < static_cast<int>(keys.size()) ; ++idx) {
+            collection.emplace_back(keys[idx], idx);
+        }
+        auto expected = collection;
+        std::sort(expected.begin(), expected.end());
+
+        cppsort::power_sort(collection, &std::pair<int, int>::first);
+        CHECK( collection == expected );
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+#include <catch2/catch_template_test_macros.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/fixed/sorting_network_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    template<typename T, typename Collection, typename Compare, std::size_t... Sizes>
+    auto check_all_sizes(Compare compare, std::index_sequence<Sizes...>)
+        -> void
+    {
+        // Check sizes around the number of elements that fit
+        // in one or several SIMD registers
+        auto distribution = dist::shuffled{};
+        auto check_size = [&](auto sorter, std::size_t size) {
+            Collection collection;
+            distribution.call<T>(std::back_inserter(collection), size, -20);
+            auto expected = collection;
+            std::sort(expected.begin(), expected.end(), compare);
+            sorter(collection, compare);
+            CHECK( collection == expected );
+        };
+        int dummy[] = { (check_size(cppsort::sorting_network_sorter<Sizes>{}, Sizes), 0)... };
+        (void) dummy;
+    }
+}
+
+TEMPLATE_TEST_CASE( "sorting_network_sorter with arithmetic types", "[sorting_network_sorter]",
+                    std::int32_t, std::uint32_t, std::int64_t, float, double )
+{
+    using sizes = std::index_sequence<6, 7, 8, 9, 12, 15, 16, 17, 23, 31, 32>;
+
+    SECTION( "std::less" )
+    {
+        check_all_sizes<TestType, std::vector<TestType>>(std::less<>{}, sizes{});
+    }
+
+    SECTION( "std::greater" )
+    {
+        check_all_sizes<TestType, std::vector<TestType>>(std::greater<TestType>{}, sizes{});
+    }
+
+    SECTION( "std::deque" )
+    {
+        check_all_sizes<TestType, std::deque<TestType>>(std::less<>{}, sizes{});
+    }
+}
+
+TEST_CASE( "sorting_network_sorter with extreme values", "[sorting_network_sorter]" )
+{
+    // The vectorized networks pad the collections with the
+    // biggest value of the type, which should not leak
+
+    SECTION( "integers" )
+    {
+        std::vector<std::uint32_t> vec = {
+            0, 5, std::numeric_limits<std::uint32_t>::max(), 8, 1,
+            std::numeric_limits<std::uint32_t>::max(), 3, 2, 0, 9, 7
+        };
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+        cppsort::sorting_network_sorter<11>{}(vec);
+        CHECK( vec == expected );
+
+        std::vector<std::int64_t> vec64 = {
+            std::numeric_limits<std::int64_t>::max(), -1, 5,
+            std::numeric_limits<std::int64_t>::min(), 3, 0, 8, 2, 1
+        };
+        auto expected64 = vec64;
+        std::sort(expected64.begin(), expected64.end(), std::greater<>{});
+        cppsort::sorting_network_sorter<9>{}(vec64, std::greater<>{});
+        CHECK( vec64 == expected64 );
+    }
+
+    SECTION( "floating point" )
+    {
+        const auto inf = std::numeric_limits<double>::infinity();
+        std::vector<double> vec = { 2.0, inf, -0.0, 1.0, -inf, 0.0, inf, -3.5, 0.5, -0.0 };
+        cppsort::sorting_network_sorter<10>{}(vec);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( vec.front() == -inf );
+        CHECK( vec.back() == inf );
+        CHECK( vec[8] == inf );
+
+        // The zeros are all kept, whatever their sign
+        auto zeros = std::count(vec.begin(), vec.end(), 0.0);
+        auto negative_zeros = std::count_if(vec.begin(), vec.end(), [](double value) {
+            return value == 0.0 && std::signbit(value);
+        });
+        CHECK( zeros == 3 );
+        CHECK( negative_zeros == 2 );
+    }
+
+    SECTION( "NaN" )
+    {
+        // NaN can't be sorted, but no element should be lost
+        const auto nan = std::numeric_limits<float>::quiet_NaN();
+        auto check_size = [&](auto sorter, std::size_t size) {
+            for (std::size_t nan_pos = 0 ; nan_pos < size ; nan_pos += 3) {
+                std::vector<float> vec;
+                for (std::size_t idx = 0 ; idx < size ; ++idx) {
+                    vec.push_back(static_cast<float>((idx * 7) % size));
+                }
+                vec[nan_pos] = nan;
+                vec[size - 1 - nan_pos / 2] = nan;
+                auto expected = vec;
+
+                sorter(vec);
+                auto nan_count = std::count_if(vec.begin(), vec.end(), [](float value) {
+                    return std::isnan(value);
+                });
+                CHECK( nan_count == std::count_if(expected.begin(), expected.end(), [](float value) {
+                    return std::isnan(value);
+                }) );
+                vec.erase(std::remove_if(vec.begin(), vec.end(), [](float value) {
+                    return std::isnan(value);
+                }), vec.end());
+                expected.erase(std::remove_if(expected.begin(), expected.end(), [](float value) {
+                    return std::isnan(value);
+                }), expected.end());
+                std::sort(vec.begin(), vec.end());
+                std::sort(expected.begin(), expected.end());
+                CHECK( vec == expected );
+            }
+        };
+        check_size(cppsort::sorting_network_sorter<8>{}, 8);
+        check_size(cppsort::sorting_network_sorter<13>{}, 13);
+        check_size(cppsort::sorting_network_sorter<20>{}, 20);
+        check_size(cppsort::sorting_network_sorter<31>{}, 31);
+        check_size(cppsort::sorting_network_sorter<32>{}, 32);
+    }
+}
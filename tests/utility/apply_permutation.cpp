@@ -3,8 +3,11 @@
  * SPDX-License-Identifier: MIT
  */
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iterator>
+#include <string>
+#include <tuple>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <cpp-sort/sorters/poplar_sorter.h>
@@ -60,4 +63,92 @@ TEST_CASE( "apply_permutation test", "[utility][apply_permutation]" )
         cppsort::utility::apply_permutation(vec, indices);
         CHECK( std::is_sorted(vec.begin(), vec.end()) );
     }
+
+    SECTION( "indices are left untouched" )
+    {
+        // Big enough to be permuted through a buffer
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000);
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::poplar_sorter>{};
+        std::vector<std::ptrdiff_t> indices = get_sorted_indices_for(vec);
+        auto copy = indices;
+        cppsort::utility::apply_permutation(vec, indices);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( indices == copy );
+    }
+
+    SECTION( "big elements" )
+    {
+        std::vector<std::array<long long int, 16>> vec;
+        for (int idx = 0 ; idx < 1'000 ; ++idx) {
+            vec.push_back({{ (idx * 7919) % 1'000 }});
+        }
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::poplar_sorter>{};
+        std::vector<std::ptrdiff_t> indices = get_sorted_indices_for(vec);
+        auto copy = indices;
+        cppsort::utility::apply_permutation(vec, indices);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( indices == copy );
+    }
+
+    SECTION( "several threads" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000);
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::poplar_sorter>{};
+        std::vector<std::ptrdiff_t> indices = get_sorted_indices_for(vec);
+        auto copy = indices;
+        cppsort::utility::apply_permutation(vec, indices, 4);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+        CHECK( indices == copy );
+    }
+
+    SECTION( "several collections" )
+    {
+        std::vector<int> keys;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(keys), 100'000);
+
+        // The strings and the big elements don't use the buffered
+        // strategy, the int keys do
+        std::vector<std::string> names;
+        std::vector<std::array<long long int, 16>> big;
+        for (int key: keys) {
+            names.push_back(std::to_string(key));
+            big.push_back({{ key }});
+        }
+
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::poplar_sorter>{};
+        std::vector<std::ptrdiff_t> indices = get_sorted_indices_for(keys);
+        cppsort::utility::apply_permutation(std::tie(keys, names, big), indices);
+
+        CHECK( std::is_sorted(keys.begin(), keys.end()) );
+        CHECK( std::equal(keys.begin(), keys.end(), names.begin(),
+                          [](int key, const std::string& name) { return std::to_string(key) == name; }) );
+        CHECK( std::equal(keys.begin(), keys.end(), big.begin(),
+                          [](int key, const std::array<long long int, 16>& elem) { return key == elem[0]; }) );
+    }
+
+    SECTION( "several collections and several threads" )
+    {
+        std::vector<int> keys;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(keys), 100'000);
+        std::vector<long long int> values(keys.begin(), keys.end());
+        std::vector<std::string> names;
+        for (int key: keys) {
+            names.push_back(std::to_string(key));
+        }
+
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::poplar_sorter>{};
+        std::vector<std::ptrdiff_t> indices = get_sorted_indices_for(keys);
+        cppsort::utility::apply_permutation(std::tie(keys, values, names), indices, 0);
+
+        CHECK( std::is_sorted(keys.begin(), keys.end()) );
+        CHECK( std::equal(keys.begin(), keys.end(), values.begin()) );
+        CHECK( std::equal(keys.begin(), keys.end(), names.begin(),
+                          [](int key, const std::string& name) { return std::to_string(key) == name; }) );
+    }
 }
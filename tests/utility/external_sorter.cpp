@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <system_error>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/ska_sorter.h>
+#include <cpp-sort/sorters/spin_sorter.h>
+#include <cpp-sort/utility/external_sorter.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    struct record
+    {
+        int key;
+        int id;
+        char payload[24];
+    };
+
+    struct file_closer
+    {
+        auto operator()(std::FILE* file) const
+            -> void
+        {
+            std::fclose(file);
+        }
+    };
+
+    using file_ptr = std::unique_ptr<std::FILE, file_closer>;
+
+    template<typename T>
+    auto write_file(const std::vector<T>& records)
+        -> file_ptr
+    {
+        file_ptr file(std::tmpfile());
+        REQUIRE( file != nullptr );
+        std::fwrite(records.data(), sizeof(T), records.size(), file.get());
+        std::rewind(file.get());
+        return file;
+    }
+
+    template<typename T>
+    auto read_file(std::FILE* file)
+        -> std::vector<T>
+    {
+        std::rewind(file);
+        std::vector<T> res;
+        T value;
+        while (std::fread(&value, sizeof(T), 1, file) == 1) {
+            res.push_back(value);
+        }
+        return res;
+    }
+}
+
+TEST_CASE( "external_sorter tests", "[utility][external_sorter]" )
+{
+    std::vector<int> keys;
+    auto distribution = dist::shuffled{};
+    distribution(std::back_inserter(keys), 100'003, -30'000);
+
+    SECTION( "everything fits in memory" )
+    {
+        auto input = write_file(keys);
+        file_ptr output(std::tmpfile());
+
+        cppsort::utility::external_sorter<int, cppsort::ska_sorter> sorter(1 << 20);
+        sorter(input.get(), output.get());
+
+        auto res = read_file<int>(output.get());
+        std::sort(keys.begin(), keys.end());
+        CHECK( res == keys );
+    }
+
+    SECTION( "several merge passes" )
+    {
+        // A tiny memory budget gives many runs and a small fan-in,
+        // which forces intermediate merge passes
+        auto input = write_file(keys);
+        file_ptr output(std::tmpfile());
+
+        cppsort::utility::external_sorter<int, cppsort::pdq_sorter> sorter(1024);
+        sorter(input.get(), output.get(), std::greater<>{});
+
+        auto res = read_file<int>(output.get());
+        std::sort(keys.begin(), keys.end(), std::greater<>{});
+        CHECK( res == keys );
+    }
+
+    SECTION( "stability and projection" )
+    {
+        // Runs are merged in order, so the sort is stable when the
+        // wrapped sorter is stable
+        std::vector<record> records;
+        for (int idx = 0 ; idx < static_cast<int>(keys.size()) ; ++idx) {
+            records.push_back({ keys[idx] % 16, idx, {} });
+        }
+        auto input = write_file(records);
+        file_ptr output(std::tmpfile());
+
+        cppsort::utility::external_sorter<record, cppsort::spin_sorter> sorter(4096 * sizeof(record));
+        CHECK( sorter.memory_budget() == 4096 * sizeof(record) );
+        sorter(input.get(), output.get(), std::less<>{}, &record::key);
+
+        auto res = read_file<record>(output.get());
+        std::stable_sort(records.begin(), records.end(), [](const record& lhs, const record& rhs) {
+            return lhs.key < rhs.key;
+        });
+        REQUIRE( res.size() == records.size() );
+        CHECK( std::equal(res.begin(), res.end(), records.begin(),
+                          [](const record& lhs, const record& rhs) {
+                              return lhs.key == rhs.key && lhs.id == rhs.id;
+                          }) );
+    }
+
+    SECTION( "empty input" )
+    {
+        auto input = write_file(std::vector<int>{});
+        file_ptr output(std::tmpfile());
+
+        cppsort::utility::external_sorter<int, cppsort::pdq_sorter> sorter(1024);
+        sorter(input.get(), output.get());
+        CHECK( read_file<int>(output.get()).empty() );
+    }
+
+    SECTION( "trailing partial record" )
+    {
+        // The input can't be a collection of records, the
+        // size of the output would be silently truncated
+        std::vector<long> records(keys.begin(), keys.end());
+        auto input = write_file(records);
+        std::fseek(input.get(), 0, SEEK_END);
+        std::fputc(42, input.get());
+        std::rewind(input.get());
+
+        cppsort::utility::external_sorter<long, cppsort::pdq_sorter> sorter(1 << 22);
+        file_ptr output(std::tmpfile());
+        CHECK_THROWS_AS( sorter(input.get(), output.get()), std::system_error );
+
+        std::rewind(input.get());
+        cppsort::utility::external_sorter<long, cppsort::pdq_sorter> small_sorter(1024);
+        file_ptr small_output(std::tmpfile());
+        CHECK_THROWS_AS( small_sorter(input.get(), small_output.get()), std::system_error );
+    }
+
+    SECTION( "same input and output paths" )
+    {
+        // The input must not be truncated
+        const char* path = "cpp-sort-external-sorter-test.bin";
+        {
+            file_ptr file(std::fopen(path, "wb"));
+            REQUIRE( file != nullptr );
+            std::fwrite(keys.data(), sizeof(int), keys.size(), file.get());
+        }
+
+        cppsort::utility::external_sorter<int, cppsort::pdq_sorter> sorter(1024);
+        CHECK_THROWS_AS( sorter(path, path), std::system_error );
+        {
+            file_ptr file(std::fopen(path, "rb"));
+            REQUIRE( file != nullptr );
+            CHECK( read_file<int>(file.get()) == keys );
+        }
+        std::remove(path);
+    }
+
+    SECTION( "missing input file" )
+    {
+        cppsort::utility::external_sorter<int, cppsort::pdq_sorter> sorter(1024);
+        CHECK_THROWS_AS( sorter("this/file/does/not/exist.bin", "neither/does/this/one.bin"),
+                         std::system_error );
+    }
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/utility/multiway_merge.h>
+#include <testing-tools/distributions.h>
+#include <testing-tools/wrapper.h>
+
+TEST_CASE( "multiway_merge test", "[utility][multiway_merge]" )
+{
+    SECTION( "simple case" )
+    {
+        std::vector<std::vector<int>> shards = {
+            { 0, 4, 8, 9 },
+            { 1, 2, 7 },
+            {},
+            { 3, 5, 6, 10, 11 }
+        };
+        std::vector<int> res;
+        cppsort::utility::multiway_merge(shards, std::back_inserter(res));
+        CHECK( res == std::vector<int>({ 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11 }) );
+    }
+
+    SECTION( "no range and empty ranges" )
+    {
+        std::vector<std::vector<int>> shards;
+        std::vector<int> res;
+        cppsort::utility::multiway_merge(shards, std::back_inserter(res));
+        CHECK( res.empty() );
+
+        shards.resize(5);
+        cppsort::utility::multiway_merge(shards, std::back_inserter(res));
+        CHECK( res.empty() );
+    }
+
+    SECTION( "many shards" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 10'000);
+
+        // Split the collection into shards of different sizes
+        std::vector<std::vector<int>> shards(37);
+        for (std::size_t idx = 0 ; idx < vec.size() ; ++idx) {
+            shards[(idx * idx) % shards.size()].push_back(vec[idx]);
+        }
+        for (auto& shard: shards) {
+            std::sort(shard.begin(), shard.end(), std::greater<>{});
+        }
+
+        std::vector<int> res(vec.size());
+        auto it = cppsort::utility::multiway_merge(shards, res.begin(), std::greater<>{});
+        CHECK( it == res.end() );
+        std::sort(vec.begin(), vec.end(), std::greater<>{});
+        CHECK( res == vec );
+    }
+
+    SECTION( "pairs of iterators and projection" )
+    {
+        std::list<generic_wrapper<int>> li1 = { {1}, {3}, {5} };
+        std::list<generic_wrapper<int>> li2 = { {0}, {2}, {4}, {6} };
+        using iterator = std::list<generic_wrapper<int>>::iterator;
+        std::vector<std::pair<iterator, iterator>> ranges = {
+            { li1.begin(), li1.end() },
+            { li2.begin(), li2.end() }
+        };
+
+        std::vector<generic_wrapper<int>> res;
+        cppsort::utility::multiway_merge(ranges, std::back_inserter(res),
+                                         std::less<>{}, &generic_wrapper<int>::value);
+        CHECK( std::is_sorted(res.begin(), res.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.value < rhs.value;
+        }) );
+        CHECK( res.size() == 7 );
+    }
+
+    SECTION( "stability" )
+    {
+        // Equivalent elements are taken from the first ranges first
+        using value_type = std::pair<int, int>;
+        std::vector<std::vector<value_type>> shards = {
+            { {0, 0}, {1, 0}, {1, 1}, {3, 0} },
+            { {1, 2}, {2, 0}, {3, 1} },
+            { {0, 1}, {1, 3}, {3, 2} }
+        };
+        std::vector<value_type> res;
+        cppsort::utility::multiway_merge(shards, std::back_inserter(res),
+                                         std::less<>{}, &value_type::first);
+        CHECK( std::is_sorted(res.begin(), res.end()) );
+    }
+
+    SECTION( "move iterators" )
+    {
+        std::vector<std::string> vec1 = { "a", "c", "e" };
+        std::vector<std::string> vec2 = { "b", "d" };
+        using iterator = std::move_iterator<std::vector<std::string>::iterator>;
+        std::vector<std::pair<iterator, iterator>> ranges = {
+            { std::make_move_iterator(vec1.begin()), std::make_move_iterator(vec1.end()) },
+            { std::make_move_iterator(vec2.begin()), std::make_move_iterator(vec2.end()) }
+        };
+
+        std::vector<std::string> res;
+        cppsort::utility::multiway_merge(ranges, std::back_inserter(res));
+        CHECK( res == std::vector<std::string>({ "a", "b", "c", "d", "e" }) );
+    }
+}
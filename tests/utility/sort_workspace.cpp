@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Morwenn
+ * SPDX-License-Identifier: MIT
+ */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <vector>
+#include <catch2/catch_test_macros.hpp>
+#include <cpp-sort/utility/sort_workspace.h>
+
+#if CPPSORT_MEMORY_RESOURCE_AVAILABLE
+
+#include <memory_resource>
+#include <cpp-sort/adapters/memory_resource_adapter.h>
+#include <cpp-sort/adapters/stable_adapter.h>
+#include <cpp-sort/sorters/merge_sorter.h>
+#include <cpp-sort/sorters/pdq_sorter.h>
+#include <cpp-sort/sorters/spread_sorter.h>
+#include <cpp-sort/sorters/tim_sorter.h>
+#include <cpp-sort/utility/scoped_memory_resource.h>
+#include <testing-tools/distributions.h>
+
+namespace
+{
+    struct counting_resource:
+        std::pmr::memory_resource
+    {
+        std::size_t allocations = 0;
+
+        auto do_allocate(std::size_t bytes, std::size_t alignment)
+            -> void* override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+
+        auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)
+            -> void override
+        {
+            std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+        }
+
+        auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override
+        {
+            return this == &other;
+        }
+    };
+
+    auto make_input(int size)
+        -> std::vector<int>
+    {
+        std::vector<int> res;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(res), size, -2'500);
+        return res;
+    }
+}
+
+TEST_CASE( "sort_workspace tests", "[utility][sort_workspace]" )
+{
+    SECTION( "memory is reused across sorts" )
+    {
+        counting_resource upstream;
+        cppsort::utility::sort_workspace workspace(&upstream);
+        cppsort::memory_resource_adapter<cppsort::tim_sorter> sorter(&workspace);
+
+        auto collection = make_input(10'000);
+        sorter(collection);
+        CHECK( std::is_sorted(collection.begin(), collection.end()) );
+        CHECK( workspace.high_water_mark() > 0 );
+        CHECK( workspace.capacity() >= workspace.high_water_mark() );
+
+        // Sorts of similar sizes don't need more memory anymore
+        auto allocations = upstream.allocations;
+        for (int idx = 0 ; idx < 10 ; ++idx) {
+            auto other = make_input(10'000);
+            sorter(other);
+            CHECK( std::is_sorted(other.begin(), other.end()) );
+        }
+        CHECK( upstream.allocations == allocations );
+    }
+
+    SECTION( "several sorters share the workspace" )
+    {
+        counting_resource upstream;
+        cppsort::utility::sort_workspace workspace(1 << 20, &upstream);
+        CHECK( workspace.capacity() >= (1 << 20) );
+        auto allocations = upstream.allocations;
+
+        cppsort::utility::scoped_memory_resource scope(&workspace);
+        auto collection = make_input(5'000);
+        cppsort::merge_sort(collection);
+        cppsort::spread_sort(collection);
+        cppsort::stable_adapter<cppsort::pdq_sorter>{}(collection, std::greater<>{});
+        CHECK( std::is_sorted(collection.begin(), collection.end(), std::greater<>{}) );
+        CHECK( upstream.allocations == allocations );
+    }
+
+    SECTION( "release" )
+    {
+        cppsort::utility::sort_workspace workspace;
+        CHECK( workspace.upstream_resource() == std::pmr::get_default_resource() );
+        workspace.reserve(4096);
+        CHECK( workspace.capacity() >= 4096 );
+        workspace.release();
+        CHECK( workspace.capacity() == 0 );
+    }
+}
+
+#endif // CPPSORT_MEMORY_RESOURCE_AVAILABLE
@@ -2,12 +2,16 @@
  * Copyright (c) 2022 Morwenn
  * SPDX-License-Identifier: MIT
  */
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <iterator>
 #include <vector>
 #include <catch2/catch_test_macros.hpp>
 #include <cpp-sort/sorters/heap_sorter.h>
 #include <cpp-sort/sorters/insertion_sorter.h>
+#include <cpp-sort/sorters/parallel_pdq_sorter.h>
+#include <cpp-sort/utility/apply_permutation.h>
 #include <cpp-sort/utility/sorted_indices.h>
 #include <testing-tools/distributions.h>
 
@@ -69,4 +73,26 @@ TEST_CASE( "basic sorted_indices test", "[utility][sorted_indices]" )
         std::vector<std::ptrdiff_t> expected = { 9, 8, 7, 6, 5, 4, 3, 2, 1, 0 };
         CHECK( indices == expected );
     }
+
+    SECTION( "32-bit indices" )
+    {
+        auto get_sorted_indices_for = cppsort::utility::sorted_indices<cppsort::heap_sorter, std::uint32_t>{};
+        const std::vector<int> vec = { 6, 4, 2, 1, 8, 7, 0, 9, 5, 3 };
+        auto indices = get_sorted_indices_for(vec);
+
+        std::vector<std::uint32_t> expected = { 6, 3, 2, 9, 1, 8, 0, 5, 4, 7 };
+        CHECK( indices == expected );
+    }
+
+    SECTION( "parallel sorter" )
+    {
+        std::vector<int> vec;
+        auto distribution = dist::shuffled{};
+        distribution(std::back_inserter(vec), 100'000);
+
+        using sorter = cppsort::utility::sorted_indices<cppsort::parallel_pdq_sorter, std::uint32_t>;
+        auto indices = sorter(cppsort::parallel_pdq_sorter(4))(vec);
+        cppsort::utility::apply_permutation(vec, indices);
+        CHECK( std::is_sorted(vec.begin(), vec.end()) );
+    }
 }